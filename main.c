@@ -44,9 +44,36 @@
 /*******************************************************************************
 * Header Files
 *******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
 #include "cy_pdl.h"
 #include "cybsp.h"
 #include "cy_retarget_io.h"
+#include "wake_predict.h"
+#include "lptimer.h"
+#include "button_gesture.h"
+#include "wake_source.h"
+#include "watchdog.h"
+#include "shell.h"
+#include "trace.h"
+#include "sampler.h"
+#include "benchmark.h"
+#include "flash_log.h"
+#include "processing.h"
+#include "jobs.h"
+#include "residency.h"
+#include "coroutine.h"
+#include "schedule.h"
+#include "calendar.h"
+#include "dst.h"
+#include "timebase.h"
+#include "debug_uart.h"
+#include "pin_sleep.h"
+#include "sram_retain.h"
+#include "energy_budget.h"
+#include "timesync.h"
+#include "uplink.h"
+#include "fmt.h"
 
 /*******************************************************************************
 * Macros
@@ -55,73 +82,187 @@
 #define MAX_ATTEMPTS             (500u)  /* Maximum number of attempts for RTC operation */
 #define INIT_DELAY_MS             (5u)    /* delay 5 milliseconds before trying again */
 
-/* Constants to define LONG and SHORT presses on User Button (x10 = ms) */
-#define SHORT_PRESS_COUNT           10u     /* 100 ms < press < 2 sec */
-#define LONG_PRESS_COUNT            200u    /* press > 2 sec */
-
 /* Glitch delays */
-#define SHORT_GLITCH_DELAY_MS       10u     /* in ms */
 #define LONG_GLITCH_DELAY_MS        100u    /* in ms */
+#define UART_DRAIN_TIMEOUT_MS       50u     /* Longest wait for the UART output */
 
-/*Macro for Alarm initial value. Alarm generated 10s*/
-#define RTC_ALARM_INITIAL_DATE_SEC      10u    /* Initial seconds value */
-#define RTC_ALARM_INITIAL_DATE_MIN      0u    /* Initial minutes value */
-#define RTC_ALARM_INITIAL_DATE_HOUR     10u    /* Initial hours value */
-#define RTC_ALARM_INITIAL_DATE_DAY      6u    /* Initial day of the month */
-#define RTC_ALARM_INITIAL_DATE_DOW      6u    /* Initial day of the week. It's Friday (6u)*/
-#define RTC_ALARM_INITIAL_DATE_MONTH    9u    /* Initial month */
-#define RTC_INITIAL_DATE_YEAR           24u /* Initial year */
 #define RTC_ALARM_INTERRUPT_PRIORITY    3u   /* Alarm Interrupt priority level */
+
+/* Seconds after the ALARM_2 deadline at which the ALARM_1 guard fires */
+#ifndef RTC_GUARD_MARGIN_S
+#define RTC_GUARD_MARGIN_S              (2u)
+#endif
 #define STRING_BUFFER_SIZE              80u  /* RTC time values buffer size*/
 
+/* Time for the jobs run on an alarm wakeup; must stay below the alarm period */
+#define JOBS_WAKE_BUDGET_US             (100000u)
+
 /*******************************************************************************
 * Global Variables
 *******************************************************************************/
-/* User button was pressed for how long */
+/* Alarm of the current schedule, filled by schedule_get_alarm() */
+cy_stc_rtc_alarm_t alarm_config;
+/* ALARM_1 guard: the alarm of the schedule RTC_GUARD_MARGIN_S later */
+cy_stc_rtc_alarm_t guard_config;
+volatile uint8_t alarm_flag = 0u;
+
+/* Set by ALARM_2 since it was last armed: the guard then has nothing to do */
+volatile bool alarm_primary_seen = false;
+/* At least one of the two alarms is armed: a sleep will end */
+bool alarm_armed = false;
+/* Wakeups by the guard, and ALARM_2 writes that failed all their attempts */
+volatile uint32_t alarm_guard_wakes = 0u;
+uint32_t alarm_write_failures = 0u;
+
+/* Seconds from arming to the RTC alarm just set */
+uint32_t alarm_next_s = 1u;
+
+/* Deadline of the RTC alarm just set, RTC seconds; 0 if none was set */
+uint32_t alarm_deadline_s = 0u;
+/* Alarm periods lost to late wakeups, and the latest wakeup (s) */
+uint32_t alarm_missed = 0u;
+uint32_t alarm_max_late_s = 0u;
+/* Alarms armed only after their deadline, by RTC retries */
+uint32_t alarm_armed_late = 0u;
+
+/* Verbosity of the UART log */
 typedef enum
 {
-    SWITCH_NO_EVENT     = 0u,
-    SWITCH_SHORT_PRESS  = 1u,
-    SWITCH_LONG_PRESS   = 2u,
-} en_switch_event_t;
-
-/* Alarm configuration structure will generate interrupt each second*/
-cy_stc_rtc_alarm_t alarm_config =
-{
-    .sec            = RTC_ALARM_INITIAL_DATE_SEC,
-    .secEn          = CY_RTC_ALARM_DISABLE,
-    .min            = RTC_ALARM_INITIAL_DATE_MIN,
-    .minEn          = CY_RTC_ALARM_DISABLE,
-    .hour           = RTC_ALARM_INITIAL_DATE_HOUR,
-    .hourEn         = CY_RTC_ALARM_DISABLE,
-    .dayOfWeek      = RTC_ALARM_INITIAL_DATE_DOW,
-    .dayOfWeekEn    = CY_RTC_ALARM_DISABLE,
-    .date           = RTC_ALARM_INITIAL_DATE_DAY,
-    .dateEn         = CY_RTC_ALARM_DISABLE,
-    .month          = RTC_ALARM_INITIAL_DATE_MONTH,
-    .monthEn        = CY_RTC_ALARM_DISABLE,
-    .almEn          = CY_RTC_ALARM_ENABLE
-};
-uint8_t alarm_flag = 0u;
+    LOG_LEVEL_ERROR = 0u,
+    LOG_LEVEL_INFO  = 1u,
+    LOG_LEVEL_DEBUG = 2u,
+} en_log_level_t;
+/* Set by the operator; log_level is this capped by the energy budget */
+en_log_level_t log_level_set = LOG_LEVEL_INFO;
+en_log_level_t log_level = LOG_LEVEL_INFO;
 
-char buffer[STRING_BUFFER_SIZE];
+/* Schedule period set by the operator; the energy budget may stretch it */
+uint32_t period_set_s = 0u;
 
-/* Debug UART context */
-cy_stc_scb_uart_context_t  DEBUG_UART_context;
-/* Debug UART HAL object */
-mtb_hal_uart_t DEBUG_UART_hal_obj;
+char buffer[STRING_BUFFER_SIZE];
 
 /*******************************************************************************
 * Function Prototypes
 *******************************************************************************/
  cy_en_rtc_status_t rtc_init(void);
- cy_en_rtc_status_t rtc_alarmconfig(void);
- en_switch_event_t get_switch_event(void);
+ cy_en_rtc_status_t rtc_alarmconfig(uint32_t alarm_s);
+ cy_en_rtc_status_t rtc_alarm_write(const cy_stc_rtc_alarm_t *alarm, cy_en_rtc_alarm_t alarm_index);
+ void rtc_get_guard(const cy_stc_rtc_alarm_t *alarm, bool primary_set, cy_stc_rtc_alarm_t *guard);
  void debug_printf(const char *str);
  void handle_error(void);
  void convert_date_to_string(cy_stc_rtc_config_t *dateTime);
  void rtc_interrupt_handler(void);
- en_switch_event_t get_switch_event(void);
+ void print_wake_predict_stats(void);
+ void print_timebase_stats(void);
+ void print_alarm_period(void);
+ void service_alarm(void);
+ bool apply_energy_level(void);
+ void cap_log_level(void);
+ void process_batch(void);
+ void log_wakeup(en_wake_source_t source, bool from_hibernate);
+ void log_snapshot(void);
+ void append_snapshot(void);
+ void job_print_wake_stats(void);
+ void job_uplink(void);
+ uint32_t rtc_seconds_of_day(void);
+ uint32_t rtc_seconds_now(void);
+ void rtc_get_local_time(cy_stc_rtc_config_t *local);
+ void action_dump_stats(void);
+ void print_watchdog_reset(void);
+ void action_enter_deepsleep(void);
+ void action_hold_start(void);
+ void action_hold_repeat(void);
+ void action_enter_hibernate(void);
+ void action_print_time(void);
+ void action_reset_rtc(void);
+ void on_alarm_wakeup(bool from_hibernate);
+ void on_button_wakeup(bool from_hibernate);
+ void on_uart_wakeup(bool from_hibernate);
+ void cmd_help(uint32_t argc, char *argv[]);
+ void cmd_period(uint32_t argc, char *argv[]);
+ void cmd_log(uint32_t argc, char *argv[]);
+ void cmd_mode(uint32_t argc, char *argv[]);
+ void cmd_stats(uint32_t argc, char *argv[]);
+ void cmd_trace(uint32_t argc, char *argv[]);
+ void cmd_time(uint32_t argc, char *argv[]);
+ void cmd_bench(uint32_t argc, char *argv[]);
+ void cmd_history(uint32_t argc, char *argv[]);
+ void cmd_jobs(uint32_t argc, char *argv[]);
+ void cmd_pins(uint32_t argc, char *argv[]);
+ void cmd_sync(uint32_t argc, char *argv[]);
+ void cmd_uplink(uint32_t argc, char *argv[]);
+ void cmd_ack(uint32_t argc, char *argv[]);
+ void settle_before_sleep(void);
+ void drain_uart(void);
+ en_coroutine_status_t co_glitch_delay(stc_coroutine_t *co);
+ en_coroutine_status_t co_uart_drain(stc_coroutine_t *co);
+
+/*******************************************************************************
+* Gesture Table
+*******************************************************************************/
+/* Actions bound to the user button (SW2) gestures */
+static const stc_gesture_binding_t gesture_table[] =
+{
+    { GESTURE_SINGLE_CLICK,     action_enter_deepsleep },
+    { GESTURE_DOUBLE_CLICK,     action_dump_stats },
+    { GESTURE_TRIPLE_CLICK,     action_print_time },
+    { GESTURE_HOLD_START,       action_hold_start },
+    { GESTURE_HOLD_REPEAT,      action_hold_repeat },
+    { GESTURE_HOLD_RELEASE,     action_enter_hibernate },
+    { GESTURE_VERY_LONG_PRESS,  action_reset_rtc },
+};
+
+/* Handlers of DeepSleep and Hibernate wakeups, per wakeup source */
+static const wake_handler_t wake_handlers[WAKE_SOURCE_COUNT] =
+{
+    [WAKE_SOURCE_NONE]      = NULL,
+    [WAKE_SOURCE_RTC_ALARM] = on_alarm_wakeup,
+    [WAKE_SOURCE_UART]      = on_uart_wakeup,
+    [WAKE_SOURCE_BUTTON]    = on_button_wakeup,
+};
+
+/* Commands of the debug UART shell */
+static const stc_shell_command_t command_table[] =
+{
+    { "help",   "help",                       cmd_help },
+    { "period", "period [schedule period s]",  cmd_period },
+    { "log",    "log <0 error|1 info|2 debug>", cmd_log },
+    { "mode",   "mode <deepsleep|hibernate>", cmd_mode },
+    { "stats",  "stats",                      cmd_stats },
+    { "trace",  "trace",                      cmd_trace },
+    { "time",   "time",                       cmd_time },
+    { "bench",  "bench",                      cmd_bench },
+    { "history", "history",                   cmd_history },
+    { "jobs",   "jobs",                       cmd_jobs },
+    { "pins",   "pins",                       cmd_pins },
+    { "sync",   "sync [host time|adj <offset ms> <delay ms>]", cmd_sync },
+    { "uplink", "uplink",                     cmd_uplink },
+    { "ack",    "ack <frame seq>",            cmd_ack },
+};
+
+/* Jobs run after an RTC alarm wakes the system from DeepSleep */
+static const stc_job_t job_table[] =
+{
+    /* name         function                period  budget (us)  priority             catch-up missed periods */
+    { "batch",      process_batch,          0u,     20000u,      JOB_PRIORITY_NORMAL, JOB_CATCH_UP_SKIP, 0u },
+    { "snapshot",   append_snapshot,        3600u,  1000u,       JOB_PRIORITY_NORMAL, JOB_CATCH_UP_ONCE, 0u },
+    { "wakestats",  job_print_wake_stats,   0u,     20000u,      JOB_PRIORITY_LOW,    JOB_CATCH_UP_SKIP, 0u },
+    { "uplink",     job_uplink,             3600u,  30000u,      JOB_PRIORITY_LOW,    JOB_CATCH_UP_ONCE, 0u },
+};
+
+/* What each energy budget level keeps: log verbosity and jobs */
+static const en_log_level_t energy_log_cap[ENERGY_LEVEL_COUNT] =
+{
+    LOG_LEVEL_DEBUG, LOG_LEVEL_INFO, LOG_LEVEL_ERROR
+};
+static const en_job_priority_t energy_lowest_job[ENERGY_LEVEL_COUNT] =
+{
+    JOB_PRIORITY_LOW, JOB_PRIORITY_NORMAL, JOB_PRIORITY_CRITICAL
+};
+
+/* Waits before a low-power mode, run together while the CPU sleeps */
+static stc_coroutine_t glitch_coroutine = COROUTINE_INIT(co_glitch_delay);
+static stc_coroutine_t drain_coroutine = COROUTINE_INIT(co_uart_drain);
 
 
 /*******************************************************************************
@@ -129,171 +270,1432 @@ mtb_hal_uart_t DEBUG_UART_hal_obj;
 *******************************************************************************/
 
 /*******************************************************************************
-* Function Name: handle_error
+* Function Name: handle_error
+********************************************************************************
+* Summary:
+* User defined error handling function
+*
+* Parameters:
+*  uint32_t status - status indicates success or failure
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void handle_error(void)
+{
+    __disable_irq();
+    CY_ASSERT(0);
+
+}
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* This is the main function for RTC periodic wakeup.
+*    1. Initialize the retarget-io and RTC blocks.
+*    2. Check the reset reason, if it is wakeup from Hibernate power mode, then
+*       set RTC initial time and date.
+*    Do Forever loop:
+*    3. Run the actions of the User button gestures recognized so far and
+*       the command line received by the UART shell.
+*    4. Sleep until the next button edge, gesture timeout, received character
+*       or RTC alarm.
+*    The single-click action sets the RTC alarm and goes to DeepSleep mode;
+*    releasing a hold (> 2s) sets the RTC alarm and goes to Hibernate mode.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  int
+*
+*******************************************************************************/
+int main(void)
+{
+    cy_rslt_t result;
+    cy_en_rtc_status_t rtcSta;
+
+    /* Initialize the device and board peripherals */
+    result = cybsp_init();
+
+    /* Board init failed. Stop program execution */
+    if (result != CY_RSLT_SUCCESS)
+    {
+        handle_error();
+    }
+
+    /* Check the IO status. If current status is frozen, unfreeze the system. */
+    if (Cy_SysPm_GetIoFreezeStatus())
+     {
+        /* Unfreeze the system */
+        Cy_SysPm_IoUnfreeze();
+     }
+
+    /* Find out what woke the device before the RTC interrupt clears it */
+    wake_source_init(wake_handlers);
+
+    /* Log the reset cause into retained storage */
+    watchdog_init();
+
+    /* Start the low-power timer and the monotonic timebase, resumed after
+       Hibernate, before the first trace event or debug_printf stamps a time.
+       They need only the RTC, which ran on through Hibernate. */
+    wake_predict_init();
+    timebase_init(WAKE_SOURCE_NONE != wake_source_get_boot_cause());
+    trace_record(TRACE_EVENT_BOOT, (uint32_t)wake_source_get_boot_cause());
+
+    /* The debug UART powers up on the first output of each wake */
+    debug_uart_init();
+    debug_uart_begin_wake(wake_source_get_boot_cause());
+
+    /* An operator woke the device: respond before the slow initialization */
+    if (WAKE_SOURCE_BUTTON == wake_source_get_boot_cause())
+    {
+        wake_source_dispatch(WAKE_SOURCE_BUTTON, true);
+    }
+    else if (WAKE_SOURCE_NONE == wake_source_get_boot_cause())
+    {
+        /* \x1b[2J\x1b[;H - ANSI ESC sequence for clear screen */
+        printf("\x1b[2J\x1b[;H");
+    }
+    else
+    {
+        /* Alarm wakeups stay silent unless they have something to report */
+    }
+    if (WAKE_SOURCE_RTC_ALARM != wake_source_get_boot_cause())
+    {
+        printf("*************************************************************\r\n");
+        printf("PDL: RTC periodic wakeup alarm example\r\n");
+        printf("*************************************************************\r\n");
+        printf("Click 'SW2' key to DeepSleep mode.\r\n\r\n");
+        printf("Hold 'SW2' key for 2s and release to Hibernate mode.\r\n\r\n");
+        printf("Double click: wakeup statistics, triple click: date and time.\r\n");
+        printf("Hold 'SW2' key for 8s to restore the initial date and time.\r\n\r\n");
+        printf("Type 'help' for the commands of the UART shell.\r\n\r\n");
+    }
+
+    /* Initialize the User Button */
+    Cy_GPIO_Pin_SecFastInit(CYBSP_USER_BTN2_PORT, CYBSP_USER_BTN2_PIN, CY_GPIO_DM_PULLUP, 1UL, HSIOM_SEL_GPIO);
+
+    /* Configure the RTC interrupt */
+    cy_stc_sysint_t rtc_intr_config = {
+                    .intrSrc = srss_interrupt_backup_IRQn,
+                    .intrPriority = RTC_ALARM_INTERRUPT_PRIORITY
+                    };
+
+    /* Enable RTC interrupt: ALARM_2 wakes on the schedule, ALARM_1 guards it */
+    Cy_RTC_SetInterruptMask(CY_RTC_INTR_ALARM1 | CY_RTC_INTR_ALARM2);
+
+    /* Configure RTC interrupt ISR */
+    Cy_SysInt_Init(&rtc_intr_config, rtc_interrupt_handler);
+    /* Clear pending interrupt */
+    NVIC_ClearPendingIRQ(rtc_intr_config.intrSrc);
+    /* Enable RTC interrupt */
+    NVIC_EnableIRQ(rtc_intr_config.intrSrc);
+
+    /* Check the reset reason */
+    if (WAKE_SOURCE_RTC_ALARM == wake_source_get_boot_cause())
+      {
+          /* The reset has occurred on an RTC alarm wakeup from Hibernate */
+          wake_source_dispatch(WAKE_SOURCE_RTC_ALARM, true);
+      }
+    else
+      {
+          /* Report a reset by the watchdog: a missed alarm or a hung job */
+          print_watchdog_reset();
+      }
+
+    /* Initialize RTC. The calendar ran on through Hibernate: keep it. */
+    if (WAKE_SOURCE_NONE == wake_source_get_boot_cause())
+    {
+        rtcSta = rtc_init();
+        if (rtcSta != CY_RTC_SUCCESS)
+            {
+                handle_error();
+            }
+        timebase_rtc_changed();
+    }
+
+    /* The RTC keeps standard time; compute the DST transitions ahead */
+    dst_init(rtc_seconds_now());
+
+    residency_init();
+
+    /* Charge the daily energy budget with the residency */
+    energy_budget_init(WAKE_SOURCE_NONE != wake_source_get_boot_cause());
+    period_set_s = schedule_get()->period_s;
+
+    /* Start the ADC sampled on the alarm wakeups */
+    sampler_init();
+
+    /* Find the head of the flash log and record the Hibernate wakeup */
+    flash_log_init();
+    if (WAKE_SOURCE_NONE != wake_source_get_boot_cause())
+    {
+        log_wakeup(wake_source_get_boot_cause(), true);
+    }
+
+    /* Upload the log from where the host acknowledged it */
+    uplink_init();
+
+    /* Register the jobs run after the alarm wakeups */
+    jobs_init(job_table, CY_ARRAY_SIZE(job_table));
+
+    /* Recognize User button gestures on timestamped edges */
+    gesture_init(gesture_table, CY_ARRAY_SIZE(gesture_table));
+
+    /* Print the current date and time by UART */
+    debug_printf("Current date and time\r\n");
+
+    /* Put the board pins in low-leakage states in DeepSleep and Hibernate */
+    pin_sleep_init();
+
+    /* Power down the SRAM above the retained data and the LDO current in DeepSleep */
+    sram_retain_init();
+
+    /* Receive command lines on the debug UART */
+    shell_init(command_table, CY_ARRAY_SIZE(command_table));
+
+    /* Enable global interrupts */
+    __enable_irq();
+
+    for (;;)
+    {
+        gesture_dispatch();
+        shell_process();
+
+        /* Service the watchdog on the alarm wakeups only */
+        if (0u != alarm_flag)
+        {
+            service_alarm();
+        }
+
+        /* Sleep between button edges. The check runs with interrupts masked
+           so that an event raised right before WFI still wakes the CPU. */
+        uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+        if ((!gesture_is_pending()) && (!shell_is_pending()) && (0u == alarm_flag))
+        {
+            residency_enter(POWER_MODE_SLEEP);
+            Cy_SysPm_CpuEnterSleep(CY_SYSPM_WAIT_FOR_INTERRUPT);
+            residency_enter(POWER_MODE_ACTIVE);
+        }
+        Cy_SysLib_ExitCriticalSection(interrupt_state);
+    }
+}
+
+/*******************************************************************************
+* Function Name: action_enter_deepsleep
+********************************************************************************
+* Summary:
+*  Single-click action: sets the RTC alarm and goes to DeepSleep mode. The CPU
+*  is woken ahead of the alarm so that it is running when the deadline arrives.
+*  Alarm wakeups run only the sampling stage and go back to DeepSleep until a
+*  batch of samples is full or a sample trips a threshold.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void action_enter_deepsleep(void)
+{
+    en_wake_source_t source;
+
+    debug_printf("Go to DeepSleep mode\r\n");
+
+    /* Set the RTC generate alarm on the next time of the schedule. Without
+       an alarm only SW2 or the UART would end the sleep: stay awake. */
+    if (CY_RTC_SUCCESS != rtc_alarmconfig(schedule_start(rtc_seconds_of_day())))
+    {
+        printf("Failed to set the RTC alarm: staying awake\r\n");
+        return;
+    }
+    print_alarm_period();
+
+    /* The alarm wakeups now service the watchdog */
+    if (!watchdog_start(schedule_get()->period_s))
+    {
+        printf("Watchdog stopped: the period is too long for it\r\n");
+    }
+    settle_before_sleep();
+
+    /* Go to deep sleep. SW2 or the UART ends it at once; the alarm ends it
+       when the sampling stage asks for the rest of the system. */
+    trace_record(TRACE_EVENT_DEEPSLEEP, schedule_get()->period_s);
+    do
+    {
+        (void)wake_source_take();
+        drain_uart();
+        while (CY_SYSPM_SUCCESS != wake_predict_enter_deepsleep())
+        {
+            /* Output printed since the drain: send it asleep, then retry */
+            drain_uart();
+        }
+        source = wake_source_take();
+        debug_uart_begin_wake((WAKE_SOURCE_NONE == source) ? WAKE_SOURCE_RTC_ALARM : source);
+        if ((WAKE_SOURCE_BUTTON == source) || (WAKE_SOURCE_UART == source))
+        {
+            break;
+        }
+        service_alarm();
+    } while (alarm_armed && (!sampler_run()));
+    log_wakeup((WAKE_SOURCE_NONE == source) ? WAKE_SOURCE_RTC_ALARM : source, false);
+
+    switch (source)
+    {
+        case WAKE_SOURCE_BUTTON:
+            wake_source_dispatch(WAKE_SOURCE_BUTTON, false);
+            break;
+        case WAKE_SOURCE_UART:
+            wake_source_dispatch(WAKE_SOURCE_UART, false);
+            break;
+        default:
+            wake_source_dispatch(WAKE_SOURCE_RTC_ALARM, false);
+            break;
+    }
+}
+
+/*******************************************************************************
+* Function Name: settle_before_sleep
+********************************************************************************
+* Summary:
+*  Lets the button glitches settle and the UART output drain before a
+*  low-power mode, then powers the UART down. The CPU sleeps while the two
+*  waits run.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void settle_before_sleep(void)
+{
+    static stc_coroutine_t *const waits[] = { &glitch_coroutine, &drain_coroutine };
+
+    coroutine_run(waits, CY_ARRAY_SIZE(waits));
+    (void)debug_uart_release();
+}
+
+/*******************************************************************************
+* Function Name: drain_uart
+********************************************************************************
+* Summary:
+*  Lets the UART output drain with the CPU asleep, then powers the UART down.
+*  Used before each DeepSleep of the alarm loop, and when the DeepSleep
+*  callback of the shell refuses the entry. If the drain timed out, the UART
+*  stays on and that callback refuses DeepSleep again.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void drain_uart(void)
+{
+    static stc_coroutine_t *const waits[] = { &drain_coroutine };
+
+    coroutine_run(waits, CY_ARRAY_SIZE(waits));
+    (void)debug_uart_release();
+}
+
+/*******************************************************************************
+* Function Name: co_glitch_delay
+********************************************************************************
+* Summary:
+*  Coroutine waiting LONG_GLITCH_DELAY_MS for the button to settle.
+*
+* Parameters:
+*  stc_coroutine_t *co - coroutine state
+*
+* Return:
+*  en_coroutine_status_t - COROUTINE_DONE after the delay
+*
+*******************************************************************************/
+en_coroutine_status_t co_glitch_delay(stc_coroutine_t *co)
+{
+    CO_BEGIN(co);
+    CO_DELAY(co, LPTIMER_US_TO_TICKS(LONG_GLITCH_DELAY_MS * 1000u));
+    CO_END(co);
+}
+
+/*******************************************************************************
+* Function Name: co_uart_drain
+********************************************************************************
+* Summary:
+*  Coroutine waiting until the debug UART has sent its output, for at most
+*  UART_DRAIN_TIMEOUT_MS.
+*
+* Parameters:
+*  stc_coroutine_t *co - coroutine state
+*
+* Return:
+*  en_coroutine_status_t - COROUTINE_DONE once drained or timed out
+*
+*******************************************************************************/
+en_coroutine_status_t co_uart_drain(stc_coroutine_t *co)
+{
+    CO_BEGIN(co);
+    CO_WAIT_UNTIL_TIMEOUT(co, (!debug_uart_is_on()) || Cy_SCB_UART_IsTxComplete(DEBUG_UART_HW),
+                          LPTIMER_US_TO_TICKS(UART_DRAIN_TIMEOUT_MS * 1000u));
+    CO_END(co);
+}
+
+/*******************************************************************************
+* Function Name: action_hold_start
+********************************************************************************
+* Summary:
+*  Hold action: tells the user that releasing the button enters Hibernate.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void action_hold_start(void)
+{
+    debug_printf("Release SW2 to go to Hibernate mode, keep holding to cancel");
+}
+
+/*******************************************************************************
+* Function Name: action_hold_repeat
+********************************************************************************
+* Summary:
+*  Hold repeat action: prints a progress mark while the button is held.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void action_hold_repeat(void)
+{
+    printf(".");
+}
+
+/*******************************************************************************
+* Function Name: action_enter_hibernate
+********************************************************************************
+* Summary:
+*  Hold release action: sets the RTC alarm and goes to Hibernate mode. The RTC
+*  alarm wakes the device, and SW2 where it is on a wakeup pin (see
+*  BUTTON_HIBERNATE_WAKEUP_SRC).
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void action_enter_hibernate(void)
+{
+    printf("\r\n");
+    debug_printf("Go to Hibernate mode\r\n");
+
+    /*Set the RTC generate alarm on the next time of the schedule */
+    if (CY_RTC_SUCCESS != rtc_alarmconfig(schedule_start(rtc_seconds_of_day())))
+    {
+        printf("Failed to set the RTC alarm: staying awake\r\n");
+        return;
+    }
+    print_alarm_period();
+    settle_before_sleep();
+    trace_record(TRACE_EVENT_HIBERNATE, schedule_get()->period_s);
+
+    /* The Hibernate wakeup is a reset; the watchdog restarts on the boot path */
+    watchdog_stop();
+
+    /* Keep the samples and the statistics across the reset */
+    log_snapshot();
+
+    /* Resume the monotonic timebase and the energy bucket after the wakeup */
+    timebase_save();
+    energy_budget_save();
+
+    /*Go to hibernate and configure the RTC alarm (and SW2) as wakeup sources*/
+    Cy_SysPm_SetHibernateWakeupSource(wake_source_get_hibernate_sources());
+    if(CY_SYSPM_SUCCESS != Cy_SysPm_SystemEnterHibernate())
+    {
+        printf("The CPU did not enter Hibernate mode\r\n\r\n");
+        CY_ASSERT(0);
+    }
+}
+
+/*******************************************************************************
+* Function Name: action_print_time
+********************************************************************************
+* Summary:
+*  Triple-click action: prints the current date and time.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void action_print_time(void)
+{
+    debug_printf("Current date and time\r\n");
+}
+
+/*******************************************************************************
+* Function Name: on_alarm_wakeup
+********************************************************************************
+* Summary:
+*  Handler of RTC alarm wakeups from DeepSleep and Hibernate modes.
+*
+* Parameters:
+*  bool from_hibernate - true if called on the boot path after Hibernate
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void on_alarm_wakeup(bool from_hibernate)
+{
+    if (from_hibernate)
+    {
+        debug_printf("Wakeup from the Hibernate mode\r\n\n");
+    }
+    else
+    {
+        debug_printf("Wakeup from DeepSleep mode\r\n");
+        jobs_run(JOBS_WAKE_BUDGET_US, energy_lowest_job[energy_budget_level()]);
+    }
+}
+
+/*******************************************************************************
+* Function Name: service_alarm
+********************************************************************************
+* Summary:
+*  Work due on every RTC alarm wakeup: services the watchdog, corrects the
+*  timebase on the RTC second, charges the energy budget and, for periods
+*  longer than a second, moves the alarm to the next time of the schedule.
+*  The wakeup is compared against the deadline of the alarm: periods that
+*  passed entirely before it are counted as missed and skipped.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void service_alarm(void)
+{
+    uint32_t now_s;
+    uint32_t late_s = 0u;
+    uint32_t alarm_s;
+
+    alarm_flag = 0u;
+    watchdog_service();
+    timebase_sync();
+
+    /* Compare the wakeup against the deadline of the alarm */
+    now_s = rtc_seconds_now();
+    if ((0u != alarm_deadline_s) && (now_s > alarm_deadline_s))
+    {
+        late_s = now_s - alarm_deadline_s;
+        if (late_s > alarm_max_late_s)
+        {
+            alarm_max_late_s = late_s;
+        }
+    }
+
+    /* Degrade or restore as the energy budget demands */
+    if (energy_budget_update() && apply_energy_level())
+    {
+        return;
+    }
+
+    if (0u == schedule_get()->slot_count)
+    {
+        /* The every-second alarm rearms itself; each late second is lost */
+        alarm_missed += late_s;
+        alarm_deadline_s = now_s + 1u;
+    }
+    else if ((0u == alarm_deadline_s) || (late_s >= SCHEDULE_SECONDS_PER_DAY))
+    {
+        alarm_missed += late_s / schedule_get()->period_s;
+        (void)rtc_alarmconfig(schedule_start(rtc_seconds_of_day()));
+    }
+    else
+    {
+        /* Alarms longer than a second match one time of day: move it on,
+           past the times already gone, which would match only a day later */
+        alarm_s = schedule_advance();
+        while (alarm_s <= late_s)
+        {
+            alarm_s += schedule_advance();
+            alarm_missed++;
+        }
+        (void)rtc_alarmconfig(alarm_s - late_s);
+    }
+}
+
+/*******************************************************************************
+* Function Name: apply_energy_level
+********************************************************************************
+* Summary:
+*  Applies the energy budget level: caps the log level and stretches the
+*  operator's schedule period by one row per level. A new period takes
+*  effect at once: the alarm and the watchdog are set up again.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - true if the alarm was set up again
+*
+*******************************************************************************/
+bool apply_energy_level(void)
+{
+    en_energy_level_t level = energy_budget_level();
+    uint32_t period_s = schedule_stretch_period(period_set_s, (uint32_t)level);
+    stc_watchdog_stats_t wdt;
+    char msg[STRING_BUFFER_SIZE];
+
+    cap_log_level();
+    fmt_snprintf(msg, sizeof(msg), "Energy budget level %u, period %lu s\r\n",
+                 (unsigned int)level, (unsigned long)period_s);
+    debug_printf(msg);
+
+    if (period_s == schedule_get()->period_s)
+    {
+        return false;
+    }
+    (void)schedule_select_period(period_s);
+    (void)rtc_alarmconfig(schedule_start(rtc_seconds_of_day()));
+    watchdog_get_stats(&wdt);
+    if (wdt.running && (!watchdog_start(period_s)))
+    {
+        printf("Watchdog stopped: the period is too long for it\r\n");
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: cap_log_level
+********************************************************************************
+* Summary:
+*  Sets the log level to the operator's, capped by the energy budget level.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void cap_log_level(void)
+{
+    en_log_level_t cap = energy_log_cap[energy_budget_level()];
+
+    log_level = (log_level_set < cap) ? log_level_set : cap;
+}
+
+/*******************************************************************************
+* Function Name: process_batch
+********************************************************************************
+* Summary:
+*  Moves the samples collected in DeepSleep to the flash log, runs the
+*  processing stage on them and logs and prints the features; at log level 2
+*  also the samples.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void process_batch(void)
+{
+    uint8_t block[SAMPLER_CODED_BLOCK_MAX];
+    int16_t samples[SAMPLER_BLOCK_SIZE];
+    uint32_t length, count, cycles;
+    stc_dsp_features_t features;
+    stc_flash_log_features_t record;
+    uint32_t i;
+
+    /* The store may hold hours of samples; move it a block at a time */
+    processing_begin();
+    while (0u != (length = sampler_read_block(block, sizeof(block))))
+    {
+        (void)flash_log_append(FLASH_LOG_SAMPLES, block, length);
+
+        count = compress_block_decode(block, length, samples, SAMPLER_BLOCK_SIZE);
+        processing_add(samples, count);
+        for (i = 0u; (i < count) && (log_level >= LOG_LEVEL_DEBUG); i++)
+        {
+            printf("%d ", samples[i]);
+        }
+    }
+    processing_end(&features, &cycles);
+    if (0u == features.count)
+    {
+        return;
+    }
+
+    record.rtc_seconds = rtc_seconds_of_day();
+    record.count = (uint16_t)((features.count > UINT16_MAX) ? UINT16_MAX : features.count);
+    record.mean = (int16_t)dsp_features_mean(&features);
+    record.rms = (uint16_t)dsp_features_rms(&features);
+    record.min = features.min;
+    record.max = features.max;
+    record.crossings = (uint16_t)((features.crossings > UINT16_MAX) ? UINT16_MAX : features.crossings);
+    (void)flash_log_append(FLASH_LOG_FEATURES, &record, sizeof(record));
+
+    if (log_level >= LOG_LEVEL_INFO)
+    {
+        printf("%sADC batch: %lu samples, mean %d, rms %u, %d..%d, %lu crossings (%lu cycles)\r\n",
+               (log_level >= LOG_LEVEL_DEBUG) ? "\r\n" : "",
+               (unsigned long)features.count, record.mean, record.rms, record.min, record.max,
+               (unsigned long)features.crossings, (unsigned long)cycles);
+    }
+}
+
+/*******************************************************************************
+* Function Name: log_wakeup
+********************************************************************************
+* Summary:
+*  Appends a wakeup record to the flash log.
+*
+* Parameters:
+*  en_wake_source_t source - what woke the device
+*  bool from_hibernate     - true on the boot path after Hibernate
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void log_wakeup(en_wake_source_t source, bool from_hibernate)
+{
+    stc_flash_log_wake_t wake;
+
+    wake.rtc_seconds = rtc_seconds_of_day();
+    wake.source = (uint8_t)source;
+    wake.from_hibernate = from_hibernate ? 1u : 0u;
+    wake.reserved = 0u;
+    (void)flash_log_append(FLASH_LOG_WAKE, &wake, sizeof(wake));
+}
+
+/*******************************************************************************
+* Function Name: log_snapshot
+********************************************************************************
+* Summary:
+*  Appends a statistics record to the flash log and commits the log. Called
+*  before Hibernate, which loses everything not in flash.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void log_snapshot(void)
+{
+    process_batch();
+    append_snapshot();
+    if (!flash_log_commit())
+    {
+        printf("Flash log commit failed\r\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: append_snapshot
+********************************************************************************
+* Summary:
+*  Appends a statistics record to the flash log. Also run hourly as a job.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void append_snapshot(void)
+{
+    stc_flash_log_snapshot_t snapshot;
+    stc_wake_predict_stats_t wake;
+    stc_watchdog_stats_t wdt;
+    stc_sampler_stats_t adc;
+
+    wake_predict_get_stats(&wake);
+    watchdog_get_stats(&wdt);
+    sampler_get_stats(&adc);
+    snapshot.rtc_seconds = rtc_seconds_of_day();
+    snapshot.samples = adc.samples;
+    snapshot.wakes = wake.wakes;
+    snapshot.missed_wakes = wdt.missed_wakes;
+    (void)flash_log_append(FLASH_LOG_STATS, &snapshot, sizeof(snapshot));
+}
+
+/*******************************************************************************
+* Function Name: rtc_seconds_of_day
+********************************************************************************
+* Summary:
+*  Returns the local time of day in seconds: the RTC standard time plus the
+*  DST offset and the time-sync correction applied to the alarms. Moves the
+*  DST table past any transition reached.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t - seconds since local midnight
+*
+*******************************************************************************/
+uint32_t rtc_seconds_of_day(void)
+{
+    uint32_t now_s = rtc_seconds_now();
+
+    (void)dst_update(now_s);
+    return (now_s + dst_offset() + (uint32_t)((int32_t)CALENDAR_SECONDS_PER_DAY + timesync_correction_s()))
+           % CALENDAR_SECONDS_PER_DAY;
+}
+
+/*******************************************************************************
+* Function Name: rtc_seconds_now
+********************************************************************************
+* Summary:
+*  Returns the RTC time as seconds since 2000-01-01, in standard time.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t - RTC seconds
+*
+*******************************************************************************/
+uint32_t rtc_seconds_now(void)
+{
+    cy_stc_rtc_config_t now;
+
+    Cy_RTC_GetDateAndTime(&now);
+    return (uint32_t)(calendar_rtc_to_epoch(&now) - CALENDAR_EPOCH_RTC_BASE);
+}
+
+/*******************************************************************************
+* Function Name: rtc_get_local_time
+********************************************************************************
+* Summary:
+*  Reads the RTC date and time and converts it to local time.
+*
+* Parameters:
+*  cy_stc_rtc_config_t *local - destination
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rtc_get_local_time(cy_stc_rtc_config_t *local)
+{
+    uint64_t epoch_s;
+
+    Cy_RTC_GetDateAndTime(local);
+    epoch_s = calendar_rtc_to_epoch(local);
+    (void)dst_update((uint32_t)(epoch_s - CALENDAR_EPOCH_RTC_BASE));
+    if ((0u != dst_offset()) || (0 != timesync_correction_s()))
+    {
+        calendar_epoch_to_rtc((uint64_t)((int64_t)(epoch_s + dst_offset()) + timesync_correction_s()), local);
+    }
+}
+
+/*******************************************************************************
+* Function Name: on_uart_wakeup
+********************************************************************************
+* Summary:
+*  Handler of DeepSleep wakeups by a character on the debug UART. The character
+*  that woke the device is lost; the shell receives the rest of the line.
+*
+* Parameters:
+*  bool from_hibernate - always false: the UART does not wake Hibernate
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void on_uart_wakeup(bool from_hibernate)
+{
+    (void)from_hibernate;
+    debug_printf("UART wakeup from DeepSleep mode, retype the command\r\n");
+}
+
+/*******************************************************************************
+* Function Name: on_button_wakeup
+********************************************************************************
+* Summary:
+*  Fast-path handler of SW2 wakeups. On the Hibernate boot path it runs right
+*  after the debug UART is up, before the RTC and the other blocks are
+*  initialized. The press that woke the device is not treated as a gesture.
+*
+* Parameters:
+*  bool from_hibernate - true if called on the boot path after Hibernate
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void on_button_wakeup(bool from_hibernate)
+{
+    if (from_hibernate)
+    {
+        printf("\r\nSW2 wakeup from the Hibernate mode\r\n\r\n");
+    }
+    else
+    {
+        gesture_ignore_current_press();
+        debug_printf("SW2 wakeup from DeepSleep mode\r\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: action_reset_rtc
+********************************************************************************
+* Summary:
+*  Very long press action: cancels the pending Hibernate and restores the
+*  initial date and time of the RTC.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void action_reset_rtc(void)
+{
+    printf("\r\n");
+    if (CY_RTC_SUCCESS != rtc_init())
+    {
+        handle_error();
+    }
+    dst_init(rtc_seconds_now());
+    timebase_rtc_changed();
+    timesync_reset();
+    debug_printf("Restored the initial date and time\r\n");
+}
+
+/*******************************************************************************
+* Function Name: cmd_help
+********************************************************************************
+* Summary:
+*  'help' command: lists the shell commands.
+*
+* Parameters:
+*  uint32_t argc - number of words
+*  char *argv[]  - words of the command line
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void cmd_help(uint32_t argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+    shell_print_help();
+}
+
+/*******************************************************************************
+* Function Name: cmd_period
+********************************************************************************
+* Summary:
+*  'period' command: lists the wake schedules of schedule_config.h or selects
+*  the one with the given period. A running schedule is moved to the new one
+*  at once.
+*
+* Parameters:
+*  uint32_t argc - number of words
+*  char *argv[]  - words of the command line
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void cmd_period(uint32_t argc, char *argv[])
+{
+    const stc_schedule_t *entry;
+    unsigned long period;
+    char *end;
+    stc_watchdog_stats_t wdt;
+    uint32_t i;
+
+    if (argc < 2u)
+    {
+        printf("  Schedule  Period s  Offset s  Mode       Awake us  Duty ppm\r\n");
+        for (i = 0u; i < (uint32_t)SCHEDULE_COUNT; i++)
+        {
+            entry = &schedule_table[i];
+            printf("%c %-8s  %8lu  %8lu  %-9s  %8lu  %8lu\r\n",
+                   (entry == schedule_get()) ? '*' : ' ', entry->name,
+                   (unsigned long)entry->period_s, (unsigned long)entry->offset_s,
+                   (SCHEDULE_MODE_HIBERNATE == entry->mode) ? "Hibernate" : "DeepSleep",
+                   (unsigned long)entry->awake_us,
+                   (unsigned long)(entry->awake_us / entry->period_s));
+        }
+        return;
+    }
+
+    period = strtoul(argv[1], &end, 10);
+    if (('\0' != *end) || (!schedule_select_period((uint32_t)period)))
+    {
+        printf("No schedule with this period; 'period' lists them\r\n");
+        return;
+    }
+
+    /* Keep the stretch of the energy budget level on the new period */
+    period_set_s = (uint32_t)period;
+    (void)schedule_select_period(schedule_stretch_period(period_set_s, (uint32_t)energy_budget_level()));
+
+    if (CY_RTC_SUCCESS != rtc_alarmconfig(schedule_start(rtc_seconds_of_day())))
+    {
+        printf("Failed to set the RTC alarm\r\n");
+        return;
+    }
+    print_alarm_period();
+
+    /* Keep the watchdog in step with the new period */
+    watchdog_get_stats(&wdt);
+    if (wdt.running && (!watchdog_start(schedule_get()->period_s)))
+    {
+        printf("Watchdog stopped: the period is too long for it\r\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: cmd_log
+********************************************************************************
+* Summary:
+*  'log' command: prints or sets the log level.
+*
+* Parameters:
+*  uint32_t argc - number of words
+*  char *argv[]  - words of the command line
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void cmd_log(uint32_t argc, char *argv[])
+{
+    unsigned long level;
+    char *end;
+
+    if (argc >= 2u)
+    {
+        level = strtoul(argv[1], &end, 10);
+        if (('\0' != *end) || (level > (unsigned long)LOG_LEVEL_DEBUG))
+        {
+            printf("Log level must be 0 to %u\r\n", (unsigned int)LOG_LEVEL_DEBUG);
+            return;
+        }
+        log_level_set = (en_log_level_t)level;
+        cap_log_level();
+    }
+    printf("Log level %u", (unsigned int)log_level);
+    if (log_level != log_level_set)
+    {
+        printf(", %u when the energy budget allows", (unsigned int)log_level_set);
+    }
+    printf("\r\n");
+}
+
+/*******************************************************************************
+* Function Name: cmd_mode
+********************************************************************************
+* Summary:
+*  'mode' command: enters DeepSleep or Hibernate mode as the gestures do.
+*
+* Parameters:
+*  uint32_t argc - number of words
+*  char *argv[]  - words of the command line
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void cmd_mode(uint32_t argc, char *argv[])
+{
+    if ((argc >= 2u) && (0 == strcmp(argv[1], "deepsleep")))
+    {
+        action_enter_deepsleep();
+    }
+    else if ((argc >= 2u) && (0 == strcmp(argv[1], "hibernate")))
+    {
+        action_enter_hibernate();
+    }
+    else
+    {
+        printf("Usage: mode <deepsleep|hibernate>\r\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: cmd_stats
+********************************************************************************
+* Summary:
+*  'stats' command: prints the wakeup and watchdog statistics.
+*
+* Parameters:
+*  uint32_t argc - number of words
+*  char *argv[]  - words of the command line
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void cmd_stats(uint32_t argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+    action_dump_stats();
+}
+
+/*******************************************************************************
+* Function Name: cmd_trace
+********************************************************************************
+* Summary:
+*  'trace' command: prints the recent events.
+*
+* Parameters:
+*  uint32_t argc - number of words
+*  char *argv[]  - words of the command line
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void cmd_trace(uint32_t argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+    trace_dump();
+}
+
+/*******************************************************************************
+* Function Name: cmd_time
+********************************************************************************
+* Summary:
+*  'time' command: prints the current date and time at any log level, and
+*  the time in epoch seconds.
+*
+* Parameters:
+*  uint32_t argc - number of words
+*  char *argv[]  - words of the command line
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void cmd_time(uint32_t argc, char *argv[])
+{
+    cy_stc_rtc_config_t dateTime;
+
+    (void)argc;
+    (void)argv;
+    rtc_get_local_time(&dateTime);
+    convert_date_to_string(&dateTime);
+    printf("%s%s (epoch %lu s)\r\n", buffer, (0u != dst_offset()) ? " DST" : "",
+           (unsigned long)(CALENDAR_EPOCH_RTC_BASE + rtc_seconds_now()));
+    calendar_epoch_to_rtc(CALENDAR_EPOCH_RTC_BASE + dst_next_transition(), &dateTime);
+    convert_date_to_string(&dateTime);
+    printf("Next DST transition %s standard time\r\n", buffer);
+}
+
+/*******************************************************************************
+* Function Name: cmd_bench
+********************************************************************************
+* Summary:
+*  'bench' command: runs the on-target benchmarks of the codec and of the
+*  processing kernels.
+*
+* Parameters:
+*  uint32_t argc - number of words
+*  char *argv[]  - words of the command line
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void cmd_bench(uint32_t argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+    benchmark_compress();
+    benchmark_dsp();
+    benchmark_coroutine();
+    benchmark_calendar();
+    benchmark_energy_budget();
+    benchmark_uplink();
+    benchmark_printf();
+}
+
+/*******************************************************************************
+* Function Name: cmd_jobs
+********************************************************************************
+* Summary:
+*  'jobs' command: prints the job table with the runtime statistics.
+*
+* Parameters:
+*  uint32_t argc - number of words
+*  char *argv[]  - words of the command line
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void cmd_jobs(uint32_t argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+    jobs_print_stats();
+}
+
+/*******************************************************************************
+* Function Name: cmd_pins
+********************************************************************************
+* Summary:
+*  'pins' command: prints the low-power profile of each board pin and the
+*  modeled leakage.
+*
+* Parameters:
+*  uint32_t argc - number of words
+*  char *argv[]  - words of the command line
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void cmd_pins(uint32_t argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+    pin_sleep_print();
+}
+
+/*******************************************************************************
+* Function Name: cmd_sync
+********************************************************************************
+* Summary:
+*  'sync' command: one side of the time synchronization with a host, for
+*  example tools/timesync.py.
+*   sync <host time>                 - replies 'sync <host time> <t2> <t3>'
+*                                      with the device time at the receipt and
+*                                      at the reply, as seconds.milliseconds
+*   sync adj <offset ms> <delay ms>  - applies the offset the host computed
+*   sync                             - prints the correction and the counts
+*  A step of the calendar sets up the armed alarm again.
+*
+* Parameters:
+*  uint32_t argc - number of words
+*  char *argv[]  - words of the command line
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void cmd_sync(uint32_t argc, char *argv[])
+{
+    uint32_t t2_s;
+    uint32_t t2_ms;
+    uint32_t t3_s;
+    uint32_t t3_ms;
+    long long offset_ms = 0;
+    unsigned long delay_ms = 0u;
+    char *end;
+    bool valid;
+    en_timesync_result_t result;
+
+    timesync_now(&t2_s, &t2_ms);
+    if (1u == argc)
+    {
+        timesync_print();
+        return;
+    }
+    if (2u == argc)
+    {
+        timesync_now(&t3_s, &t3_ms);
+        printf("sync %s %lu.%03lu %lu.%03lu\r\n", argv[1],
+               (unsigned long)t2_s, (unsigned long)t2_ms,
+               (unsigned long)t3_s, (unsigned long)t3_ms);
+        return;
+    }
+
+    valid = (4u == argc) && (0 == strcmp(argv[1], "adj"));
+    if (valid)
+    {
+        offset_ms = strtoll(argv[2], &end, 10);
+        valid = ('\0' == *end);
+        delay_ms = strtoul(argv[3], &end, 10);
+        valid = valid && ('\0' == *end);
+    }
+    if (!valid)
+    {
+        printf("Usage: sync [host time|adj <offset ms> <delay ms>]\r\n");
+        return;
+    }
+
+    result = timesync_apply((int64_t)offset_ms, (uint32_t)delay_ms);
+    if (TIMESYNC_REJECTED == result)
+    {
+        printf("sync rejected\r\n");
+        return;
+    }
+    if ((TIMESYNC_STEPPED == result) && (0u != alarm_deadline_s))
+    {
+        (void)rtc_alarmconfig(schedule_start(rtc_seconds_of_day()));
+    }
+    printf("sync %s\r\n", (TIMESYNC_STEPPED == result) ? "stepped" : "slewing");
+}
+
+/*******************************************************************************
+* Function Name: cmd_uplink
+********************************************************************************
+* Summary:
+*  'uplink' command: sends a burst of telemetry frames now.
+*
+* Parameters:
+*  uint32_t argc - number of words
+*  char *argv[]  - words of the command line
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void cmd_uplink(uint32_t argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+    (void)uplink_send();
+}
+
+/*******************************************************************************
+* Function Name: cmd_ack
 ********************************************************************************
 * Summary:
-* User defined error handling function
+*  'ack' command: a host gateway received the frames of the last burst up
+*  to the given sequence number. Silent unless the ack matches no frame.
 *
 * Parameters:
-*  uint32_t status - status indicates success or failure
+*  uint32_t argc - number of words
+*  char *argv[]  - words of the command line
 *
 * Return:
 *  void
 *
 *******************************************************************************/
-void handle_error(void)
+void cmd_ack(uint32_t argc, char *argv[])
 {
-    __disable_irq();
-    CY_ASSERT(0);
+    unsigned long seq;
+    char *end;
 
+    seq = (2u == argc) ? strtoul(argv[1], &end, 10) : 0u;
+    if ((2u != argc) || ('\0' != *end) || (seq > UINT16_MAX))
+    {
+        printf("Usage: ack <frame seq>\r\n");
+        return;
+    }
+    if (!uplink_ack((uint16_t)seq))
+    {
+        printf("ack %lu: no such frame in flight\r\n", seq);
+    }
 }
 
-
 /*******************************************************************************
-* Function Name: main
+* Function Name: cmd_history
 ********************************************************************************
 * Summary:
-* This is the main function for RTC periodic wakeup.
-*    1. Initialize the retarget-io and RTC blocks.
-*    2. Check the reset reason, if it is wakeup from Hibernate power mode, then
-*       set RTC initial time and date.
-*    Do Forever loop:
-*    3. Check if User button was pressed and for how long.
-*    4. If short pressed 1s, set the RTC alarm and then go to DeepSleep mode.
-*    5. If long pressed 2s, set the RTC alarm and then go to Hibernate mode.
+*  'history' command: prints the wakeup, statistics and feature records of
+*  the flash log, oldest first, and counts the sample blocks.
 *
 * Parameters:
-*  void
+*  uint32_t argc - number of words
+*  char *argv[]  - words of the command line
 *
 * Return:
-*  int
+*  void
 *
 *******************************************************************************/
-int main(void)
+void cmd_history(uint32_t argc, char *argv[])
 {
-    cy_rslt_t result;
-    cy_en_rtc_status_t rtcSta;
-
-    /* Initialize the device and board peripherals */
-    result = cybsp_init();
-
-    /* Board init failed. Stop program execution */
-    if (result != CY_RSLT_SUCCESS)
+    static const char *const source_names[WAKE_SOURCE_COUNT] = { "none", "alarm", "uart", "button" };
+    stc_flash_log_cursor_t cursor = { 0u, 0u };
+    stc_flash_log_stats_t stats;
+    stc_flash_log_wake_t wake;
+    stc_flash_log_snapshot_t snapshot;
+    stc_flash_log_features_t features;
+    uint8_t payload[FLASH_LOG_MAX_PAYLOAD];
+    en_flash_log_type_t type;
+    uint32_t size;
+    uint32_t blocks = 0u;
+
+    (void)argc;
+    (void)argv;
+
+    while (flash_log_next(&cursor, &type, payload, &size))
     {
-        handle_error();
-    }
-
-    /* Check the IO status. If current status is frozen, unfreeze the system. */
-    if (Cy_SysPm_GetIoFreezeStatus())
-     {
-        /* Unfreeze the system */
-        Cy_SysPm_IoUnfreeze();
-     }
-
-    /* Initialize the debug UART */
-    result = Cy_SCB_UART_Init(DEBUG_UART_HW, &DEBUG_UART_config, &DEBUG_UART_context);
-       if (result != CY_RSLT_SUCCESS)
-       {
-           CY_ASSERT(0);
-       }
-    Cy_SCB_UART_Enable(DEBUG_UART_HW);
-       /* Initialize HAL UART */
-    result = mtb_hal_uart_setup(&DEBUG_UART_hal_obj, &DEBUG_UART_hal_config, &DEBUG_UART_context, NULL);
-       if (result != CY_RSLT_SUCCESS)
-       {
-           CY_ASSERT(0);
-       }
-       /* Initialize retarget-io to use the debug UART port */
-    result = cy_retarget_io_init(&DEBUG_UART_hal_obj);
-       /* retarget-io init failed. Stop program execution */
-       if (result != CY_RSLT_SUCCESS)
-       {
-           CY_ASSERT(0);
-       }
-
-    /* \x1b[2J\x1b[;H - ANSI ESC sequence for clear screen */
-    printf("\x1b[2J\x1b[;H");
-    printf("*************************************************************\r\n");
-    printf("PDL: RTC periodic wakeup alarm example\r\n");
-    printf("*************************************************************\r\n");
-    printf("Short press 'SW2' key to DeepSleep mode.\r\n\r\n");
-    printf("Long press 'SW2' key to Hibernate mode.\r\n\r\n");
-
-    /* Initialize the User Button */
-    Cy_GPIO_Pin_SecFastInit(CYBSP_USER_BTN2_PORT, CYBSP_USER_BTN2_PIN, CY_GPIO_DM_PULLUP, 1UL, HSIOM_SEL_GPIO);
-
-    /* Configure the RTC interrupt */
-    cy_stc_sysint_t rtc_intr_config = {
-                    .intrSrc = srss_interrupt_backup_IRQn,
-                    .intrPriority = RTC_ALARM_INTERRUPT_PRIORITY
-                    };
-
-    /* Enable RTC interrupt */
-    Cy_RTC_SetInterruptMask(CY_RTC_INTR_ALARM2);
-
-    /* Configure RTC interrupt ISR */
-    Cy_SysInt_Init(&rtc_intr_config, rtc_interrupt_handler);
-    /* Clear pending interrupt */
-    NVIC_ClearPendingIRQ(rtc_intr_config.intrSrc);
-    /* Enable RTC interrupt */
-    NVIC_EnableIRQ(rtc_intr_config.intrSrc);
-
-    /* Check the reset reason */
-    if(CY_SYSLIB_RESET_HIB_WAKEUP == (Cy_SysLib_GetResetReason() & CY_SYSLIB_RESET_HIB_WAKEUP))
-      {
-          /* The reset has occurred on a wakeup from Hibernate power mode */
-          debug_printf("Wakeup from the Hibernate mode\r\n\n");
-      }
-
-    /* Initialize RTC */
-    rtcSta = rtc_init();
-    if (rtcSta != CY_RTC_SUCCESS)
+        if ((FLASH_LOG_WAKE == type) && (sizeof(wake) == size))
         {
-            handle_error();
+            memcpy(&wake, payload, sizeof(wake));
+            printf("%02lu:%02lu:%02lu wakeup by %s%s\r\n",
+                   (unsigned long)(wake.rtc_seconds / 3600u), (unsigned long)((wake.rtc_seconds / 60u) % 60u),
+                   (unsigned long)(wake.rtc_seconds % 60u),
+                   (wake.source < WAKE_SOURCE_COUNT) ? source_names[wake.source] : "?",
+                   (0u != wake.from_hibernate) ? " from Hibernate" : "");
         }
+        else if ((FLASH_LOG_STATS == type) && (sizeof(snapshot) == size))
+        {
+            memcpy(&snapshot, payload, sizeof(snapshot));
+            printf("%02lu:%02lu:%02lu %lu samples, %lu wakeups, %lu missed\r\n",
+                   (unsigned long)(snapshot.rtc_seconds / 3600u),
+                   (unsigned long)((snapshot.rtc_seconds / 60u) % 60u),
+                   (unsigned long)(snapshot.rtc_seconds % 60u), (unsigned long)snapshot.samples,
+                   (unsigned long)snapshot.wakes, (unsigned long)snapshot.missed_wakes);
+        }
+        else if ((FLASH_LOG_FEATURES == type) && (sizeof(features) == size))
+        {
+            memcpy(&features, payload, sizeof(features));
+            printf("%02lu:%02lu:%02lu batch of %u: mean %d, rms %u, %d..%d, %u crossings\r\n",
+                   (unsigned long)(features.rtc_seconds / 3600u),
+                   (unsigned long)((features.rtc_seconds / 60u) % 60u),
+                   (unsigned long)(features.rtc_seconds % 60u), features.count, features.mean,
+                   features.rms, features.min, features.max, features.crossings);
+        }
+        else if (FLASH_LOG_SAMPLES == type)
+        {
+            blocks++;
+        }
+        else
+        {
+            /* Unknown record */
+        }
+    }
 
-    /* Print the current date and time by UART */
-    debug_printf("Current date and time\r\n");
-
-    /* Enable global interrupts */
-    __enable_irq();
-
-    for (;;)
-    {
-    switch (get_switch_event())
-           {
-                case SWITCH_SHORT_PRESS:
-                    debug_printf("Go to DeepSleep mode\r\n");
-
-                    /* Set the RTC generate alarm after 1 second */
-                    rtc_alarmconfig();
-                    Cy_SysLib_Delay(LONG_GLITCH_DELAY_MS);
-
-                    /* Go to deep sleep */
-                    Cy_SysPm_CpuEnterDeepSleep(CY_SYSPM_WAIT_FOR_INTERRUPT);
-                    debug_printf("Wakeup from DeepSleep mode\r\n");
-                    break;
-
-                case SWITCH_LONG_PRESS:
-                    debug_printf("Go to Hibernate mode\r\n");
-
-                    /*Set the RTC generate alarm after 1 second */
-                    rtc_alarmconfig();
-                    Cy_SysLib_Delay(LONG_GLITCH_DELAY_MS);
-
-                   /*Go to hibernate and configure the RTC alarm as wakeup source*/
-                    Cy_SysPm_SetHibernateWakeupSource(CY_SYSPM_HIBERNATE_RTC_ALARM);
-                    if(CY_SYSPM_SUCCESS != Cy_SysPm_SystemEnterHibernate())
-                                {
-                                    printf("The CPU did not enter Hibernate mode\r\n\r\n");
-                                    CY_ASSERT(0);
-                                }
-                    break;
-
-                default:
-                    break;
-           }
-     }
+    flash_log_get_stats(&stats);
+    printf("Flash log: %lu sample blocks, %lu of %lu pages, sequence %lu, mounted in %lu reads\r\n",
+           (unsigned long)blocks, (unsigned long)stats.pages, (unsigned long)FLASH_LOG_PAGES,
+           (unsigned long)stats.sequence, (unsigned long)stats.mount_probes);
+    printf("Flash log: %lu commits, %lu bytes batched\r\n\r\n",
+           (unsigned long)stats.commits, (unsigned long)stats.buffered);
 }
 
 /*******************************************************************************
@@ -333,33 +1735,106 @@ int main(void)
 *******************************************************************************
 *
 * Summary:
-*  This function schedules the alarm by configuring the date and time on the RTC
+*  This function schedules the alarm by configuring the date and time on the RTC.
+*  The alarm is the current time of the schedule: every second, or the time of
+*  day of its current slot. Slots are local time: the alarm uses the DST
+*  offset in force when it fires, and a slot in the hour skipped at the start
+*  of DST is skipped.
+*  ALARM_2 is the alarm of the schedule. ALARM_1 guards it RTC_GUARD_MARGIN_S
+*  later, so that a failed write or a lost interrupt costs one late wakeup.
 *
 * Parameters:
-*  None
+*  uint32_t alarm_s - seconds from now to the alarm, from schedule_start() or
+*                     schedule_advance()
 *
 * Return:
 *  cy_en_rtc_status_t returns the RTC status and following are the states
-*       CY_RTC_SUCCESS      : Time and date configuration is successfully done.
+*       CY_RTC_SUCCESS      : Time and date configuration is successfully done,
+*                             on ALARM_2 or at least on the ALARM_1 guard.
 *       CY_RTC_BAD_PARAM    : Date values are not valid.
 *       CY_RTC_TIMEOUT      : Timeout occurred.
 *       CY_RTC_INVALID_STATE: RTC is busy state.
 *       CY_RTC_UNKNOWN      : Unknown failure.
 *
 ******************************************************************************/
-cy_en_rtc_status_t rtc_alarmconfig(void)
+cy_en_rtc_status_t rtc_alarmconfig(uint32_t alarm_s)
 {
-    uint32_t attempts = MAX_ATTEMPTS;
     cy_en_rtc_status_t rtc_result;
+    cy_en_rtc_status_t guard_result;
+    uint32_t now_s;
+    uint32_t offset_s = 0u;
+
+    if (0u != schedule_get()->slot_count)
+    {
+        now_s = rtc_seconds_now();
+        (void)dst_update(now_s);
+
+        /* Across a transition the wait differs from the local time difference */
+        offset_s = dst_offset_at(now_s + alarm_s);
+        while ((alarm_s + dst_offset()) <= offset_s)
+        {
+            alarm_s += schedule_advance();
+            offset_s = dst_offset_at(now_s + alarm_s);
+        }
+        alarm_s = (alarm_s + dst_offset()) - offset_s;
+
+        /* Slew a time-sync correction into the deadline, a second at a time */
+        alarm_s = (uint32_t)((int32_t)alarm_s - timesync_slew(alarm_s));
+        offset_s += (uint32_t)((int32_t)SCHEDULE_SECONDS_PER_DAY + timesync_correction_s());
+    }
+
+    schedule_get_alarm(&alarm_config, offset_s);
+    alarm_next_s = alarm_s;
+    alarm_deadline_s = rtc_seconds_now() + alarm_s;
+    wake_predict_set_deadline(alarm_s);
+    trace_record(TRACE_EVENT_ALARM_SET, alarm_s);
+
+    alarm_primary_seen = false;
+    rtc_result = rtc_alarm_write(&alarm_config, CY_RTC_ALARM_2);
+    if (CY_RTC_SUCCESS != rtc_result)
+    {
+        alarm_write_failures++;
+    }
+
+    /* The guard follows the alarm, or takes its place if the write failed */
+    rtc_get_guard(&alarm_config, (CY_RTC_SUCCESS == rtc_result), &guard_config);
+    guard_result = rtc_alarm_write(&guard_config, CY_RTC_ALARM_1);
+    alarm_armed = (CY_RTC_SUCCESS == rtc_result) ||
+                  ((CY_RTC_SUCCESS == guard_result) && (CY_RTC_ALARM_ENABLE == guard_config.almEn));
+
+    /* The retries can outlast a short wait: that alarm matches a day later */
+    if ((0u != schedule_get()->slot_count) && (rtc_seconds_now() >= alarm_deadline_s))
+    {
+        alarm_armed_late++;
+    }
 
-    /* Print the RTC alarm time by UART */
-    debug_printf("RTC alarm will be generated after 1 second\r\n");
+    return (alarm_armed ? CY_RTC_SUCCESS : rtc_result);
+}
+
+/******************************************************************************
+* Function Name: rtc_alarm_write
+*******************************************************************************
+*
+* Summary:
+*  Writes one RTC alarm. Setting the alarm can fail, for example while the
+*  RTC is busy: the write is tried up to MAX_ATTEMPTS times.
+*
+* Parameters:
+*  const cy_stc_rtc_alarm_t *alarm - alarm to write
+*  cy_en_rtc_alarm_t alarm_index    - CY_RTC_ALARM_1 or CY_RTC_ALARM_2
+*
+* Return:
+*  cy_en_rtc_status_t - result of the last attempt
+*
+******************************************************************************/
+cy_en_rtc_status_t rtc_alarm_write(const cy_stc_rtc_alarm_t *alarm, cy_en_rtc_alarm_t alarm_index)
+{
+    uint32_t attempts = MAX_ATTEMPTS;
+    cy_en_rtc_status_t rtc_result;
 
-    /* Setting the alarm can fail. For example the RTC might be busy.
-       Check the result and try again, if necessary. */
     do
     {
-        rtc_result = Cy_RTC_SetAlarmDateAndTime((cy_stc_rtc_alarm_t *)&alarm_config, CY_RTC_ALARM_2);
+        rtc_result = Cy_RTC_SetAlarmDateAndTime((cy_stc_rtc_alarm_t *)alarm, alarm_index);
         attempts--;
         Cy_SysLib_Delay(INIT_DELAY_MS);
     } while(( rtc_result != CY_RTC_SUCCESS) && (attempts != 0u));
@@ -367,58 +1842,270 @@ cy_en_rtc_status_t rtc_alarmconfig(void)
     return (rtc_result);
 }
 
+/******************************************************************************
+* Function Name: rtc_get_guard
+*******************************************************************************
+*
+* Summary:
+*  Derives the ALARM_1 guard from an alarm. A time-of-day alarm is guarded by
+*  the same match RTC_GUARD_MARGIN_S later. An every-second match cannot be
+*  missed by one late interrupt: it is guarded only when its own write failed,
+*  by the same match.
+*
+* Parameters:
+*  const cy_stc_rtc_alarm_t *alarm - alarm of the schedule
+*  bool primary_set                - true if that alarm was written to ALARM_2
+*  cy_stc_rtc_alarm_t *guard       - destination
+*
+* Return:
+*  void
+*
+******************************************************************************/
+void rtc_get_guard(const cy_stc_rtc_alarm_t *alarm, bool primary_set, cy_stc_rtc_alarm_t *guard)
+{
+    uint32_t guard_s;
+
+    *guard = *alarm;
+    if (CY_RTC_ALARM_ENABLE == alarm->secEn)
+    {
+        guard_s = (alarm->hour * 3600u) + (alarm->min * 60u) + alarm->sec + RTC_GUARD_MARGIN_S;
+        guard_s %= SCHEDULE_SECONDS_PER_DAY;
+        guard->sec = guard_s % 60u;
+        guard->min = (guard_s / 60u) % 60u;
+        guard->hour = guard_s / 3600u;
+    }
+    else if (primary_set)
+    {
+        guard->almEn = CY_RTC_ALARM_DISABLE;
+    }
+    else
+    {
+        /* The every-second match of the schedule, on ALARM_1 */
+    }
+}
+
 /*******************************************************************************
-* Function Name: get_switch_event
+* Function Name: print_alarm_period
 ********************************************************************************
 * Summary:
-*  Returns how the User button was pressed:
-*  - SWITCH_NO_EVENT: No press
-*  - SWITCH_SHORT_PRESS: Short press was detected
-*  - SWITCH_LONG_PRESS: Long press was detected
+*  Prints when the RTC alarm just set will be generated.
 *
-* Parameter:
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void print_alarm_period(void)
+{
+    char msg[STRING_BUFFER_SIZE];
+
+    fmt_snprintf(msg, sizeof(msg), "RTC alarm will be generated after %lu second%s (%s)\r\n",
+                 (unsigned long)alarm_next_s, (1u == alarm_next_s) ? "" : "s", schedule_get()->name);
+    debug_printf(msg);
+}
+
+/*******************************************************************************
+* Function Name: print_timebase_stats
+********************************************************************************
+* Summary:
+*  Prints the monotonic time and its corrections against the RTC seconds.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void print_timebase_stats(void)
+{
+    stc_timebase_stats_t stats;
+    uint64_t now_us = timebase_now_us();
+
+    timebase_get_stats(&stats);
+    printf("Timebase: %lu.%06lu s, %lu RTC corrections (%lu late), last %ld us, max %lu us, %lu resumes\r\n",
+           (unsigned long)(now_us / TIMEBASE_US_PER_S), (unsigned long)(now_us % TIMEBASE_US_PER_S),
+           (unsigned long)stats.syncs, (unsigned long)stats.skipped_syncs,
+           (long)stats.last_error_us, (unsigned long)stats.max_error_us,
+           (unsigned long)stats.resumes);
+}
+
+/*******************************************************************************
+* Function Name: print_wake_predict_stats
+********************************************************************************
+* Summary:
+*  Prints the learned DeepSleep exit latency and the achieved start jitter of
+*  the pre-armed wakeup.
+*
+* Parameters:
 *  void
 *
 * Return:
-*  Switch event that occurred, if any.
+*  void
 *
 *******************************************************************************/
-en_switch_event_t get_switch_event(void)
+void print_wake_predict_stats(void)
 {
-    en_switch_event_t event = SWITCH_NO_EVENT;
-    uint32_t press_count = 0;
+    stc_wake_predict_stats_t stats;
 
-    /* Check if User button is pressed */
-    while (Cy_GPIO_Read(CYBSP_USER_BTN2_PORT,CYBSP_USER_BTN2_PIN ) == CYBSP_BTN_PRESSED)
+    wake_predict_get_stats(&stats);
+    if (!stats.synced)
     {
-        /* Wait for 10 ms */
-        Cy_SysLib_Delay(SHORT_GLITCH_DELAY_MS);
+        printf("Pre-armed wake: waiting for RTC second boundary sync\r\n\r\n");
+        return;
+    }
+
+    printf("Pre-armed wake: latency %lu us, lead %lu us, jitter %ld us "
+           "(min %ld, max %ld), late %lu/%lu, RTC pre-alarm %lu\r\n\r\n",
+           (unsigned long)stats.latency_us, (unsigned long)stats.lead_us,
+           (long)stats.last_jitter_us, (long)stats.min_jitter_us,
+           (long)stats.max_jitter_us, (unsigned long)stats.late_wakes,
+           (unsigned long)stats.wakes, (unsigned long)stats.pre_alarms);
+}
 
-        /* Increment counter. Each count represents 10 ms */
-        press_count++;
+/*******************************************************************************
+* Function Name: job_print_wake_stats
+********************************************************************************
+* Summary:
+*  Job printing the pre-armed wakeup statistics at log level 2.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void job_print_wake_stats(void)
+{
+    if (log_level >= LOG_LEVEL_DEBUG)
+    {
+        print_wake_predict_stats();
     }
+}
+
+/*******************************************************************************
+* Function Name: job_uplink
+********************************************************************************
+* Summary:
+*  Job sending a burst of telemetry frames. A host gateway acks them with
+*  the 'ack' command; unacked data goes out again with the next burst.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void job_uplink(void)
+{
+    (void)uplink_send();
+}
+
+/*******************************************************************************
+* Function Name: action_dump_stats
+********************************************************************************
+* Summary:
+*  Double-click action: prints the wakeup, watchdog, ADC and power mode
+*  statistics.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void action_dump_stats(void)
+{
+    stc_watchdog_stats_t wdt;
+    stc_sampler_stats_t adc;
 
-    /* Check for how long the button was pressed */
-    if (press_count > LONG_PRESS_COUNT)
+    print_wake_predict_stats();
+
+    watchdog_get_stats(&wdt);
+    if (wdt.running)
+    {
+        printf("Watchdog: timeout %lu..%lu ms for a %lu s alarm period, %lu services\r\n",
+               (unsigned long)wdt.min_timeout_ms, (unsigned long)wdt.max_timeout_ms,
+               (unsigned long)wdt.period_s, (unsigned long)wdt.services);
+        printf("Watchdog: service %lu cycles, extra charge %lu nC/day\r\n",
+               (unsigned long)wdt.service_cycles,
+               (unsigned long)watchdog_get_energy_nc_per_day());
+    }
+    else
+    {
+        printf("Watchdog: stopped until the RTC alarm is armed\r\n");
+    }
+    printf("Watchdog: %lu missed alarm wakeups, %lu watchdog resets\r\n",
+           (unsigned long)wdt.missed_wakes, (unsigned long)wdt.wdt_resets);
+    printf("Alarm: %lu periods missed, latest wakeup %lu s after its deadline, %lu armed late\r\n",
+           (unsigned long)alarm_missed, (unsigned long)alarm_max_late_s,
+           (unsigned long)alarm_armed_late);
+    printf("Alarm guard: %lu wakeups by ALARM_1, %lu failed ALARM_2 writes\r\n\r\n",
+           (unsigned long)alarm_guard_wakes, (unsigned long)alarm_write_failures);
+
+    sampler_get_stats(&adc);
+    if (adc.adc_enabled)
     {
-        event = SWITCH_LONG_PRESS;
+        printf("ADC: %lu samples, %lu batches, %lu threshold wakeups, %lu lost, %lu pending\r\n",
+               (unsigned long)adc.samples, (unsigned long)adc.batches,
+               (unsigned long)adc.threshold_trips, (unsigned long)adc.overruns,
+               (unsigned long)adc.pending);
+        printf("ADC: last %d, sampling stage %lu cycles\r\n",
+               adc.last_value, (unsigned long)adc.convert_cycles);
+        printf("ADC: store %lu samples in %lu of %lu bytes\r\n\r\n",
+               (unsigned long)adc.store_samples, (unsigned long)adc.store_bytes,
+               (unsigned long)SAMPLER_STORE_SIZE);
     }
-    else if (press_count > SHORT_PRESS_COUNT)
+    else
     {
-        event = SWITCH_SHORT_PRESS;
+        printf("ADC: HPPASS not configured, every alarm wakes the system\r\n\r\n");
     }
 
-    /* Add a delay to avoid glitches */
-    Cy_SysLib_Delay(SHORT_GLITCH_DELAY_MS);
+    residency_print();
+    print_timebase_stats();
+    debug_uart_print_stats();
+    sram_retain_print();
+    energy_budget_print();
+    uplink_print();
+    printf("\r\n");
+}
+
+/*******************************************************************************
+* Function Name: print_watchdog_reset
+********************************************************************************
+* Summary:
+*  Prints a notice if this boot follows a watchdog reset.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void print_watchdog_reset(void)
+{
+    stc_watchdog_stats_t wdt;
 
-    return event;
+    watchdog_get_stats(&wdt);
+    if (0u != (wdt.last_reset_reason & CY_SYSLIB_RESET_HWWDT))
+    {
+        printf("Watchdog reset: missed alarm or hung job (%lu in total)\r\n\r\n",
+               (unsigned long)wdt.wdt_resets);
+    }
 }
 
 /*******************************************************************************
 * Function Name: debug_printf
 ********************************************************************************
 * Summary:
-* This function prints out the current date time and user string.
+* This function prints out the current date time and user string, unless the
+* log level is below LOG_LEVEL_INFO.
 *
 * Parameters:
 *  str      Point to the user print string.
@@ -430,15 +2117,23 @@ en_switch_event_t get_switch_event(void)
  void debug_printf(const char *str)
 {
     cy_stc_rtc_config_t dateTime;
+    uint64_t now_us;
+
+    if (log_level < LOG_LEVEL_INFO)
+    {
+        return;
+    }
 
-    /* Get the current time and date from the RTC peripheral */
-    Cy_RTC_GetDateAndTime(&dateTime);
+    /* Get the current local time and date from the RTC peripheral */
+    now_us = timebase_now_us();
+    rtc_get_local_time(&dateTime);
 
     /*Convert RTC int values to string*/
     convert_date_to_string(&dateTime);
 
-    /* Print the the current date and time and user string */
-    printf("%s: %s\r\n", buffer, str);
+    /* Print the the current date and time, the monotonic time and user string */
+    printf("%s [%lu.%06lu]: %s\r\n", buffer, (unsigned long)(now_us / TIMEBASE_US_PER_S),
+           (unsigned long)(now_us % TIMEBASE_US_PER_S), str);
 }
 
 /*******************************************************************************
@@ -446,7 +2141,7 @@ en_switch_event_t get_switch_event(void)
 ********************************************************************************
 * Summary:
 *  This functions get the RTC time values from 'dateTime', convert the uint32_t
-*  values to chars, then combine all chars to one string and save in 'buffer'
+*  values to one string and save it in 'buffer'
 *
 * Parameter:
 *  cy_stc_rtc_config_t *dateTime : the RTC configure struct pointer
@@ -466,20 +2161,10 @@ en_switch_event_t get_switch_event(void)
     month = dateTime->month;      /*1-12*/
     year = dateTime ->year;     /*base value is 2000. value range is 0-99*/
 
-    /* Convert uint32_t values to chars */
-    char secbuf[2], minbuf[2], hourbuf[2], daybuf[2], monthbuf[2], yearbuf[2];
-    sprintf(secbuf, "%d", (int)sec);
-    sprintf(minbuf, "%d", (int)min);
-    sprintf(hourbuf, "%d", (int)hour);
-    sprintf(daybuf, "%d", (int)day);
-    sprintf(monthbuf, "%d", (int)month);
-    sprintf(yearbuf, "%d", (int)year);
-
-    /* Merge all chars to one string */
-    snprintf(buffer, sizeof(buffer), "%s %s %s %s %s %s %s %s %s %s %s",
-            hourbuf, ":", minbuf, ":", secbuf,"", yearbuf, "-", monthbuf, "-", daybuf);
-
-
+    /* Convert the values to one string, in one pass */
+    fmt_snprintf(buffer, sizeof(buffer), "%lu : %lu : %lu  %lu - %lu - %lu",
+                 (unsigned long)hour, (unsigned long)min, (unsigned long)sec,
+                 (unsigned long)year, (unsigned long)month, (unsigned long)day);
 }
 
  /******************************************************************************
@@ -499,7 +2184,8 @@ en_switch_event_t get_switch_event(void)
  ******************************************************************************/
  void rtc_interrupt_handler(void)
  {
-     /* No DST parameters are required for the custom tick. */
+     /* The RTC keeps standard time and DST is applied from the transition
+        table of dst.c, so the hardware DST handling stays off */
      Cy_RTC_Interrupt(NULL, false);
 
  }
@@ -523,6 +2209,50 @@ en_switch_event_t get_switch_event(void)
  {
      /* the interrupt has fired, meaning time expired and the alarm went off */
      alarm_flag = 1u;
+     alarm_primary_seen = true;
+
+     watchdog_on_alarm();
+
+     /* The alarm fires on RTC second boundaries; track their phase */
+     wake_predict_on_second_tick();
+     timebase_on_second();
+     wake_source_signal(WAKE_SOURCE_RTC_ALARM);
+ }
+
+ /******************************************************************************
+ * Function Name: Cy_RTC_Alarm1Interrupt
+ *******************************************************************************
+ *
+ * Summary:
+ *  The function overrides the __WEAK Cy_RTC_Alarm1Interrupt() in cy_rtc.c to
+ *  handle the CY_RTC_ALARM_1 guard. It fires RTC_GUARD_MARGIN_S after a
+ *  deadline of ALARM_2; if ALARM_2 did not fire, it stands in for it and
+ *  service_alarm() recovers the schedule from the late wakeup.
+ *  While a long DeepSleep wait runs, ALARM_1 holds the pre-alarm of
+ *  wake_predict.c instead, which only wakes the CPU.
+ *
+ * Parameters:
+ *  None
+ *
+ * Return:
+ *  None
+ *
+ ******************************************************************************/
+ void Cy_RTC_Alarm1Interrupt(void)
+ {
+     /* The pre-alarm of a long DeepSleep wait only wakes the CPU */
+     if (wake_predict_on_pre_alarm() || alarm_primary_seen)
+     {
+         return;
+     }
+     alarm_primary_seen = true;
+     alarm_guard_wakes++;
+     alarm_flag = 1u;
+
+     watchdog_on_alarm();
+     wake_predict_on_second_tick();
+     timebase_on_second();
+     wake_source_signal(WAKE_SOURCE_RTC_ALARM);
  }
 
 /* [] END OF FILE */
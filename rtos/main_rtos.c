@@ -0,0 +1,474 @@
+/*******************************************************************************
+* File Name:   main_rtos.c
+*
+* Description: This is the source code of the FreeRTOS variant of the RTC periodic
+*              wake-up Code Example for ModusToolbox. Tasks block on the RTC
+*              alarm, and the idle time is spent in DeepSleep.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "cybsp.h"
+#include "cy_retarget_io.h"
+#include "debug_uart.h"
+#include "pin_sleep.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "tickless.h"
+#include "residency.h"
+#include "sampler.h"
+#include "processing.h"
+#include "compress.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define MAX_ATTEMPTS                    (500u)  /* Maximum number of attempts for RTC operation */
+#define INIT_DELAY_MS                   (5u)    /* delay 5 milliseconds before trying again */
+#define RTC_ALARM_INTERRUPT_PRIORITY    (3u)    /* Must not be above configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY */
+
+/* Tasks */
+#define SAMPLE_TASK_PRIORITY            (3u)
+#define PROCESS_TASK_PRIORITY           (2u)
+#define REPORT_TASK_PRIORITY            (1u)
+#define TASK_STACK_WORDS                (512u)
+#define REPORT_PERIOD_S                 (60u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Alarm matching every second */
+static const cy_stc_rtc_alarm_t alarm_config =
+{
+    .sec            = 0u,
+    .secEn          = CY_RTC_ALARM_DISABLE,
+    .min            = 0u,
+    .minEn          = CY_RTC_ALARM_DISABLE,
+    .hour           = 0u,
+    .hourEn         = CY_RTC_ALARM_DISABLE,
+    .dayOfWeek      = 1u,
+    .dayOfWeekEn    = CY_RTC_ALARM_DISABLE,
+    .date           = 1u,
+    .dateEn         = CY_RTC_ALARM_DISABLE,
+    .month          = 1u,
+    .monthEn        = CY_RTC_ALARM_DISABLE,
+    .almEn          = CY_RTC_ALARM_ENABLE
+};
+
+static SemaphoreHandle_t alarm_semaphore;
+static TaskHandle_t process_task_handle;
+
+
+static cy_stc_syspm_callback_params_t uart_pm_params =
+{
+    .base       = NULL,
+    .context    = NULL
+};
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static cy_en_rtc_status_t rtc_start(void);
+static void rtc_interrupt_handler(void);
+static void sample_task(void *arg);
+static void process_task(void *arg);
+static void report_task(void *arg);
+static cy_en_syspm_status_t uart_deepsleep_callback(cy_stc_syspm_callback_params_t *params,
+                                                    cy_en_syspm_callback_mode_t mode);
+
+static cy_stc_syspm_callback_t uart_pm_callback =
+{
+    .callback       = uart_deepsleep_callback,
+    .type           = CY_SYSPM_DEEPSLEEP,
+    .skipMode       = 0u,
+    .callbackParams = &uart_pm_params,
+    .prevItm        = NULL,
+    .nextItm        = NULL,
+    .order          = 0u
+};
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Entry of the RTOS variant. Brings up the debug UART, the RTC alarm every
+*  second and the low-power timer, creates the tasks and starts the
+*  scheduler. From then on the CPU is in DeepSleep whenever no task is ready.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  int
+*
+*******************************************************************************/
+int main(void)
+{
+    cy_rslt_t result;
+
+    /* Initialize the device and board peripherals */
+    result = cybsp_init();
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    if (Cy_SysPm_GetIoFreezeStatus())
+    {
+        Cy_SysPm_IoUnfreeze();
+    }
+
+    /* Initialize the debug UART and retarget-io */
+    debug_uart_init();
+    pin_sleep_init();
+    if (!Cy_SysPm_RegisterCallback(&uart_pm_callback))
+    {
+        CY_ASSERT(0);
+    }
+
+    /* \x1b[2J\x1b[;H - ANSI ESC sequence for clear screen */
+    printf("\x1b[2J\x1b[;H");
+    printf("*************************************************************\r\n");
+    printf("FreeRTOS: RTC periodic wakeup alarm example (tickless)\r\n");
+    printf("*************************************************************\r\n");
+    printf("Power mode residency is reported every %u s.\r\n\r\n", (unsigned int)REPORT_PERIOD_S);
+
+    /* Start the low-power timer that ends the tickless idle periods */
+    tickless_init();
+
+    /* Start the ADC sampled on the alarms */
+    sampler_init();
+
+    alarm_semaphore = xSemaphoreCreateBinary();
+    if (NULL == alarm_semaphore)
+    {
+        CY_ASSERT(0);
+    }
+    if ((pdPASS != xTaskCreate(sample_task, "sample", TASK_STACK_WORDS, NULL,
+                               SAMPLE_TASK_PRIORITY, NULL)) ||
+        (pdPASS != xTaskCreate(process_task, "process", TASK_STACK_WORDS, NULL,
+                               PROCESS_TASK_PRIORITY, &process_task_handle)) ||
+        (pdPASS != xTaskCreate(report_task, "report", TASK_STACK_WORDS, NULL,
+                               REPORT_TASK_PRIORITY, NULL)))
+    {
+        CY_ASSERT(0);
+    }
+
+    /* The alarm interrupt gives the semaphore: start it last */
+    if (CY_RTC_SUCCESS != rtc_start())
+    {
+        CY_ASSERT(0);
+    }
+
+    vTaskStartScheduler();
+
+    /* The scheduler only returns if it could not start */
+    CY_ASSERT(0);
+    return 0;
+}
+
+/*******************************************************************************
+* Function Name: rtc_start
+********************************************************************************
+* Summary:
+*  Initializes the RTC and arms ALARM_2 to fire every second.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_en_rtc_status_t - status of the last RTC operation
+*
+*******************************************************************************/
+static cy_en_rtc_status_t rtc_start(void)
+{
+    uint32_t attempts = MAX_ATTEMPTS;
+    cy_en_rtc_status_t rtc_result;
+    cy_stc_sysint_t rtc_intr_config =
+    {
+        .intrSrc = srss_interrupt_backup_IRQn,
+        .intrPriority = RTC_ALARM_INTERRUPT_PRIORITY
+    };
+
+    /* The RTC may be busy; the scheduler is not running yet, so block */
+    do
+    {
+        rtc_result = Cy_RTC_Init(&USER_RTC_config);
+        if (CY_RTC_SUCCESS == rtc_result)
+        {
+            rtc_result = Cy_RTC_SetAlarmDateAndTime(&alarm_config, CY_RTC_ALARM_2);
+        }
+        attempts--;
+        if (CY_RTC_SUCCESS != rtc_result)
+        {
+            Cy_SysLib_Delay(INIT_DELAY_MS);
+        }
+    } while ((CY_RTC_SUCCESS != rtc_result) && (0u != attempts));
+
+    if (CY_RTC_SUCCESS == rtc_result)
+    {
+        Cy_RTC_SetInterruptMask(CY_RTC_INTR_ALARM2);
+        Cy_SysInt_Init(&rtc_intr_config, rtc_interrupt_handler);
+        NVIC_ClearPendingIRQ(rtc_intr_config.intrSrc);
+        NVIC_EnableIRQ(rtc_intr_config.intrSrc);
+    }
+
+    return rtc_result;
+}
+
+/*******************************************************************************
+* Function Name: rtc_interrupt_handler
+********************************************************************************
+* Summary:
+*  RTC interrupt handler; calls Cy_RTC_Alarm2Interrupt() on the alarm.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void rtc_interrupt_handler(void)
+{
+    Cy_RTC_Interrupt(NULL, false);
+}
+
+/*******************************************************************************
+* Function Name: Cy_RTC_Alarm2Interrupt
+********************************************************************************
+* Summary:
+*  Overrides the __WEAK handler in cy_rtc.c: releases the sampling task.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void Cy_RTC_Alarm2Interrupt(void)
+{
+    BaseType_t woken = pdFALSE;
+
+    (void)xSemaphoreGiveFromISR(alarm_semaphore, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/*******************************************************************************
+* Function Name: sample_task
+********************************************************************************
+* Summary:
+*  Takes an ADC sample on every RTC alarm. Hands the batch to the processing
+*  task when it is full or a sample trips a threshold.
+*
+* Parameters:
+*  void *arg - unused
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void sample_task(void *arg)
+{
+    CY_UNUSED_PARAMETER(arg);
+
+    for (;;)
+    {
+        (void)xSemaphoreTake(alarm_semaphore, portMAX_DELAY);
+        if (sampler_run())
+        {
+            xTaskNotifyGive(process_task_handle);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: process_task
+********************************************************************************
+* Summary:
+*  Drains the sample store through the processing stage and prints the
+*  features of the batch.
+*
+* Parameters:
+*  void *arg - unused
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void process_task(void *arg)
+{
+    uint8_t block[SAMPLER_CODED_BLOCK_MAX];
+    int16_t samples[SAMPLER_BLOCK_SIZE];
+    uint32_t length, count, cycles;
+    stc_dsp_features_t features;
+
+    CY_UNUSED_PARAMETER(arg);
+
+    for (;;)
+    {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        processing_begin();
+        while (0u != (length = sampler_read_block(block, sizeof(block))))
+        {
+            count = compress_block_decode(block, length, samples, SAMPLER_BLOCK_SIZE);
+            processing_add(samples, count);
+        }
+        processing_end(&features, &cycles);
+        if (0u != features.count)
+        {
+            printf("ADC batch: %lu samples, mean %ld, rms %lu, %d..%d, %lu crossings (%lu cycles)\r\n",
+                   (unsigned long)features.count, (long)dsp_features_mean(&features),
+                   (unsigned long)dsp_features_rms(&features), features.min, features.max,
+                   (unsigned long)features.crossings, (unsigned long)cycles);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: report_task
+********************************************************************************
+* Summary:
+*  Prints the power mode residency and the tickless idle statistics every
+*  REPORT_PERIOD_S, for comparison with the bare-metal 'stats' output.
+*
+* Parameters:
+*  void *arg - unused
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void report_task(void *arg)
+{
+    TickType_t last_wake = xTaskGetTickCount();
+    stc_tickless_stats_t stats;
+
+    CY_UNUSED_PARAMETER(arg);
+
+    for (;;)
+    {
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(REPORT_PERIOD_S * 1000u));
+
+        tickless_get_stats(&stats);
+        printf("Tickless: %lu DeepSleep, %lu Sleep, %lu aborted, %lu early, %lu RTC, %lu ticks suppressed\r\n",
+               (unsigned long)stats.deepsleeps, (unsigned long)stats.sleeps,
+               (unsigned long)stats.aborts, (unsigned long)stats.early_wakes,
+               (unsigned long)stats.rtc_wakes, (unsigned long)stats.idle_ticks);
+        residency_print();
+    }
+}
+
+/*******************************************************************************
+* Function Name: uart_deepsleep_callback
+********************************************************************************
+* Summary:
+*  DeepSleep callback. Refuses DeepSleep while output is still being sent;
+*  the idle task then uses CPU Sleep for that idle period instead of waiting.
+*
+* Parameters:
+*  cy_stc_syspm_callback_params_t *params - unused
+*  cy_en_syspm_callback_mode_t mode       - transition phase
+*
+* Return:
+*  cy_en_syspm_status_t - CY_SYSPM_FAIL if the UART is busy
+*
+*******************************************************************************/
+static cy_en_syspm_status_t uart_deepsleep_callback(cy_stc_syspm_callback_params_t *params,
+                                                    cy_en_syspm_callback_mode_t mode)
+{
+    CY_UNUSED_PARAMETER(params);
+
+    if ((CY_SYSPM_CHECK_READY == mode) && (!Cy_SCB_UART_IsTxComplete(DEBUG_UART_HW)))
+    {
+        return CY_SYSPM_FAIL;
+    }
+
+    return CY_SYSPM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: vApplicationMallocFailedHook
+********************************************************************************
+* Summary:
+*  Called by FreeRTOS when the heap is exhausted.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void vApplicationMallocFailedHook(void)
+{
+    CY_ASSERT(0);
+}
+
+/*******************************************************************************
+* Function Name: vApplicationStackOverflowHook
+********************************************************************************
+* Summary:
+*  Called by FreeRTOS when a task overflows its stack.
+*
+* Parameters:
+*  TaskHandle_t task - offending task
+*  char *name        - its name
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void vApplicationStackOverflowHook(TaskHandle_t task, char *name)
+{
+    CY_UNUSED_PARAMETER(task);
+    CY_UNUSED_PARAMETER(name);
+    CY_ASSERT(0);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,343 @@
+/*******************************************************************************
+* File Name:   tickless.c
+*
+* Description: Tickless idle of the RTOS variant: the idle task sleeps in
+*              DeepSleep on the low-power timer and corrects the tick count.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "tickless.h"
+#include "task.h"
+#include "residency.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SECONDS_PER_DAY             (86400u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Sleep time not yet stepped over, in LFCLK ticks x configTICK_RATE_HZ. The
+   LFCLK is not a multiple of the tick rate; the carry keeps the kernel time
+   from drifting over many idle periods. */
+static uint32_t tick_remainder = 0u;
+
+static stc_tickless_stats_t tickless_stats;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static bool tickless_rtc_arm(uint32_t seconds);
+static void tickless_rtc_disarm(void);
+static void tickless_enter(void);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tickless_init
+********************************************************************************
+* Summary:
+*  Starts the low-power timer and the power mode accounting. Call before the
+*  scheduler starts.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void tickless_init(void)
+{
+    lptimer_init();
+    residency_init();
+    memset(&tickless_stats, 0, sizeof(tickless_stats));
+}
+
+/*******************************************************************************
+* Function Name: vApplicationSleep
+********************************************************************************
+* Summary:
+*  portSUPPRESS_TICKS_AND_SLEEP() implementation, called by the idle task with
+*  the scheduler suspended. Stops SysTick, arms a wakeup for the expected idle
+*  time and enters DeepSleep, or CPU Sleep if a DeepSleep callback refuses. On
+*  wakeup, the time slept as measured on the low-power timebase is stepped
+*  into the tick count.
+*
+*  An idle time within one match of the low-power timer is timed by MCWDT
+*  counter 0. A longer one is timed by RTC ALARM_1 on the whole seconds, which
+*  fires no later than the target; the sub-second remainder is then slept on
+*  counter 0.
+*
+*  Interrupts stay masked from the ready check to the tick correction. A
+*  pending interrupt still ends the WFI, and its handler runs once the tick
+*  count is right again.
+*
+* Parameters:
+*  TickType_t expected_idle_ticks - ticks until the next task unblocks
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void vApplicationSleep(TickType_t expected_idle_ticks)
+{
+    uint32_t start, target, elapsed;
+    uint64_t scaled;
+    TickType_t steps;
+    bool rtc_armed = false;
+
+    if (expected_idle_ticks > TICKLESS_MAX_IDLE_TICKS)
+    {
+        expected_idle_ticks = TICKLESS_MAX_IDLE_TICKS;
+    }
+
+    __disable_irq();
+    if (eAbortSleep == eTaskConfirmSleepModeStatus())
+    {
+        tickless_stats.aborts++;
+        __enable_irq();
+        return;
+    }
+
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+
+    /* LFCLK ticks until the carry plus the sleep make up the expected ticks */
+    start = lptimer_now();
+    target = (uint32_t)((((uint64_t)expected_idle_ticks * LPTIMER_CLOCK_HZ) - tick_remainder +
+                         (configTICK_RATE_HZ - 1u)) / configTICK_RATE_HZ);
+
+    /* The alarm matches on an RTC second boundary, up to a second early */
+    if (target > LPTIMER_MAX_ARM_TICKS)
+    {
+        rtc_armed = tickless_rtc_arm(target / LPTIMER_CLOCK_HZ);
+    }
+    if (!rtc_armed)
+    {
+        lptimer_arm(LPTIMER_CH_WAKE, start + ((target > LPTIMER_MAX_ARM_TICKS) ? LPTIMER_MAX_ARM_TICKS : target));
+    }
+
+    tickless_enter();
+
+    if (rtc_armed)
+    {
+        bool rtc_wake = (0u != (Cy_RTC_GetInterruptStatus() & CY_RTC_INTR_ALARM1));
+
+        tickless_rtc_disarm();
+        elapsed = lptimer_now() - start;
+        if (rtc_wake)
+        {
+            tickless_stats.rtc_wakes++;
+            if (elapsed < target)
+            {
+                /* Under two seconds left: about one match of counter 0 */
+                uint32_t remaining = target - elapsed;
+
+                lptimer_arm(LPTIMER_CH_WAKE, start + elapsed +
+                            ((remaining > LPTIMER_MAX_ARM_TICKS) ? LPTIMER_MAX_ARM_TICKS : remaining));
+                tickless_enter();
+            }
+        }
+    }
+
+    elapsed = lptimer_now() - start;
+    lptimer_disarm(LPTIMER_CH_WAKE);
+    if (elapsed < target)
+    {
+        tickless_stats.early_wakes++;
+    }
+
+    /* Whole ticks slept; a late wakeup never steps past the next unblock */
+    scaled = ((uint64_t)elapsed * configTICK_RATE_HZ) + tick_remainder;
+    steps = (TickType_t)(scaled / LPTIMER_CLOCK_HZ);
+    if (steps > expected_idle_ticks)
+    {
+        /* The overshoot is not stepped, so none of it is carried either */
+        steps = expected_idle_ticks;
+        tick_remainder = 0u;
+    }
+    else
+    {
+        tick_remainder = (uint32_t)(scaled % LPTIMER_CLOCK_HZ);
+    }
+    vTaskStepTick(steps);
+    tickless_stats.idle_ticks += steps;
+
+    SysTick->VAL = 0u;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+    __enable_irq();
+}
+
+/*******************************************************************************
+* Function Name: tickless_rtc_arm
+********************************************************************************
+* Summary:
+*  Arms RTC ALARM_1 on the time of day the given number of seconds ahead and
+*  unmasks its interrupt. The alarm matches hours, minutes and seconds, so it
+*  fires once for any delay under a day. The RTC runs in 24-hour format.
+*
+* Parameters:
+*  uint32_t seconds - delay in whole seconds, 1 to TICKLESS_MAX_IDLE_S
+*
+* Return:
+*  bool - true if the alarm is armed, false to time the sleep on counter 0
+*
+*******************************************************************************/
+static bool tickless_rtc_arm(uint32_t seconds)
+{
+    cy_stc_rtc_config_t now;
+    cy_stc_rtc_alarm_t alarm;
+    uint32_t time_of_day;
+
+    Cy_RTC_GetDateAndTime(&now);
+    if (CY_RTC_24_HOURS != now.hrFormat)
+    {
+        return false;
+    }
+
+    time_of_day = ((now.hour * 3600u) + (now.min * 60u) + now.sec + seconds) % SECONDS_PER_DAY;
+
+    memset(&alarm, 0, sizeof(alarm));
+    alarm.sec = time_of_day % 60u;
+    alarm.secEn = CY_RTC_ALARM_ENABLE;
+    alarm.min = (time_of_day / 60u) % 60u;
+    alarm.minEn = CY_RTC_ALARM_ENABLE;
+    alarm.hour = time_of_day / 3600u;
+    alarm.hourEn = CY_RTC_ALARM_ENABLE;
+    alarm.dayOfWeek = 1u;
+    alarm.dayOfWeekEn = CY_RTC_ALARM_DISABLE;
+    alarm.date = 1u;
+    alarm.dateEn = CY_RTC_ALARM_DISABLE;
+    alarm.month = 1u;
+    alarm.monthEn = CY_RTC_ALARM_DISABLE;
+    alarm.almEn = CY_RTC_ALARM_ENABLE;
+
+    /* The RTC may be busy with a write: the counter takes over */
+    if (CY_RTC_SUCCESS != Cy_RTC_SetAlarmDateAndTime(&alarm, CY_RTC_ALARM_1))
+    {
+        return false;
+    }
+
+    Cy_RTC_ClearInterrupt(CY_RTC_INTR_ALARM1);
+    Cy_RTC_SetInterruptMask(Cy_RTC_GetInterruptMask() | CY_RTC_INTR_ALARM1);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tickless_rtc_disarm
+********************************************************************************
+* Summary:
+*  Masks and clears the ALARM_1 interrupt so that it does not end the next
+*  sleep. The RTC line is level-triggered: clearing its pending state in the
+*  NVIC keeps an ALARM_2 interrupt that is still active.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void tickless_rtc_disarm(void)
+{
+    Cy_RTC_SetInterruptMask(Cy_RTC_GetInterruptMask() & ~CY_RTC_INTR_ALARM1);
+    Cy_RTC_ClearInterrupt(CY_RTC_INTR_ALARM1);
+    NVIC_ClearPendingIRQ(srss_interrupt_backup_IRQn);
+}
+
+/*******************************************************************************
+* Function Name: tickless_enter
+********************************************************************************
+* Summary:
+*  Enters DeepSleep until the next interrupt, or CPU Sleep if a DeepSleep
+*  callback refuses, and accounts the time in the power mode residency.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void tickless_enter(void)
+{
+    residency_enter(POWER_MODE_DEEPSLEEP);
+    if (CY_SYSPM_SUCCESS == Cy_SysPm_CpuEnterDeepSleep(CY_SYSPM_WAIT_FOR_INTERRUPT))
+    {
+        tickless_stats.deepsleeps++;
+    }
+    else
+    {
+        residency_enter(POWER_MODE_SLEEP);
+        Cy_SysPm_CpuEnterSleep(CY_SYSPM_WAIT_FOR_INTERRUPT);
+        tickless_stats.sleeps++;
+    }
+    residency_enter(POWER_MODE_ACTIVE);
+}
+
+/*******************************************************************************
+* Function Name: tickless_get_stats
+********************************************************************************
+* Summary:
+*  Copies the tickless idle statistics.
+*
+* Parameters:
+*  stc_tickless_stats_t *stats - destination
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void tickless_get_stats(stc_tickless_stats_t *stats)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    *stats = tickless_stats;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,83 @@
+/*******************************************************************************
+* File Name:   tickless.h
+*
+* Description: Tickless idle of the RTOS variant: the idle task sleeps in
+*              DeepSleep on the low-power timer and corrects the tick count.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef RTOS_TICKLESS_H_
+#define RTOS_TICKLESS_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "FreeRTOS.h"
+#include "lptimer.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Longest tick suppression. Beyond one match of the low-power timer, the RTC
+   alarm times the whole seconds; an hour keeps the 32-bit timebase far from
+   wrapping and the alarm within one day. */
+#define TICKLESS_MAX_IDLE_S         (3600u)
+#define TICKLESS_MAX_IDLE_TICKS     ((TickType_t)((uint64_t)TICKLESS_MAX_IDLE_S * configTICK_RATE_HZ))
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t    deepsleeps;     /* DeepSleep entries */
+    uint32_t    sleeps;         /* DeepSleep refused by a callback: CPU Sleep */
+    uint32_t    aborts;         /* A task became ready before the entry */
+    uint32_t    early_wakes;    /* Ended by an interrupt before the timer */
+    uint32_t    rtc_wakes;      /* Long idle periods timed by the RTC alarm */
+    uint32_t    idle_ticks;     /* Ticks stepped over */
+} stc_tickless_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void tickless_init(void);
+void tickless_get_stats(stc_tickless_stats_t *stats);
+void vApplicationSleep(TickType_t expected_idle_ticks);
+
+#endif /* RTOS_TICKLESS_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,818 @@
+/*******************************************************************************
+* File Name:   benchmark.c
+*
+* Description: This file implements the on-target benchmarks. Each one runs a
+*              kernel on synthetic data, times it with the DWT cycle counter and
+*              prints cycles per sample over the debug UART.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdio.h>
+#include "benchmark.h"
+#include <string.h>
+#include "compress.h"
+#include "dsp.h"
+#include "cycles.h"
+#include "coroutine.h"
+#include "calendar.h"
+#include "energy_budget.h"
+#include "energy_model.h"
+#include "schedule.h"
+#include "uplink.h"
+#include "fmt.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_SAMPLES               (1024u) /* Samples per run */
+#define BENCH_BLOCK_SIZE            (16u)   /* As SAMPLER_BLOCK_SIZE */
+#define BENCH_SEED                  (0x2545F491uL)
+#define BENCH_ADC_MID               (2048)  /* Mid-scale of a 12-bit ADC */
+#define BENCH_FIR_TAPS              (8u)    /* As the processing stage */
+#define BENCH_SWITCHES              (1000u) /* Yields per coroutine */
+#define BENCH_RTC_YEARS             (100u)  /* RTC years 2000 to 2099 */
+#define BENCH_BUDGET_DAYS           (2u)    /* Simulated time of the energy budget */
+#define BENCH_POKE_HOURS            (4u)    /* Operator sessions in the first hours */
+#define BENCH_POKE_EVERY_S          (600u)
+#define BENCH_POKE_US               (2000000u)
+#define BENCH_COBS_BYTES            (600u)  /* Longest frame body checked */
+#define BENCH_COBS_PATTERNS         (3u)    /* Sample bytes, some zeros, all zeros */
+#define BENCH_FMT_LINES             (4u)    /* Formatted lines checked and timed */
+#define BENCH_FMT_ROUNDS            (100u)  /* Passes over the lines timed */
+#define BENCH_FMT_SIZE              (96u)   /* Longest formatted line, with room */
+
+/* 1: also time newlib's snprintf, which links its formatter into the image */
+#ifndef BENCH_NEWLIB_PRINTF
+#define BENCH_NEWLIB_PRINTF         (0u)
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* fmt_snprintf or newlib's snprintf */
+typedef int (*bench_snprintf_t)(char *buffer, size_t size, const char *format, ...);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static int16_t bench_samples[BENCH_SAMPLES];
+static int16_t bench_decoded[BENCH_BLOCK_SIZE];
+static uint8_t bench_coded[(BENCH_SAMPLES / BENCH_BLOCK_SIZE) * COMPRESS_MAX_BLOCK_SIZE(BENCH_BLOCK_SIZE)];
+static int16_t bench_filtered[2][BENCH_SAMPLES];
+
+static const int16_t bench_coeffs[BENCH_FIR_TAPS] =
+{
+    910, 2731, 5461, 7282, 7282, 5461, 2731, 910
+};
+
+static uint32_t bench_yields[2];
+static volatile uint32_t bench_steps;
+static volatile uint64_t bench_epoch_sink;
+
+/* Output of bench_fmt_line, per line */
+static const char *const bench_fmt_expected[BENCH_FMT_LINES] =
+{
+    "12 : 34 : 56  25 - 10 - 17 [1234.005678]: Wakeup from DeepSleep mode\r\n",
+    "  batch      1234567      42     7    98765\r\n",
+    "Energy budget level 2, period 3600 s\r\n",
+    "[  -42] [-7  ] [005] [beef] [x] [ab] %\r\n"
+};
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void bench_fill(uint32_t step);
+static void bench_compress_run(const char *name, bool bitpack);
+static void bench_dsp_run(uint32_t block);
+static en_coroutine_status_t bench_yielder(stc_coroutine_t *co);
+static void bench_step(void);
+static uint32_t bench_cobs_decode(const uint8_t *data, uint32_t size, uint8_t *out);
+static int bench_fmt_line(bench_snprintf_t format, char *out, uint32_t line);
+static void bench_fmt_run(const char *name, bench_snprintf_t format);
+
+static stc_coroutine_t bench_coroutines[2] =
+{
+    COROUTINE_INIT(bench_yielder),
+    COROUTINE_INIT(bench_yielder)
+};
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: benchmark_compress
+********************************************************************************
+* Summary:
+*  Times block encoding and decoding of slowly varying and of noisy data, in
+*  delta/varint and in bit-packing mode, and prints the cycles per sample and
+*  the coded bits per sample.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void benchmark_compress(void)
+{
+    static const uint32_t steps[] = { 2u, 16u, 256u };
+    char name[24];
+    uint32_t i;
+
+    cycles_init();
+    printf("Codec benchmark: %u samples in blocks of %u\r\n",
+           (unsigned int)BENCH_SAMPLES, (unsigned int)BENCH_BLOCK_SIZE);
+    printf("  %-16s %-8s %10s %10s %10s\r\n", "data", "mode", "enc c/smp", "dec c/smp", "bits/smp");
+
+    for (i = 0u; i < CY_ARRAY_SIZE(steps); i++)
+    {
+        bench_fill(steps[i]);
+        fmt_snprintf(name, sizeof(name), "walk +-%lu", (unsigned long)(steps[i] / 2u));
+        bench_compress_run(name, false);
+        bench_compress_run(name, true);
+    }
+    printf("\r\n");
+}
+
+/*******************************************************************************
+* Function Name: benchmark_dsp
+********************************************************************************
+* Summary:
+*  Times the processing kernels, SIMD and scalar, over block sizes from 16 to
+*  1024 samples and prints cycles per block and per sample. Use it to size the
+*  work done on one wakeup.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void benchmark_dsp(void)
+{
+    static const uint32_t blocks[] = { 16u, 64u, 256u, BENCH_SAMPLES - BENCH_FIR_TAPS };
+    uint32_t i;
+
+    cycles_init();
+    bench_fill(16u);
+    printf("DSP benchmark: %u-tap FIR, features (SIMD / scalar)\r\n", (unsigned int)BENCH_FIR_TAPS);
+    printf("  %6s %18s %18s %14s\r\n", "block", "fir c/block", "features c/block", "total c/smp");
+    for (i = 0u; i < CY_ARRAY_SIZE(blocks); i++)
+    {
+        bench_dsp_run(blocks[i]);
+    }
+    printf("\r\n");
+}
+
+/*******************************************************************************
+* Function Name: benchmark_coroutine
+********************************************************************************
+* Summary:
+*  Times the coroutine context switch: a resume and yield called directly, a
+*  switch through the scheduler between two coroutines, and, as the baseline,
+*  a plain call through a function pointer.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void benchmark_coroutine(void)
+{
+    static stc_coroutine_t *const pair[] = { &bench_coroutines[0], &bench_coroutines[1] };
+    void (*volatile step)(void) = bench_step;
+    uint32_t call, direct, scheduled, start, i;
+
+    cycles_init();
+
+    bench_steps = 0u;
+    start = cycles_now();
+    for (i = 0u; i < BENCH_SWITCHES; i++)
+    {
+        step();
+    }
+    call = cycles_now() - start;
+
+    bench_yields[0] = 0u;
+    bench_coroutines[0].resume = 0u;
+    start = cycles_now();
+    while (COROUTINE_DONE != bench_yielder(&bench_coroutines[0]))
+    {
+    }
+    direct = cycles_now() - start;
+
+    bench_yields[0] = 0u;
+    bench_yields[1] = 0u;
+    start = cycles_now();
+    coroutine_run(pair, CY_ARRAY_SIZE(pair));
+    scheduled = cycles_now() - start;
+
+    printf("Coroutine benchmark: %u yields, cycles per switch\r\n", (unsigned int)BENCH_SWITCHES);
+    printf("  function call %lu, direct resume %lu, scheduler %lu\r\n\r\n",
+           (unsigned long)(call / BENCH_SWITCHES), (unsigned long)(direct / BENCH_SWITCHES),
+           (unsigned long)(scheduled / (2u * BENCH_SWITCHES)));
+}
+
+/*******************************************************************************
+* Function Name: benchmark_calendar
+********************************************************************************
+* Summary:
+*  Checks the calendar conversions on every day of the RTC range, 2000 to
+*  2099, against the PDL: the date advances by one day at a time as
+*  Cy_RTC_DaysInMonth() says, the day of the week matches
+*  Cy_RTC_ConvertDayOfWeek(), and RTC time to epoch seconds and back round
+*  trips. Prints the cycles per conversion.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void benchmark_calendar(void)
+{
+    cy_stc_rtc_config_t rtc;
+    int32_t first = calendar_days_from_civil(CALENDAR_RTC_BASE_YEAR, CY_RTC_JANUARY, 1u);
+    int32_t last = calendar_days_from_civil(CALENDAR_RTC_BASE_YEAR + (int32_t)BENCH_RTC_YEARS - 1,
+                                            CY_RTC_DECEMBER, 31u);
+    int32_t days, year;
+    uint32_t month, day, expect_year, expect_month, expect_day;
+    uint32_t errors = 0u;
+    uint32_t count = (uint32_t)(last - first) + 1u;
+    uint32_t to_days, from_days, to_epoch, to_rtc, start;
+    uint64_t epoch_s;
+
+    cycles_init();
+
+    expect_year = (uint32_t)CALENDAR_RTC_BASE_YEAR;
+    expect_month = CY_RTC_JANUARY;
+    expect_day = 1u;
+    for (days = first; days <= last; days++)
+    {
+        calendar_civil_from_days(days, &year, &month, &day);
+        if (((uint32_t)year != expect_year) || (month != expect_month) || (day != expect_day) ||
+            (calendar_days_from_civil(year, month, day) != days) ||
+            (calendar_day_of_week(days) != Cy_RTC_ConvertDayOfWeek(day, month, (uint32_t)year)) ||
+            (calendar_is_leap_year(year) != Cy_RTC_IsLeapYear((uint32_t)year)))
+        {
+            errors++;
+        }
+
+        /* A different time of day on each day */
+        epoch_s = ((uint64_t)days * CALENDAR_SECONDS_PER_DAY) + ((uint32_t)days % CALENDAR_SECONDS_PER_DAY);
+        calendar_epoch_to_rtc(epoch_s, &rtc);
+        if (calendar_rtc_to_epoch(&rtc) != epoch_s)
+        {
+            errors++;
+        }
+
+        /* Next expected date */
+        expect_day++;
+        if (expect_day > Cy_RTC_DaysInMonth(expect_month, expect_year))
+        {
+            expect_day = 1u;
+            expect_month++;
+            if (expect_month > CY_RTC_DECEMBER)
+            {
+                expect_month = CY_RTC_JANUARY;
+                expect_year++;
+            }
+        }
+    }
+
+    start = cycles_now();
+    for (days = first; days <= last; days++)
+    {
+        calendar_civil_from_days(days, &year, &month, &day);
+    }
+    from_days = cycles_now() - start;
+
+    start = cycles_now();
+    for (days = first; days <= last; days++)
+    {
+        bench_epoch_sink = (uint64_t)calendar_days_from_civil(year, month, ((uint32_t)days % 28u) + 1u);
+    }
+    to_days = cycles_now() - start;
+
+    start = cycles_now();
+    for (days = first; days <= last; days++)
+    {
+        calendar_epoch_to_rtc((uint64_t)days * CALENDAR_SECONDS_PER_DAY, &rtc);
+    }
+    to_rtc = cycles_now() - start;
+
+    start = cycles_now();
+    for (days = first; days <= last; days++)
+    {
+        bench_epoch_sink = calendar_rtc_to_epoch(&rtc);
+    }
+    to_epoch = cycles_now() - start;
+
+    printf("Calendar benchmark: %lu days, %lu errors, cycles per conversion\r\n",
+           (unsigned long)count, (unsigned long)errors);
+    printf("  days from date %lu, date from days %lu, RTC to epoch %lu, epoch to RTC %lu\r\n\r\n",
+           (unsigned long)(to_days / count), (unsigned long)(from_days / count),
+           (unsigned long)(to_epoch / count), (unsigned long)(to_rtc / count));
+}
+
+/*******************************************************************************
+* Function Name: benchmark_energy_budget
+********************************************************************************
+* Summary:
+*  Simulates BENCH_BUDGET_DAYS of the energy budget without hardware: every
+*  alarm wakeup of the default schedule, stretched by the level as the main
+*  loop does, costs its worst-case awake time in Active mode and the rest of
+*  the period in DeepSleep; in the first hours an operator also keeps the
+*  device awake. Checks that the charge drawn stays within the budget of the
+*  time plus the initial bucket, and prints the time at each level.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void benchmark_energy_budget(void)
+{
+    stc_energy_bucket_t bucket;
+    uint64_t level_s[ENERGY_LEVEL_COUNT] = { 0u, 0u, 0u };
+    uint64_t spent_nc, total_nc = 0u;
+    uint64_t awake_us;
+    uint32_t base_period_s = schedule_table[SCHEDULE_DEFAULT].period_s;
+    uint32_t period_s = base_period_s;
+    uint32_t now_s = 0u, next_poke_s = 0u;
+    uint32_t changes = 0u;
+    uint32_t i;
+    bool ok;
+
+    energy_bucket_init(&bucket, ENERGY_BUDGET_UAH_PER_DAY, ENERGY_BUDGET_BURST_S);
+    while (now_s < (BENCH_BUDGET_DAYS * ENERGY_SECONDS_PER_DAY))
+    {
+        for (i = 0u; schedule_table[i].period_s != period_s; i++)
+        {
+        }
+        awake_us = schedule_table[i].awake_us;
+        if ((now_s >= next_poke_s) && (now_s < (BENCH_POKE_HOURS * 3600u)))
+        {
+            awake_us += BENCH_POKE_US;
+            next_poke_s += BENCH_POKE_EVERY_S;
+        }
+        if (awake_us > ((uint64_t)period_s * 1000000u))
+        {
+            awake_us = (uint64_t)period_s * 1000000u;
+        }
+
+        spent_nc = ((awake_us * ENERGY_ACTIVE_UA) +
+                    ((((uint64_t)period_s * 1000000u) - awake_us) * ENERGY_DEEPSLEEP_UA)) / 1000u;
+        total_nc += spent_nc;
+        level_s[bucket.level] += period_s;
+        now_s += period_s;
+
+        if (energy_bucket_step(&bucket, (uint64_t)period_s * 1000000u, spent_nc))
+        {
+            changes++;
+            period_s = schedule_stretch_period(base_period_s, (uint32_t)bucket.level);
+        }
+    }
+
+    ok = (total_nc <= (((uint64_t)bucket.refill_na * now_s) + bucket.capacity_nc));
+    printf("Energy budget simulation: %lu days, %lu nA budget, %lu nA drawn, %lu level changes: %s\r\n",
+           (unsigned long)BENCH_BUDGET_DAYS, (unsigned long)bucket.refill_na,
+           (unsigned long)(total_nc / now_s), (unsigned long)changes, ok ? "ok" : "FAIL");
+    printf("  time at level normal %lu%%, save %lu%%, critical %lu%%\r\n\r\n",
+           (unsigned long)((level_s[ENERGY_LEVEL_NORMAL] * 100u) / now_s),
+           (unsigned long)((level_s[ENERGY_LEVEL_SAVE] * 100u) / now_s),
+           (unsigned long)((level_s[ENERGY_LEVEL_CRITICAL] * 100u) / now_s));
+}
+
+/*******************************************************************************
+* Function Name: benchmark_uplink
+********************************************************************************
+* Summary:
+*  Checks the COBS encoder of the uplink frames: every length up to
+*  BENCH_COBS_BYTES of three data sets, with few zeros, a zero every fifth
+*  byte and only zeros, must decode to the input, carry no zero byte, and
+*  grow by at most one byte per 254. Prints the encoding cycles per byte.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void benchmark_uplink(void)
+{
+    uint8_t *data = (uint8_t *)bench_samples;
+    uint8_t *decoded = (uint8_t *)bench_filtered;
+    uint32_t pattern, size, coded, i, start, cycles;
+    uint32_t errors = 0u;
+
+    cycles_init();
+    bench_fill(64u);
+    cycles = 0u;
+    for (pattern = 0u; pattern < BENCH_COBS_PATTERNS; pattern++)
+    {
+        for (i = 0u; (1u == pattern) && (i < BENCH_COBS_BYTES); i++)
+        {
+            data[i] = ((i % 5u) == 0u) ? 0u : (uint8_t)(i | 1u);
+        }
+        if (2u == pattern)
+        {
+            memset(data, 0, BENCH_COBS_BYTES);
+        }
+
+        for (size = 0u; size <= BENCH_COBS_BYTES; size++)
+        {
+            start = cycles_now();
+            coded = uplink_cobs_encode(data, size, bench_coded);
+            if (BENCH_COBS_BYTES == size)
+            {
+                cycles += cycles_now() - start;
+            }
+            if ((coded > (size + (size / 254u) + 1u)) ||
+                (NULL != memchr(bench_coded, 0, coded)) ||
+                (bench_cobs_decode(bench_coded, coded, decoded) != size) ||
+                (0 != memcmp(data, decoded, size)))
+            {
+                errors++;
+            }
+        }
+    }
+
+    printf("Uplink COBS check: %lu frames, %lu errors: %s, %lu cycles per byte\r\n\r\n",
+           (unsigned long)(BENCH_COBS_PATTERNS * (BENCH_COBS_BYTES + 1u)), (unsigned long)errors,
+           (0u == errors) ? "ok" : "FAIL",
+           (unsigned long)(cycles / (BENCH_COBS_PATTERNS * BENCH_COBS_BYTES)));
+}
+
+/*******************************************************************************
+* Function Name: benchmark_printf
+********************************************************************************
+* Summary:
+*  Checks the integer-only formatter (source/fmt.c) on lines like the
+*  firmware prints: debug_printf, a statistics row, a log message, and the
+*  other conversions and flags. Prints the cycles per line and per
+*  character, and with BENCH_NEWLIB_PRINTF those of newlib's snprintf.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void benchmark_printf(void)
+{
+    cycles_init();
+    printf("Formatter benchmark: %u lines, %u rounds\r\n",
+           (unsigned int)BENCH_FMT_LINES, (unsigned int)BENCH_FMT_ROUNDS);
+    printf("  %-8s %8s %8s %8s\r\n", "printf", "errors", "c/line", "c/char");
+    bench_fmt_run("fmt", fmt_snprintf);
+#if (0u != BENCH_NEWLIB_PRINTF)
+    bench_fmt_run("newlib", snprintf);
+#else
+    printf("  newlib: build with BENCH_NEWLIB_PRINTF=1 to compare\r\n");
+#endif
+    printf("\r\n");
+}
+
+/*******************************************************************************
+* Function Name: bench_fmt_line
+********************************************************************************
+* Summary:
+*  Formats one of the benchmark lines into 'out'.
+*
+* Parameters:
+*  bench_snprintf_t format - formatter
+*  char *out               - BENCH_FMT_SIZE characters
+*  uint32_t line           - line, below BENCH_FMT_LINES
+*
+* Return:
+*  int - characters of the line
+*
+*******************************************************************************/
+static int bench_fmt_line(bench_snprintf_t format, char *out, uint32_t line)
+{
+    switch (line)
+    {
+        case 0u:
+            return format(out, BENCH_FMT_SIZE, "%s [%lu.%06lu]: %s\r\n", "12 : 34 : 56  25 - 10 - 17",
+                          1234ul, 5678ul, "Wakeup from DeepSleep mode");
+        case 1u:
+            return format(out, BENCH_FMT_SIZE, "  %-10s %7lu %7lu %5lu %8lu\r\n", "batch",
+                          1234567ul, 42ul, 7ul, 98765ul);
+        case 2u:
+            return format(out, BENCH_FMT_SIZE, "Energy budget level %u, period %lu s\r\n", 2u, 3600ul);
+        default:
+            return format(out, BENCH_FMT_SIZE, "[%5d] [%-4ld] [%03u] [%x] [%c] [%.2s] %%\r\n",
+                          -42, -7l, 5u, 0xBEEFu, 'x', "abc");
+    }
+}
+
+/*******************************************************************************
+* Function Name: bench_fmt_run
+********************************************************************************
+* Summary:
+*  Checks each benchmark line against its expected text, then times
+*  BENCH_FMT_ROUNDS passes over the lines and prints the result.
+*
+* Parameters:
+*  const char *name        - formatter name
+*  bench_snprintf_t format - formatter
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_fmt_run(const char *name, bench_snprintf_t format)
+{
+    char out[BENCH_FMT_SIZE];
+    uint32_t line, round, start, cycles;
+    uint32_t errors = 0u;
+    uint32_t chars = 0u;
+
+    for (line = 0u; line < BENCH_FMT_LINES; line++)
+    {
+        if (((uint32_t)bench_fmt_line(format, out, line) != strlen(bench_fmt_expected[line])) ||
+            (0 != strcmp(out, bench_fmt_expected[line])))
+        {
+            errors++;
+        }
+        chars += (uint32_t)strlen(bench_fmt_expected[line]);
+    }
+
+    start = cycles_now();
+    for (round = 0u; round < BENCH_FMT_ROUNDS; round++)
+    {
+        for (line = 0u; line < BENCH_FMT_LINES; line++)
+        {
+            (void)bench_fmt_line(format, out, line);
+        }
+    }
+    cycles = cycles_now() - start;
+
+    printf("  %-8s %8lu %8lu %8lu\r\n", name, (unsigned long)errors,
+           (unsigned long)(cycles / (BENCH_FMT_ROUNDS * BENCH_FMT_LINES)),
+           (unsigned long)(cycles / (BENCH_FMT_ROUNDS * chars)));
+}
+
+/*******************************************************************************
+* Function Name: bench_cobs_decode
+********************************************************************************
+* Summary:
+*  Reference COBS decoder, as the host gateway decodes.
+*
+* Parameters:
+*  const uint8_t *data - encoded bytes, without delimiters
+*  uint32_t size       - number of bytes
+*  uint8_t *out        - destination
+*
+* Return:
+*  uint32_t - decoded bytes, UINT32_MAX if the encoding is invalid
+*
+*******************************************************************************/
+static uint32_t bench_cobs_decode(const uint8_t *data, uint32_t size, uint8_t *out)
+{
+    uint32_t in = 0u;
+    uint32_t length = 0u;
+    uint32_t code;
+
+    while (in < size)
+    {
+        code = data[in++];
+        if ((0u == code) || ((in + code - 1u) > size))
+        {
+            return UINT32_MAX;
+        }
+        memcpy(&out[length], &data[in], code - 1u);
+        length += code - 1u;
+        in += code - 1u;
+        if ((code < 0xFFu) && (in < size))
+        {
+            out[length++] = 0u;
+        }
+    }
+
+    return length;
+}
+
+/*******************************************************************************
+* Function Name: bench_yielder
+********************************************************************************
+* Summary:
+*  Coroutine that counts and yields BENCH_SWITCHES times.
+*
+* Parameters:
+*  stc_coroutine_t *co - one of bench_coroutines
+*
+* Return:
+*  en_coroutine_status_t - COROUTINE_YIELDED until done
+*
+*******************************************************************************/
+static en_coroutine_status_t bench_yielder(stc_coroutine_t *co)
+{
+    uint32_t *yields = &bench_yields[co - bench_coroutines];
+
+    CO_BEGIN(co);
+    while (*yields < BENCH_SWITCHES)
+    {
+        (*yields)++;
+        CO_YIELD(co);
+    }
+    CO_END(co);
+}
+
+/*******************************************************************************
+* Function Name: bench_step
+********************************************************************************
+* Summary:
+*  Baseline for the switch cost: the same work as one coroutine step.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_step(void)
+{
+    bench_steps++;
+}
+
+/*******************************************************************************
+* Function Name: bench_dsp_run
+********************************************************************************
+* Summary:
+*  Runs both versions of the kernels on one block, checks that they agree and
+*  prints one table row.
+*
+* Parameters:
+*  uint32_t block - samples per block; the FIR history precedes it
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_dsp_run(uint32_t block)
+{
+    const int16_t *x = &bench_samples[BENCH_FIR_TAPS - 1u];
+    stc_dsp_features_t simd, scalar;
+    uint32_t fir[2], features[2], start;
+    bool ok;
+
+    start = cycles_now();
+    dsp_fir(x, bench_filtered[0], block, bench_coeffs, BENCH_FIR_TAPS);
+    fir[0] = cycles_now() - start;
+    start = cycles_now();
+    dsp_fir_scalar(x, bench_filtered[1], block, bench_coeffs, BENCH_FIR_TAPS);
+    fir[1] = cycles_now() - start;
+
+    dsp_features_reset(&simd);
+    dsp_features_reset(&scalar);
+    start = cycles_now();
+    dsp_features_update(&simd, bench_filtered[0], block, BENCH_ADC_MID);
+    features[0] = cycles_now() - start;
+    start = cycles_now();
+    dsp_features_update_scalar(&scalar, bench_filtered[1], block, BENCH_ADC_MID);
+    features[1] = cycles_now() - start;
+
+    ok = (0 == memcmp(bench_filtered[0], bench_filtered[1], block * sizeof(int16_t))) &&
+         (0 == memcmp(&simd, &scalar, sizeof(simd)));
+
+    printf("  %6lu %8lu / %7lu %8lu / %7lu %6lu / %5lu%s\r\n", (unsigned long)block,
+           (unsigned long)fir[0], (unsigned long)fir[1],
+           (unsigned long)features[0], (unsigned long)features[1],
+           (unsigned long)((fir[0] + features[0]) / block),
+           (unsigned long)((fir[1] + features[1]) / block),
+           ok ? "" : "  MISMATCH");
+}
+
+/*******************************************************************************
+* Function Name: bench_fill
+********************************************************************************
+* Summary:
+*  Fills the input with a random walk around mid-scale of a 12-bit ADC.
+*
+* Parameters:
+*  uint32_t step - largest change between samples plus one
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_fill(uint32_t step)
+{
+    uint32_t seed = BENCH_SEED;
+    int32_t value = BENCH_ADC_MID;
+    uint32_t i;
+
+    for (i = 0u; i < BENCH_SAMPLES; i++)
+    {
+        seed = (seed * 1664525uL) + 1013904223uL;
+        value += (int32_t)((seed >> 16) % step) - (int32_t)(step / 2u);
+        value = (value < 0) ? 0 : ((value > 4095) ? 4095 : value);
+        bench_samples[i] = (int16_t)value;
+    }
+}
+
+/*******************************************************************************
+* Function Name: bench_compress_run
+********************************************************************************
+* Summary:
+*  Encodes the input block by block, decodes it again, checks the result and
+*  prints one table row.
+*
+* Parameters:
+*  const char *name - data set name
+*  bool bitpack     - also try bit-packing
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_compress_run(const char *name, bool bitpack)
+{
+    uint32_t length[BENCH_SAMPLES / BENCH_BLOCK_SIZE];
+    uint32_t size = 0u;
+    uint32_t enc, dec, start, block, i;
+    bool ok = true;
+
+    start = cycles_now();
+    for (block = 0u; block < (BENCH_SAMPLES / BENCH_BLOCK_SIZE); block++)
+    {
+        length[block] = compress_block_encode(&bench_samples[block * BENCH_BLOCK_SIZE], BENCH_BLOCK_SIZE,
+                                              bitpack, &bench_coded[size], sizeof(bench_coded) - size);
+        size += length[block];
+    }
+    enc = cycles_now() - start;
+
+    size = 0u;
+    dec = 0u;
+    for (block = 0u; block < (BENCH_SAMPLES / BENCH_BLOCK_SIZE); block++)
+    {
+        start = cycles_now();
+        (void)compress_block_decode(&bench_coded[size], length[block], bench_decoded, BENCH_BLOCK_SIZE);
+        dec += cycles_now() - start;
+        size += length[block];
+
+        for (i = 0u; i < BENCH_BLOCK_SIZE; i++)
+        {
+            ok = ok && (bench_decoded[i] == bench_samples[(block * BENCH_BLOCK_SIZE) + i]);
+        }
+    }
+
+    printf("  %-16s %-8s %10lu %10lu %7lu.%02lu%s\r\n", name, bitpack ? "bitpack" : "varint",
+           (unsigned long)(enc / BENCH_SAMPLES), (unsigned long)(dec / BENCH_SAMPLES),
+           (unsigned long)((size * 8u) / BENCH_SAMPLES),
+           (unsigned long)(((size * 800u) / BENCH_SAMPLES) % 100u),
+           ok ? "" : "  MISMATCH");
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,467 @@
+/*******************************************************************************
+* File Name:   button_gesture.c
+*
+* Description: This file implements the user button gesture recognizer. Button
+*              edges are timestamped on the low-power timer in the GPIO interrupt
+*              and fed to a small state machine; timeouts use a low-power timer
+*              channel, so the CPU can sleep between edges. Recognized gestures
+*              are queued and their actions run from the main loop.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cybsp.h"
+#include "button_gesture.h"
+#include "lptimer.h"
+#include "wake_source.h"
+#include "trace.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define GESTURE_INTERRUPT_PRIORITY  (3u)
+#define GESTURE_QUEUE_SIZE          (8u)    /* Power of two */
+
+#define GESTURE_MS_TO_TICKS(ms)     LPTIMER_US_TO_TICKS((ms) * 1000u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef enum
+{
+    GESTURE_STATE_IDLE          = 0u,
+    GESTURE_STATE_PRESSED       = 1u,   /* Pressed, not yet a hold */
+    GESTURE_STATE_RELEASED      = 2u,   /* Released, waiting for next click */
+    GESTURE_STATE_HOLDING       = 3u,
+    GESTURE_STATE_WAIT_RELEASE  = 4u,   /* Ignore the press until release */
+} en_gesture_state_t;
+
+typedef enum
+{
+    GESTURE_EVENT_PRESS         = 0u,
+    GESTURE_EVENT_RELEASE       = 1u,
+    GESTURE_EVENT_TIMEOUT       = 2u,
+} en_gesture_event_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const char *const gesture_names[GESTURE_COUNT] =
+{
+    "single click",
+    "double click",
+    "triple click",
+    "hold",
+    "hold repeat",
+    "hold release",
+    "very long press"
+};
+
+/* Multi-click gesture by number of clicks */
+static const en_gesture_t click_gestures[3] =
+{
+    GESTURE_SINGLE_CLICK,
+    GESTURE_DOUBLE_CLICK,
+    GESTURE_TRIPLE_CLICK
+};
+
+static const stc_gesture_binding_t *gesture_table;
+static uint32_t gesture_table_count;
+
+/* State machine, owned by the GPIO and low-power timer interrupts */
+static en_gesture_state_t gesture_state = GESTURE_STATE_IDLE;
+static uint32_t press_time;
+static uint32_t release_time;
+static uint32_t next_repeat;
+static uint32_t click_count;
+static bool button_down = false;
+
+/* Recognized gestures, single producer (interrupts) / single consumer (main) */
+static volatile en_gesture_t gesture_queue[GESTURE_QUEUE_SIZE];
+static volatile uint8_t queue_head = 0u;
+static volatile uint8_t queue_tail = 0u;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void gesture_emit(en_gesture_t gesture);
+static void gesture_process(en_gesture_event_t event, uint32_t now);
+static void gesture_button_interrupt_handler(void);
+static void gesture_timeout_handler(void);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: gesture_init
+********************************************************************************
+* Summary:
+*  Registers the gesture table and enables the user button interrupt on both
+*  edges. The low-power timer must be initialized first.
+*
+* Parameters:
+*  const stc_gesture_binding_t *table - gesture to action bindings
+*  uint32_t count                     - number of entries in 'table'
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void gesture_init(const stc_gesture_binding_t *table, uint32_t count)
+{
+    cy_stc_sysint_t button_intr_config =
+    {
+        .intrSrc = CYBSP_USER_BTN2_IRQ,
+        .intrPriority = GESTURE_INTERRUPT_PRIORITY
+    };
+
+    gesture_table = table;
+    gesture_table_count = count;
+
+    lptimer_register_callback(LPTIMER_CH_AUX, gesture_timeout_handler);
+
+    Cy_GPIO_SetInterruptEdge(CYBSP_USER_BTN2_PORT, CYBSP_USER_BTN2_PIN, CY_GPIO_INTR_BOTH);
+    Cy_GPIO_ClearInterrupt(CYBSP_USER_BTN2_PORT, CYBSP_USER_BTN2_PIN);
+    Cy_GPIO_SetInterruptMask(CYBSP_USER_BTN2_PORT, CYBSP_USER_BTN2_PIN, 1u);
+
+    Cy_SysInt_Init(&button_intr_config, gesture_button_interrupt_handler);
+    NVIC_ClearPendingIRQ(button_intr_config.intrSrc);
+    NVIC_EnableIRQ(button_intr_config.intrSrc);
+}
+
+/*******************************************************************************
+* Function Name: gesture_is_pending
+********************************************************************************
+* Summary:
+*  Returns true if recognized gestures are waiting to be dispatched.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - true if the queue is not empty
+*
+*******************************************************************************/
+bool gesture_is_pending(void)
+{
+    return (queue_head != queue_tail);
+}
+
+/*******************************************************************************
+* Function Name: gesture_ignore_current_press
+********************************************************************************
+* Summary:
+*  Drops the gesture in progress. If the button is down, the press is ignored
+*  until release; used when the press only served to wake the device.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void gesture_ignore_current_press(void)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    lptimer_disarm(LPTIMER_CH_AUX);
+    gesture_state = button_down ? GESTURE_STATE_WAIT_RELEASE : GESTURE_STATE_IDLE;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/*******************************************************************************
+* Function Name: gesture_dispatch
+********************************************************************************
+* Summary:
+*  Runs the actions bound to all queued gestures. Called from the main loop so
+*  that actions may enter low-power modes.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void gesture_dispatch(void)
+{
+    en_gesture_t gesture;
+    uint32_t i;
+
+    while (queue_head != queue_tail)
+    {
+        gesture = gesture_queue[queue_tail];
+        queue_tail = (uint8_t)((queue_tail + 1u) & (GESTURE_QUEUE_SIZE - 1u));
+        trace_record(TRACE_EVENT_GESTURE, (uint32_t)gesture);
+
+        for (i = 0u; i < gesture_table_count; i++)
+        {
+            if ((gesture_table[i].gesture == gesture) && (NULL != gesture_table[i].action))
+            {
+                gesture_table[i].action();
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: gesture_get_name
+********************************************************************************
+* Summary:
+*  Returns a printable name of the gesture.
+*
+* Parameters:
+*  en_gesture_t gesture - gesture
+*
+* Return:
+*  const char * - gesture name
+*
+*******************************************************************************/
+const char *gesture_get_name(en_gesture_t gesture)
+{
+    return (gesture < GESTURE_COUNT) ? gesture_names[gesture] : "unknown";
+}
+
+/*******************************************************************************
+* Function Name: gesture_emit
+********************************************************************************
+* Summary:
+*  Queues a recognized gesture. The gesture is dropped if the queue is full.
+*
+* Parameters:
+*  en_gesture_t gesture - recognized gesture
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void gesture_emit(en_gesture_t gesture)
+{
+    uint8_t next = (uint8_t)((queue_head + 1u) & (GESTURE_QUEUE_SIZE - 1u));
+
+    if (next != queue_tail)
+    {
+        gesture_queue[queue_head] = gesture;
+        queue_head = next;
+    }
+}
+
+/*******************************************************************************
+* Function Name: gesture_process
+********************************************************************************
+* Summary:
+*  Advances the gesture state machine on a button edge or timeout.
+*   - A press shorter than GESTURE_CLICK_MIN_MS is a glitch and is undone.
+*   - Clicks separated by less than GESTURE_CLICK_GAP_MS are counted; the click
+*     gesture is emitted when the gap expires or on the third click.
+*   - A press longer than GESTURE_HOLD_MS emits HOLD_START, then HOLD_REPEAT
+*     every GESTURE_REPEAT_MS, and HOLD_RELEASE on release.
+*   - After GESTURE_VERY_LONG_MS the hold becomes VERY_LONG_PRESS and the
+*     release is swallowed.
+*
+* Parameters:
+*  en_gesture_event_t event - button edge or timeout
+*  uint32_t now             - low-power timer timestamp of the event
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void gesture_process(en_gesture_event_t event, uint32_t now)
+{
+    uint32_t very_long_at;
+
+    switch (gesture_state)
+    {
+        case GESTURE_STATE_IDLE:
+        case GESTURE_STATE_RELEASED:
+            if (GESTURE_EVENT_PRESS == event)
+            {
+                if (GESTURE_STATE_IDLE == gesture_state)
+                {
+                    click_count = 0u;
+                }
+                press_time = now;
+                gesture_state = GESTURE_STATE_PRESSED;
+                lptimer_arm(LPTIMER_CH_AUX, now + GESTURE_MS_TO_TICKS(GESTURE_HOLD_MS));
+            }
+            else if ((GESTURE_EVENT_TIMEOUT == event) && (GESTURE_STATE_RELEASED == gesture_state))
+            {
+                gesture_emit(click_gestures[click_count - 1u]);
+                gesture_state = GESTURE_STATE_IDLE;
+            }
+            break;
+
+        case GESTURE_STATE_PRESSED:
+            if (GESTURE_EVENT_RELEASE == event)
+            {
+                if ((now - press_time) < GESTURE_MS_TO_TICKS(GESTURE_CLICK_MIN_MS))
+                {
+                    /* Glitch: back to where the press found us */
+                    if (0u == click_count)
+                    {
+                        lptimer_disarm(LPTIMER_CH_AUX);
+                        gesture_state = GESTURE_STATE_IDLE;
+                    }
+                    else
+                    {
+                        lptimer_arm(LPTIMER_CH_AUX, release_time + GESTURE_MS_TO_TICKS(GESTURE_CLICK_GAP_MS));
+                        gesture_state = GESTURE_STATE_RELEASED;
+                    }
+                    break;
+                }
+
+                click_count++;
+                release_time = now;
+                if (click_count >= CY_ARRAY_SIZE(click_gestures))
+                {
+                    lptimer_disarm(LPTIMER_CH_AUX);
+                    gesture_emit(click_gestures[click_count - 1u]);
+                    gesture_state = GESTURE_STATE_IDLE;
+                }
+                else
+                {
+                    lptimer_arm(LPTIMER_CH_AUX, now + GESTURE_MS_TO_TICKS(GESTURE_CLICK_GAP_MS));
+                    gesture_state = GESTURE_STATE_RELEASED;
+                }
+            }
+            else if (GESTURE_EVENT_TIMEOUT == event)
+            {
+                gesture_emit(GESTURE_HOLD_START);
+                next_repeat = now + GESTURE_MS_TO_TICKS(GESTURE_REPEAT_MS);
+                lptimer_arm(LPTIMER_CH_AUX, next_repeat);
+                gesture_state = GESTURE_STATE_HOLDING;
+            }
+            break;
+
+        case GESTURE_STATE_HOLDING:
+            if (GESTURE_EVENT_RELEASE == event)
+            {
+                lptimer_disarm(LPTIMER_CH_AUX);
+                gesture_emit(GESTURE_HOLD_RELEASE);
+                gesture_state = GESTURE_STATE_IDLE;
+            }
+            else if (GESTURE_EVENT_TIMEOUT == event)
+            {
+                very_long_at = press_time + GESTURE_MS_TO_TICKS(GESTURE_VERY_LONG_MS);
+                if (((int32_t)(now - very_long_at)) >= 0)
+                {
+                    gesture_emit(GESTURE_VERY_LONG_PRESS);
+                    gesture_state = GESTURE_STATE_WAIT_RELEASE;
+                }
+                else
+                {
+                    gesture_emit(GESTURE_HOLD_REPEAT);
+                    next_repeat += GESTURE_MS_TO_TICKS(GESTURE_REPEAT_MS);
+                    lptimer_arm(LPTIMER_CH_AUX,
+                                (((int32_t)(next_repeat - very_long_at)) < 0) ? next_repeat : very_long_at);
+                }
+            }
+            break;
+
+        case GESTURE_STATE_WAIT_RELEASE:
+            if (GESTURE_EVENT_RELEASE == event)
+            {
+                gesture_state = GESTURE_STATE_IDLE;
+            }
+            break;
+
+        default:
+            gesture_state = GESTURE_STATE_IDLE;
+            break;
+    }
+}
+
+/*******************************************************************************
+* Function Name: gesture_button_interrupt_handler
+********************************************************************************
+* Summary:
+*  User button interrupt handler. Timestamps the edge and feeds it to the state
+*  machine. Edges that do not change the debounced level are ignored. The edge
+*  selected by BUTTON_WAKE_EDGE is also signaled as a button wakeup.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void gesture_button_interrupt_handler(void)
+{
+    uint32_t now = lptimer_now();
+    bool pressed;
+
+    Cy_GPIO_ClearInterrupt(CYBSP_USER_BTN2_PORT, CYBSP_USER_BTN2_PIN);
+
+    pressed = (CYBSP_BTN_PRESSED == Cy_GPIO_Read(CYBSP_USER_BTN2_PORT, CYBSP_USER_BTN2_PIN));
+    if (pressed != button_down)
+    {
+        button_down = pressed;
+        if (pressed == (BUTTON_WAKE_EDGE == CY_GPIO_INTR_FALLING))
+        {
+            wake_source_signal(WAKE_SOURCE_BUTTON);
+        }
+        gesture_process(pressed ? GESTURE_EVENT_PRESS : GESTURE_EVENT_RELEASE, now);
+    }
+}
+
+/*******************************************************************************
+* Function Name: gesture_timeout_handler
+********************************************************************************
+* Summary:
+*  Low-power timer callback for gesture timeouts.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void gesture_timeout_handler(void)
+{
+    gesture_process(GESTURE_EVENT_TIMEOUT, lptimer_now());
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,98 @@
+/*******************************************************************************
+* File Name:   button_gesture.h
+*
+* Description: This file contains the interface of the table-driven gesture
+*              recognizer for the user button (SW2).
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_BUTTON_GESTURE_H_
+#define SOURCE_BUTTON_GESTURE_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Gesture timing (ms) */
+#define GESTURE_CLICK_MIN_MS        (50u)   /* Shorter presses are glitches */
+#define GESTURE_CLICK_GAP_MS        (300u)  /* Max release between clicks */
+#define GESTURE_HOLD_MS             (2000u) /* Press becomes a hold */
+#define GESTURE_REPEAT_MS           (500u)  /* Repeat interval while held */
+#define GESTURE_VERY_LONG_MS        (8000u) /* Hold becomes a very long press */
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Gestures recognized on the user button */
+typedef enum
+{
+    GESTURE_SINGLE_CLICK    = 0u,
+    GESTURE_DOUBLE_CLICK    = 1u,
+    GESTURE_TRIPLE_CLICK    = 2u,
+    GESTURE_HOLD_START      = 3u,   /* Held for GESTURE_HOLD_MS */
+    GESTURE_HOLD_REPEAT     = 4u,   /* Every GESTURE_REPEAT_MS while held */
+    GESTURE_HOLD_RELEASE    = 5u,   /* Released after a hold */
+    GESTURE_VERY_LONG_PRESS = 6u,   /* Held for GESTURE_VERY_LONG_MS */
+    GESTURE_COUNT           = 7u,
+} en_gesture_t;
+
+/* Action run from the main loop when its gesture is recognized */
+typedef void (*gesture_action_t)(void);
+
+/* Entry of the application gesture table */
+typedef struct
+{
+    en_gesture_t        gesture;
+    gesture_action_t    action;
+} stc_gesture_binding_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void gesture_init(const stc_gesture_binding_t *table, uint32_t count);
+bool gesture_is_pending(void);
+void gesture_ignore_current_press(void);
+void gesture_dispatch(void);
+const char *gesture_get_name(en_gesture_t gesture);
+
+#endif /* SOURCE_BUTTON_GESTURE_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,119 @@
+/*******************************************************************************
+* File Name:   calendar.c
+*
+* Description: This file contains the conversions between the RTC calendar
+*              and epoch seconds: seconds since 1970-01-01 00:00:00, as a 64-bit
+*              count. Dates map to a day number in calendar_civil.c, so that
+*              alarm arithmetic can be done on plain seconds.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "calendar.h"
+
+/* The RTC numbers the days of the week as the civil conversions do */
+_Static_assert(CALENDAR_SUNDAY == CY_RTC_SUNDAY, "Day of the week numbering");
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: calendar_rtc_to_epoch
+********************************************************************************
+* Summary:
+*  Converts an RTC date and time to epoch seconds. The RTC year 0 to 99 is
+*  2000 to 2099. 12-hour times are converted.
+*
+* Parameters:
+*  const cy_stc_rtc_config_t *rtc - date and time, as Cy_RTC_GetDateAndTime()
+*
+* Return:
+*  uint64_t - seconds since 1970-01-01 00:00:00
+*
+*******************************************************************************/
+uint64_t calendar_rtc_to_epoch(const cy_stc_rtc_config_t *rtc)
+{
+    int32_t days;
+    uint32_t hour = rtc->hour;
+
+    if (CY_RTC_12_HOURS == rtc->hrFormat)
+    {
+        hour = (hour % 12u) + ((CY_RTC_PM == rtc->amPm) ? 12u : 0u);
+    }
+
+    days = calendar_days_from_civil(CALENDAR_RTC_BASE_YEAR + (int32_t)rtc->year, rtc->month, rtc->date);
+    return ((uint64_t)days * CALENDAR_SECONDS_PER_DAY) +
+           (hour * 3600u) + (rtc->min * 60u) + rtc->sec;
+}
+
+/*******************************************************************************
+* Function Name: calendar_epoch_to_rtc
+********************************************************************************
+* Summary:
+*  Converts epoch seconds to an RTC date and time in 24-hour format, with the
+*  day of the week. The time must be within the RTC years 2000 to 2099.
+*
+* Parameters:
+*  uint64_t epoch_s         - seconds since 1970-01-01 00:00:00
+*  cy_stc_rtc_config_t *rtc - destination, for Cy_RTC_SetDateAndTime()
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void calendar_epoch_to_rtc(uint64_t epoch_s, cy_stc_rtc_config_t *rtc)
+{
+    /* One 64-bit division; the rest fits 32 bits */
+    int32_t days = (int32_t)(epoch_s / CALENDAR_SECONDS_PER_DAY);
+    uint32_t seconds = (uint32_t)(epoch_s - ((uint64_t)days * CALENDAR_SECONDS_PER_DAY));
+    int32_t year;
+
+    calendar_civil_from_days(days, &year, &rtc->month, &rtc->date);
+    rtc->year = (uint32_t)(year - CALENDAR_RTC_BASE_YEAR);
+    rtc->dayOfWeek = calendar_day_of_week(days);
+    rtc->hour = seconds / 3600u;
+    rtc->min = (seconds / 60u) % 60u;
+    rtc->sec = seconds % 60u;
+    rtc->hrFormat = CY_RTC_24_HOURS;
+    rtc->amPm = CY_RTC_AM;
+}
+
+/* [] END OF FILE */
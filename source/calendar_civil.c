@@ -0,0 +1,171 @@
+/*******************************************************************************
+* File Name:   calendar_civil.c
+*
+* Description: This file contains the conversions between Gregorian dates and
+*              day numbers since 1970-01-01, with a fixed sequence of integer
+*              operations and no loops over years or months. They use no PDL,
+*              so that they also build on the host for tests/calendar_test.c.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "calendar_civil.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* The conversions count years from March, so that the leap day is the last
+   day of a year, in eras of 400 years */
+#define CALENDAR_DAYS_PER_ERA       (146097)
+#define CALENDAR_YEARS_PER_ERA      (400)
+#define CALENDAR_DAYS_TO_EPOCH      (719468)    /* 0000-03-01 to 1970-01-01 */
+#define CALENDAR_EPOCH_DAY_OF_WEEK  (4)         /* 1970-01-01 was a Thursday */
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: calendar_is_leap_year
+********************************************************************************
+* Summary:
+*  Returns whether a Gregorian year has 366 days.
+*
+* Parameters:
+*  int32_t year - full year, for example 2024
+*
+* Return:
+*  bool - true for a leap year
+*
+*******************************************************************************/
+bool calendar_is_leap_year(int32_t year)
+{
+    return ((0 == (year % 4)) && (0 != (year % 100))) || (0 == (year % 400));
+}
+
+/*******************************************************************************
+* Function Name: calendar_days_from_civil
+********************************************************************************
+* Summary:
+*  Converts a Gregorian date to the number of days since 1970-01-01.
+*
+* Parameters:
+*  int32_t year   - full year
+*  uint32_t month - 1 to 12
+*  uint32_t day   - 1 to 31
+*
+* Return:
+*  int32_t - days since 1970-01-01, negative before it
+*
+*******************************************************************************/
+int32_t calendar_days_from_civil(int32_t year, uint32_t month, uint32_t day)
+{
+    int32_t era;
+    uint32_t yoe;
+    uint32_t doy;
+    uint32_t doe;
+
+    /* January and February belong to the year before */
+    year -= (month <= 2u) ? 1 : 0;
+    era = ((year >= 0) ? year : (year - (CALENDAR_YEARS_PER_ERA - 1))) / CALENDAR_YEARS_PER_ERA;
+    yoe = (uint32_t)(year - (era * CALENDAR_YEARS_PER_ERA));
+    doy = (((153u * ((month > 2u) ? (month - 3u) : (month + 9u))) + 2u) / 5u) + day - 1u;
+    doe = (yoe * 365u) + (yoe / 4u) - (yoe / 100u) + doy;
+
+    return (era * CALENDAR_DAYS_PER_ERA) + (int32_t)doe - CALENDAR_DAYS_TO_EPOCH;
+}
+
+/*******************************************************************************
+* Function Name: calendar_civil_from_days
+********************************************************************************
+* Summary:
+*  Converts a number of days since 1970-01-01 to a Gregorian date.
+*
+* Parameters:
+*  int32_t days    - days since 1970-01-01
+*  int32_t *year   - full year
+*  uint32_t *month - 1 to 12
+*  uint32_t *day   - 1 to 31
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void calendar_civil_from_days(int32_t days, int32_t *year, uint32_t *month, uint32_t *day)
+{
+    int32_t era;
+    uint32_t doe;
+    uint32_t yoe;
+    uint32_t doy;
+    uint32_t mp;
+
+    days += CALENDAR_DAYS_TO_EPOCH;
+    era = ((days >= 0) ? days : (days - (CALENDAR_DAYS_PER_ERA - 1))) / CALENDAR_DAYS_PER_ERA;
+    doe = (uint32_t)(days - (era * CALENDAR_DAYS_PER_ERA));
+    yoe = (doe - (doe / 1460u) + (doe / 36524u) - (doe / 146096u)) / 365u;
+    doy = doe - ((365u * yoe) + (yoe / 4u) - (yoe / 100u));
+    mp = ((5u * doy) + 2u) / 153u;
+
+    *day = doy - (((153u * mp) + 2u) / 5u) + 1u;
+    *month = (mp < 10u) ? (mp + 3u) : (mp - 9u);
+    *year = (int32_t)yoe + (era * CALENDAR_YEARS_PER_ERA) + ((*month <= 2u) ? 1 : 0);
+}
+
+/*******************************************************************************
+* Function Name: calendar_day_of_week
+********************************************************************************
+* Summary:
+*  Returns the day of the week of a day number, in the numbering of the RTC.
+*
+* Parameters:
+*  int32_t days - days since 1970-01-01
+*
+* Return:
+*  uint32_t - CALENDAR_SUNDAY to CALENDAR_SUNDAY + 6
+*
+*******************************************************************************/
+uint32_t calendar_day_of_week(int32_t days)
+{
+    int32_t dow = (days + CALENDAR_EPOCH_DAY_OF_WEEK) % 7;
+
+    return (uint32_t)((dow < 0) ? (dow + 7) : dow) + CALENDAR_SUNDAY;
+}
+
+/* [] END OF FILE */
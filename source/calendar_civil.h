@@ -0,0 +1,68 @@
+/*******************************************************************************
+* File Name:   calendar_civil.h
+*
+* Description: This file contains the interface of the conversions between
+*              Gregorian dates and day numbers. It includes no PDL header.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_CALENDAR_CIVIL_H_
+#define SOURCE_CALENDAR_CIVIL_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CALENDAR_SECONDS_PER_DAY    (86400u)
+#define CALENDAR_SUNDAY             (1u)        /* CY_RTC_SUNDAY; Saturday is 7 */
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool calendar_is_leap_year(int32_t year);
+int32_t calendar_days_from_civil(int32_t year, uint32_t month, uint32_t day);
+void calendar_civil_from_days(int32_t days, int32_t *year, uint32_t *month, uint32_t *day);
+uint32_t calendar_day_of_week(int32_t days);
+
+#endif /* SOURCE_CALENDAR_CIVIL_H_ */
+
+/* [] END OF FILE */
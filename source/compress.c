@@ -0,0 +1,435 @@
+/*******************************************************************************
+* File Name:   compress.c
+*
+* Description: This file implements the sample block codec. Slowly varying sensor
+*              data has small differences between neighbours: each sample is coded
+*              as the zigzag-mapped delta to the previous one, either as a varint
+*              or bit-packed at the width of the largest delta in the block. The
+*              code uses no heap and no PDL calls, so it also builds on a host.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "compress.h"
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static inline uint32_t zigzag_encode(int32_t delta);
+static inline int32_t zigzag_decode(uint32_t value);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: zigzag_encode
+********************************************************************************
+* Summary:
+*  Maps a signed delta to an unsigned value with small magnitudes first:
+*  0, -1, 1, -2, 2 ... become 0, 1, 2, 3, 4 ...
+*
+* Parameters:
+*  int32_t delta - difference of two samples
+*
+* Return:
+*  uint32_t - zigzag value
+*
+*******************************************************************************/
+static inline uint32_t zigzag_encode(int32_t delta)
+{
+    return ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+}
+
+/*******************************************************************************
+* Function Name: zigzag_decode
+********************************************************************************
+* Summary:
+*  Inverse of zigzag_encode().
+*
+* Parameters:
+*  uint32_t value - zigzag value
+*
+* Return:
+*  int32_t - difference of two samples
+*
+*******************************************************************************/
+static inline int32_t zigzag_decode(uint32_t value)
+{
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1u);
+}
+
+/*******************************************************************************
+* Function Name: compress_varint_encode
+********************************************************************************
+* Summary:
+*  Codes the samples as zigzag deltas in 7-bit groups, low group first; the
+*  top bit of a byte is set if another group follows.
+*
+* Parameters:
+*  const int16_t *samples - input
+*  uint32_t count         - number of samples
+*  int16_t prev           - sample before samples[0]
+*  uint8_t *out           - output
+*  uint32_t out_size      - capacity of 'out'
+*
+* Return:
+*  uint32_t - bytes written, 0 if 'out' is too small
+*
+*******************************************************************************/
+uint32_t compress_varint_encode(const int16_t *samples, uint32_t count, int16_t prev,
+                                uint8_t *out, uint32_t out_size)
+{
+    uint32_t pos = 0u;
+    uint32_t value;
+    uint32_t i;
+
+    for (i = 0u; i < count; i++)
+    {
+        value = zigzag_encode((int32_t)samples[i] - (int32_t)prev);
+        prev = samples[i];
+        do
+        {
+            if (pos >= out_size)
+            {
+                return 0u;
+            }
+            out[pos++] = (uint8_t)((value & 0x7Fu) | ((value > 0x7Fu) ? 0x80u : 0u));
+            value >>= 7;
+        } while (0u != value);
+    }
+
+    return pos;
+}
+
+/*******************************************************************************
+* Function Name: compress_varint_decode
+********************************************************************************
+* Summary:
+*  Inverse of compress_varint_encode().
+*
+* Parameters:
+*  const uint8_t *in - coded data
+*  uint32_t in_size  - size of 'in'
+*  int16_t prev      - sample before the first one
+*  int16_t *samples  - output
+*  uint32_t count    - number of samples to decode
+*
+* Return:
+*  uint32_t - bytes consumed, 0 if 'in' is truncated or corrupt
+*
+*******************************************************************************/
+uint32_t compress_varint_decode(const uint8_t *in, uint32_t in_size, int16_t prev,
+                                int16_t *samples, uint32_t count)
+{
+    uint32_t pos = 0u;
+    uint32_t value, shift;
+    uint32_t i;
+
+    for (i = 0u; i < count; i++)
+    {
+        value = 0u;
+        shift = 0u;
+        do
+        {
+            if ((pos >= in_size) || (shift > 14u))
+            {
+                return 0u;
+            }
+            value |= (uint32_t)(in[pos] & 0x7Fu) << shift;
+            shift += 7u;
+        } while (0u != (in[pos++] & 0x80u));
+
+        prev = (int16_t)((int32_t)prev + zigzag_decode(value));
+        samples[i] = prev;
+    }
+
+    return pos;
+}
+
+/*******************************************************************************
+* Function Name: compress_bitpack_width
+********************************************************************************
+* Summary:
+*  Returns the number of bits needed by the largest zigzag delta.
+*
+* Parameters:
+*  const int16_t *samples - input
+*  uint32_t count         - number of samples
+*  int16_t prev           - sample before samples[0]
+*
+* Return:
+*  uint32_t - width in bits, 0 to COMPRESS_MAX_WIDTH
+*
+*******************************************************************************/
+uint32_t compress_bitpack_width(const int16_t *samples, uint32_t count, int16_t prev)
+{
+    uint32_t all = 0u;
+    uint32_t width = 0u;
+    uint32_t i;
+
+    for (i = 0u; i < count; i++)
+    {
+        all |= zigzag_encode((int32_t)samples[i] - (int32_t)prev);
+        prev = samples[i];
+    }
+    while (0u != all)
+    {
+        width++;
+        all >>= 1;
+    }
+
+    return width;
+}
+
+/*******************************************************************************
+* Function Name: compress_bitpack_encode
+********************************************************************************
+* Summary:
+*  Packs the zigzag deltas at 'width' bits each, LSB first, into
+*  COMPRESS_BITPACK_SIZE(count, width) bytes.
+*
+* Parameters:
+*  const int16_t *samples - input
+*  uint32_t count         - number of samples
+*  int16_t prev           - sample before samples[0]
+*  uint32_t width         - from compress_bitpack_width()
+*  uint8_t *out           - output
+*  uint32_t out_size      - capacity of 'out'
+*
+* Return:
+*  bool - false if 'out' is too small or 'width' is invalid
+*
+*******************************************************************************/
+bool compress_bitpack_encode(const int16_t *samples, uint32_t count, int16_t prev,
+                             uint32_t width, uint8_t *out, uint32_t out_size)
+{
+    uint32_t acc = 0u;
+    uint32_t bits = 0u;
+    uint32_t pos = 0u;
+    uint32_t i;
+
+    if ((width > COMPRESS_MAX_WIDTH) || (COMPRESS_BITPACK_SIZE(count, width) > out_size))
+    {
+        return false;
+    }
+
+    for (i = 0u; i < count; i++)
+    {
+        acc |= zigzag_encode((int32_t)samples[i] - (int32_t)prev) << bits;
+        prev = samples[i];
+        bits += width;
+        while (bits >= 8u)
+        {
+            out[pos++] = (uint8_t)acc;
+            acc >>= 8;
+            bits -= 8u;
+        }
+    }
+    if (0u != bits)
+    {
+        out[pos] = (uint8_t)acc;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: compress_bitpack_decode
+********************************************************************************
+* Summary:
+*  Inverse of compress_bitpack_encode().
+*
+* Parameters:
+*  const uint8_t *in - packed data
+*  uint32_t in_size  - size of 'in'
+*  int16_t prev      - sample before the first one
+*  uint32_t width    - bits per delta
+*  int16_t *samples  - output
+*  uint32_t count    - number of samples to decode
+*
+* Return:
+*  bool - false if 'in' is truncated or 'width' is invalid
+*
+*******************************************************************************/
+bool compress_bitpack_decode(const uint8_t *in, uint32_t in_size, int16_t prev,
+                             uint32_t width, int16_t *samples, uint32_t count)
+{
+    uint32_t mask;
+    uint32_t acc = 0u;
+    uint32_t bits = 0u;
+    uint32_t pos = 0u;
+    uint32_t i;
+
+    if ((width > COMPRESS_MAX_WIDTH) || (COMPRESS_BITPACK_SIZE(count, width) > in_size))
+    {
+        return false;
+    }
+
+    mask = (1u << width) - 1u;
+
+    for (i = 0u; i < count; i++)
+    {
+        while (bits < width)
+        {
+            acc |= (uint32_t)in[pos++] << bits;
+            bits += 8u;
+        }
+        prev = (int16_t)((int32_t)prev + zigzag_decode(acc & mask));
+        samples[i] = prev;
+        acc >>= width;
+        bits -= width;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: compress_block_encode
+********************************************************************************
+* Summary:
+*  Codes a self-contained block: a header with the sample count, the mode and
+*  the first sample, then the deltas of the others. With 'bitpack' set, the
+*  smaller of the bit-packed and the varint coding is kept.
+*
+* Parameters:
+*  const int16_t *samples - input, 1 to 255 samples
+*  uint32_t count         - number of samples
+*  bool bitpack           - try bit-packing as well
+*  uint8_t *out           - output
+*  uint32_t out_size      - capacity of 'out'
+*
+* Return:
+*  uint32_t - bytes written, 0 on bad parameters or if 'out' is too small
+*
+*******************************************************************************/
+uint32_t compress_block_encode(const int16_t *samples, uint32_t count, bool bitpack,
+                               uint8_t *out, uint32_t out_size)
+{
+    uint32_t width;
+    uint32_t size;
+    uint32_t packed;
+
+    if ((0u == count) || (count > 0xFFu) || (out_size < COMPRESS_HEADER_SIZE))
+    {
+        return 0u;
+    }
+
+    out[0] = (uint8_t)count;
+    out[2] = (uint8_t)((uint16_t)samples[0]);
+    out[3] = (uint8_t)((uint16_t)samples[0] >> 8);
+
+    /* Varint wins only when a few large deltas would widen all the others */
+    size = compress_varint_encode(&samples[1], count - 1u, samples[0],
+                                  &out[COMPRESS_HEADER_SIZE], out_size - COMPRESS_HEADER_SIZE);
+    out[1] = COMPRESS_MODE_VARINT;
+    if (bitpack)
+    {
+        width = compress_bitpack_width(&samples[1], count - 1u, samples[0]);
+        packed = COMPRESS_BITPACK_SIZE(count - 1u, width);
+        if (((0u == size) || (packed <= size)) &&
+            compress_bitpack_encode(&samples[1], count - 1u, samples[0], width,
+                                    &out[COMPRESS_HEADER_SIZE], out_size - COMPRESS_HEADER_SIZE))
+        {
+            out[1] = (uint8_t)width;
+            return COMPRESS_HEADER_SIZE + packed;
+        }
+    }
+    if ((0u == size) && (count > 1u))
+    {
+        return 0u;
+    }
+
+    return COMPRESS_HEADER_SIZE + size;
+}
+
+/*******************************************************************************
+* Function Name: compress_block_decode
+********************************************************************************
+* Summary:
+*  Inverse of compress_block_encode().
+*
+* Parameters:
+*  const uint8_t *in  - coded block
+*  uint32_t in_size   - size of 'in'
+*  int16_t *samples   - output
+*  uint32_t max_count - capacity of 'samples'
+*
+* Return:
+*  uint32_t - number of samples, 0 if the block is corrupt or does not fit
+*
+*******************************************************************************/
+uint32_t compress_block_decode(const uint8_t *in, uint32_t in_size,
+                               int16_t *samples, uint32_t max_count)
+{
+    uint32_t count;
+    bool ok;
+
+    if (in_size < COMPRESS_HEADER_SIZE)
+    {
+        return 0u;
+    }
+    count = in[0];
+    if ((0u == count) || (count > max_count))
+    {
+        return 0u;
+    }
+
+    samples[0] = (int16_t)((uint16_t)in[2] | ((uint16_t)in[3] << 8));
+    if (1u == count)
+    {
+        return count;
+    }
+
+    if (COMPRESS_MODE_VARINT == in[1])
+    {
+        ok = (0u != compress_varint_decode(&in[COMPRESS_HEADER_SIZE], in_size - COMPRESS_HEADER_SIZE,
+                                           samples[0], &samples[1], count - 1u));
+    }
+    else
+    {
+        ok = compress_bitpack_decode(&in[COMPRESS_HEADER_SIZE], in_size - COMPRESS_HEADER_SIZE,
+                                     samples[0], in[1], &samples[1], count - 1u);
+    }
+
+    return ok ? count : 0u;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,90 @@
+/*******************************************************************************
+* File Name:   compress.h
+*
+* Description: This file contains the interface of the sample block codec: delta,
+*              zigzag and varint coding, or bit-packing per block.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_COMPRESS_H_
+#define SOURCE_COMPRESS_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Block header: sample count, mode, first sample (little endian) */
+#define COMPRESS_HEADER_SIZE        (4u)
+
+/* Largest zigzag delta of two int16_t samples is 17 bits */
+#define COMPRESS_MAX_WIDTH          (17u)
+
+/* Mode byte: bit-packing width, or COMPRESS_MODE_VARINT */
+#define COMPRESS_MODE_VARINT        (0x80u)
+
+/* Size of 'count' deltas bit-packed at 'width' bits */
+#define COMPRESS_BITPACK_SIZE(count, width) ((((count) * (width)) + 7u) / 8u)
+
+/* Worst-case size of an encoded block of 'count' samples: three varint bytes
+   per delta */
+#define COMPRESS_MAX_BLOCK_SIZE(count) (COMPRESS_HEADER_SIZE + (3u * ((count) - 1u)))
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+uint32_t compress_varint_encode(const int16_t *samples, uint32_t count, int16_t prev,
+                                uint8_t *out, uint32_t out_size);
+uint32_t compress_varint_decode(const uint8_t *in, uint32_t in_size, int16_t prev,
+                                int16_t *samples, uint32_t count);
+uint32_t compress_bitpack_width(const int16_t *samples, uint32_t count, int16_t prev);
+bool compress_bitpack_encode(const int16_t *samples, uint32_t count, int16_t prev,
+                             uint32_t width, uint8_t *out, uint32_t out_size);
+bool compress_bitpack_decode(const uint8_t *in, uint32_t in_size, int16_t prev,
+                             uint32_t width, int16_t *samples, uint32_t count);
+uint32_t compress_block_encode(const int16_t *samples, uint32_t count, bool bitpack,
+                               uint8_t *out, uint32_t out_size);
+uint32_t compress_block_decode(const uint8_t *in, uint32_t in_size,
+                               int16_t *samples, uint32_t max_count);
+
+#endif /* SOURCE_COMPRESS_H_ */
+
+/* [] END OF FILE */
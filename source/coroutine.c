@@ -0,0 +1,177 @@
+/*******************************************************************************
+* File Name:   coroutine.c
+*
+* Description: Stackless cooperative coroutines (protothreads) for wake jobs
+*              that wait on hardware events or timeouts while the CPU sleeps.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "coroutine.h"
+#include "residency.h"
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: coroutine_run
+********************************************************************************
+* Summary:
+*  Runs the coroutines from their start until all are done. Each pass resumes
+*  every unfinished coroutine once. When none of them yielded, the CPU sleeps
+*  until an interrupt, the earliest deadline or the poll interval, whichever
+*  comes first. Uses the LPTIMER_CH_WAKE channel, so it must not be called
+*  while a pre-armed DeepSleep wakeup is pending.
+*
+* Parameters:
+*  stc_coroutine_t *const coroutines[] - coroutines to run
+*  uint32_t count                      - number of coroutines, at most
+*                                        COROUTINE_MAX
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void coroutine_run(stc_coroutine_t *const coroutines[], uint32_t count)
+{
+    uint32_t active = (count >= COROUTINE_MAX) ? UINT32_MAX : ((1uL << count) - 1u);
+    uint32_t i, wake_at, interrupt_state;
+    stc_coroutine_t *co;
+    bool ready;
+
+    CY_ASSERT(count <= COROUTINE_MAX);
+
+    for (i = 0u; i < count; i++)
+    {
+        coroutines[i]->resume = 0u;
+        coroutines[i]->timed = false;
+    }
+
+    while (0u != active)
+    {
+        ready = false;
+        wake_at = lptimer_now() + COROUTINE_POLL_TICKS;
+        for (i = 0u; i < count; i++)
+        {
+            if (0u == (active & (1uL << i)))
+            {
+                continue;
+            }
+
+            co = coroutines[i];
+            switch (co->body(co))
+            {
+                case COROUTINE_DONE:
+                    active &= ~(1uL << i);
+                    break;
+
+                case COROUTINE_YIELDED:
+                    ready = true;
+                    break;
+
+                default:
+                    if (co->timed && (((int32_t)(co->deadline - wake_at)) < 0))
+                    {
+                        wake_at = co->deadline;
+                    }
+                    break;
+            }
+        }
+
+        if (ready || (0u == active))
+        {
+            continue;
+        }
+
+        /* All wait. The check runs with interrupts masked so that an
+           interrupt raised right before WFI still wakes the CPU. */
+        lptimer_arm(LPTIMER_CH_WAKE, wake_at);
+        interrupt_state = Cy_SysLib_EnterCriticalSection();
+        if (!lptimer_is_expired(LPTIMER_CH_WAKE))
+        {
+            residency_enter(POWER_MODE_SLEEP);
+            Cy_SysPm_CpuEnterSleep(CY_SYSPM_WAIT_FOR_INTERRUPT);
+            residency_enter(POWER_MODE_ACTIVE);
+        }
+        Cy_SysLib_ExitCriticalSection(interrupt_state);
+        lptimer_disarm(LPTIMER_CH_WAKE);
+    }
+}
+
+/*******************************************************************************
+* Function Name: coroutine_set_timeout
+********************************************************************************
+* Summary:
+*  Sets the deadline of the next wait. Used by CO_WAIT_UNTIL_TIMEOUT().
+*
+* Parameters:
+*  stc_coroutine_t *co - coroutine
+*  uint32_t ticks      - low-power timer ticks from now
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void coroutine_set_timeout(stc_coroutine_t *co, uint32_t ticks)
+{
+    co->deadline = lptimer_now() + ticks;
+    co->timed = true;
+}
+
+/*******************************************************************************
+* Function Name: coroutine_timed_out
+********************************************************************************
+* Summary:
+*  Returns true once the deadline of the current wait has passed.
+*
+* Parameters:
+*  const stc_coroutine_t *co - coroutine
+*
+* Return:
+*  bool - true if the wait timed out
+*
+*******************************************************************************/
+bool coroutine_timed_out(const stc_coroutine_t *co)
+{
+    return co->timed && (((int32_t)(lptimer_now() - co->deadline)) >= 0);
+}
+
+/* [] END OF FILE */
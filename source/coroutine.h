@@ -0,0 +1,134 @@
+/*******************************************************************************
+* File Name:   coroutine.h
+*
+* Description: Stackless cooperative coroutines (protothreads) for wake jobs
+*              that wait on hardware events or timeouts while the CPU sleeps.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_COROUTINE_H_
+#define SOURCE_COROUTINE_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "lptimer.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define COROUTINE_MAX               (32u)   /* Coroutines per coroutine_run() */
+
+/* Waits without a deadline are re-checked at least this often, so conditions
+   that no interrupt reports still end */
+#define COROUTINE_POLL_TICKS        (LPTIMER_US_TO_TICKS(1000u))
+
+/* Marks the resume points as intended fall-through */
+#if defined(__GNUC__) && (__GNUC__ >= 7)
+#define CO_FALLTHROUGH              __attribute__((fallthrough))
+#else
+#define CO_FALLTHROUGH
+#endif
+
+/* A coroutine body is a function returning en_coroutine_status_t:
+
+       static en_coroutine_status_t drain(stc_coroutine_t *co)
+       {
+           CO_BEGIN(co);
+           CO_WAIT_UNTIL_TIMEOUT(co, Cy_SCB_UART_IsTxComplete(DEBUG_UART_HW), ticks);
+           CO_END(co);
+       }
+
+   It resumes at the last wait through a switch on the saved line number, so
+   local variables do not survive a wait: keep state in static storage. Put
+   each wait on its own line, and no switch statement around a wait. */
+#define CO_BEGIN(co)                switch ((co)->resume) { case 0u:
+
+#define CO_END(co)                  } (co)->resume = 0u; return COROUTINE_DONE
+
+/* Lets the other coroutines run; resumes on the next pass without sleeping */
+#define CO_YIELD(co)                do { (co)->resume = __LINE__; return COROUTINE_YIELDED; \
+                                         case __LINE__:; } while (0)
+
+/* Sleeps until 'cond' holds */
+#define CO_WAIT_UNTIL(co, cond)     do { (co)->resume = __LINE__; CO_FALLTHROUGH; case __LINE__: \
+                                         if (!(cond)) { return COROUTINE_WAITING; } } while (0)
+
+/* Sleeps until 'cond' holds or 'ticks' low-power timer ticks have passed */
+#define CO_WAIT_UNTIL_TIMEOUT(co, cond, ticks) \
+                                    do { coroutine_set_timeout((co), (ticks)); \
+                                         CO_WAIT_UNTIL((co), (cond) || coroutine_timed_out(co)); \
+                                         (co)->timed = false; } while (0)
+
+/* Sleeps for 'ticks' low-power timer ticks */
+#define CO_DELAY(co, ticks)         CO_WAIT_UNTIL_TIMEOUT((co), false, (ticks))
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef enum
+{
+    COROUTINE_WAITING   = 0u,   /* Blocked on a condition or a timeout */
+    COROUTINE_YIELDED   = 1u,   /* Ready to run again */
+    COROUTINE_DONE      = 2u,
+} en_coroutine_status_t;
+
+typedef struct stc_coroutine stc_coroutine_t;
+typedef en_coroutine_status_t (*coroutine_fn_t)(stc_coroutine_t *co);
+
+/* State of a coroutine: a few words, in static storage */
+struct stc_coroutine
+{
+    coroutine_fn_t  body;
+    uint32_t        resume;     /* Line to resume at, 0 at the start */
+    uint32_t        deadline;   /* Low-power timer ticks */
+    bool            timed;      /* The current wait has a deadline */
+};
+
+#define COROUTINE_INIT(body)        { (body), 0u, 0u, false }
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void coroutine_run(stc_coroutine_t *const coroutines[], uint32_t count);
+void coroutine_set_timeout(stc_coroutine_t *co, uint32_t ticks);
+bool coroutine_timed_out(const stc_coroutine_t *co);
+
+#endif /* SOURCE_COROUTINE_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,93 @@
+/*******************************************************************************
+* File Name:   crc16.c
+*
+* Description: This file implements the CRC-16/CCITT-FALSE checksum (polynomial
+*              0x1021, initial value 0xFFFF) with a 16-entry table, one nibble at
+*              a time. It uses no PDL calls, so it also builds on a host.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "crc16.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* CRC of each nibble value, shifted to the top of the register */
+static const uint16_t crc16_table[16] =
+{
+    0x0000u, 0x1021u, 0x2042u, 0x3063u, 0x4084u, 0x50A5u, 0x60C6u, 0x70E7u,
+    0x8108u, 0x9129u, 0xA14Au, 0xB16Bu, 0xC18Cu, 0xD1ADu, 0xE1CEu, 0xF1EFu
+};
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: crc16_update
+********************************************************************************
+* Summary:
+*  Adds 'size' bytes to a running CRC. Start with CRC16_INIT.
+*
+* Parameters:
+*  uint16_t crc     - CRC so far
+*  const void *data - bytes to add
+*  uint32_t size    - number of bytes
+*
+* Return:
+*  uint16_t - updated CRC
+*
+*******************************************************************************/
+uint16_t crc16_update(uint16_t crc, const void *data, uint32_t size)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    uint32_t i;
+
+    for (i = 0u; i < size; i++)
+    {
+        crc = (uint16_t)((crc << 4) ^ crc16_table[((crc >> 12) ^ (bytes[i] >> 4)) & 0x0Fu]);
+        crc = (uint16_t)((crc << 4) ^ crc16_table[((crc >> 12) ^ bytes[i]) & 0x0Fu]);
+    }
+
+    return crc;
+}
+
+/* [] END OF FILE */
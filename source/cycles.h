@@ -0,0 +1,96 @@
+/*******************************************************************************
+* File Name:   cycles.h
+*
+* Description: This file contains helpers for the Cortex-M33 DWT cycle counter
+*              used to measure execution time.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_CYCLES_H_
+#define SOURCE_CYCLES_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Convert CPU cycles to microseconds at the current core clock */
+#define CYCLES_TO_US(cycles)    ((uint32_t)(((uint64_t)(cycles) * 1000000u) / SystemCoreClock))
+
+/*******************************************************************************
+* Function Name: cycles_init
+********************************************************************************
+* Summary:
+*  Enables the DWT cycle counter. Safe to call more than once.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void cycles_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/*******************************************************************************
+* Function Name: cycles_now
+********************************************************************************
+* Summary:
+*  Returns the current cycle count. Wraps; use unsigned subtraction.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t - cycle count
+*
+*******************************************************************************/
+__STATIC_INLINE uint32_t cycles_now(void)
+{
+    return DWT->CYCCNT;
+}
+
+#endif /* SOURCE_CYCLES_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,579 @@
+/*******************************************************************************
+* File Name:   debug_uart.c
+*
+* Description: This file contains the power control of the debug UART. The
+*              SCB clock stays off and the pins stay GPIOs until the first byte
+*              is written. Output is then sent as usual; before DeepSleep or
+*              Hibernate the output drains and the UART is powered down again,
+*              so wakes that print nothing never start it.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "debug_uart.h"
+#include "cybsp.h"
+#include "cy_retarget_io.h"
+#include "cycles.h"
+#include "energy_model.h"
+#include "fmt.h"
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Clock divider of the debug UART: peri[0].group[4].div_8[0] in design.modus */
+#define DEBUG_UART_CLK_DST          (PCLK_SCB3_CLOCK_SCB_EN)
+#define DEBUG_UART_CLK_DIV_TYPE     (CY_SYSCLK_DIV_8_BIT)
+#define DEBUG_UART_CLK_DIV_NUM      (0u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Debug UART context */
+cy_stc_scb_uart_context_t  DEBUG_UART_context;
+/* Debug UART HAL object */
+mtb_hal_uart_t DEBUG_UART_hal_obj;
+
+static volatile bool uart_on = false;
+static bool uart_configured = false;
+static en_wake_source_t uart_wake = WAKE_SOURCE_NONE;
+static bool uart_wake_output = false;
+static stc_debug_uart_stats_t uart_stats;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void debug_uart_power_up(void);
+#if (0u != DEBUG_UART_LAZY)
+int __real__write(int fd, const char *ptr, int len);
+int __wrap__write(int fd, const char *ptr, int len);
+#endif
+static void debug_uart_put(void *context, const char *data, uint32_t size);
+#if (0u != DEBUG_UART_FMT)
+int __wrap_printf(const char *format, ...);
+int __wrap_vprintf(const char *format, va_list args);
+int __wrap_puts(const char *str);
+int __wrap_putchar(int c);
+#endif
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: debug_uart_init
+********************************************************************************
+* Summary:
+*  Puts the debug UART in its power-down state: TX holds the idle level as a
+*  GPIO and RX is a GPIO input whose falling edge is serviced by the shell.
+*  Without DEBUG_UART_LAZY, powers the UART at once.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void debug_uart_init(void)
+{
+    cycles_init();
+
+#if (0u != DEBUG_UART_LAZY)
+    Cy_GPIO_Write(CYBSP_DEBUG_UART_TX_PORT, CYBSP_DEBUG_UART_TX_PIN, 1u);
+    Cy_GPIO_SetHSIOM(CYBSP_DEBUG_UART_TX_PORT, CYBSP_DEBUG_UART_TX_PIN, HSIOM_SEL_GPIO);
+    Cy_GPIO_SetHSIOM(CYBSP_DEBUG_UART_RX_PORT, CYBSP_DEBUG_UART_RX_PIN, HSIOM_SEL_GPIO);
+    (void)Cy_SysClk_PeriPclkDisableDivider(DEBUG_UART_CLK_DST, DEBUG_UART_CLK_DIV_TYPE,
+                                           DEBUG_UART_CLK_DIV_NUM);
+#else
+    debug_uart_acquire();
+#endif
+}
+
+/*******************************************************************************
+* Function Name: debug_uart_begin_wake
+********************************************************************************
+* Summary:
+*  Starts the accounting of a wake: the boot, or a DeepSleep wakeup.
+*
+* Parameters:
+*  en_wake_source_t source - what woke the device; WAKE_SOURCE_NONE for a
+*                            cold boot
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void debug_uart_begin_wake(en_wake_source_t source)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    uart_wake = source;
+    uart_wake_output = uart_on;
+    uart_stats.wake[source].wakes++;
+    if (uart_on)
+    {
+        uart_stats.wake[source].outputs++;
+    }
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/*******************************************************************************
+* Function Name: debug_uart_acquire
+********************************************************************************
+* Summary:
+*  Powers the UART up if it is off. Called for every write, so it returns at
+*  once when the UART is on. Safe to call from interrupts.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void debug_uart_acquire(void)
+{
+    uint32_t interrupt_state;
+    uint32_t start;
+    uint32_t cycles;
+
+    if (uart_on)
+    {
+        return;
+    }
+
+    interrupt_state = Cy_SysLib_EnterCriticalSection();
+    if (!uart_on)
+    {
+        start = cycles_now();
+        debug_uart_power_up();
+        cycles = cycles_now() - start;
+
+        uart_on = true;
+        uart_stats.bringups++;
+        uart_stats.bringup_cycles += cycles;
+        if (cycles > uart_stats.max_bringup_cycles)
+        {
+            uart_stats.max_bringup_cycles = cycles;
+        }
+        if (!uart_wake_output)
+        {
+            uart_wake_output = true;
+            uart_stats.wake[uart_wake].outputs++;
+        }
+    }
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/*******************************************************************************
+* Function Name: debug_uart_write
+********************************************************************************
+* Summary:
+*  Writes bytes with Cy_SCB_UART_PutArrayBlocking(), powering the UART up
+*  first. It copies into the TX FIFO of the SCB and waits while the FIFO is
+*  full; there is no software TX buffer.
+*
+* Parameters:
+*  const char *data - bytes to write
+*  uint32_t size    - number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void debug_uart_write(const char *data, uint32_t size)
+{
+    debug_uart_acquire();
+    Cy_SCB_UART_PutArrayBlocking(DEBUG_UART_HW, (void *)data, size);
+}
+
+/*******************************************************************************
+* Function Name: debug_uart_vprintf
+********************************************************************************
+* Summary:
+*  Formats with the integer-only formatter (source/fmt.c) and writes each run
+*  of output to the UART as it is produced, without stdio buffering or heap.
+*
+* Parameters:
+*  const char *format - printf format
+*  va_list args       - arguments
+*
+* Return:
+*  int - characters written
+*
+*******************************************************************************/
+int debug_uart_vprintf(const char *format, va_list args)
+{
+    return fmt_vformat(debug_uart_put, NULL, format, args);
+}
+
+/*******************************************************************************
+* Function Name: debug_uart_release
+********************************************************************************
+* Summary:
+*  Powers the UART down once its output has been sent. Call before DeepSleep
+*  or Hibernate, after letting the output drain with the CPU asleep (see
+*  co_uart_drain in main.c); the release does not wait. The RX pin edge is
+*  left armed so that typing powers the UART up again. Does nothing without
+*  DEBUG_UART_LAZY.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - false if output is still being sent and the UART stays on
+*
+*******************************************************************************/
+bool debug_uart_release(void)
+{
+#if (0u != DEBUG_UART_LAZY)
+    uint32_t interrupt_state;
+
+    if (!uart_on)
+    {
+        return true;
+    }
+    if (!Cy_SCB_UART_IsTxComplete(DEBUG_UART_HW))
+    {
+        return false;
+    }
+
+    interrupt_state = Cy_SysLib_EnterCriticalSection();
+    Cy_SCB_UART_Disable(DEBUG_UART_HW, &DEBUG_UART_context);
+    Cy_GPIO_Write(CYBSP_DEBUG_UART_TX_PORT, CYBSP_DEBUG_UART_TX_PIN, 1u);
+    Cy_GPIO_SetHSIOM(CYBSP_DEBUG_UART_TX_PORT, CYBSP_DEBUG_UART_TX_PIN, HSIOM_SEL_GPIO);
+    Cy_GPIO_SetHSIOM(CYBSP_DEBUG_UART_RX_PORT, CYBSP_DEBUG_UART_RX_PIN, HSIOM_SEL_GPIO);
+    (void)Cy_SysClk_PeriPclkDisableDivider(DEBUG_UART_CLK_DST, DEBUG_UART_CLK_DIV_TYPE,
+                                           DEBUG_UART_CLK_DIV_NUM);
+    uart_on = false;
+
+    Cy_GPIO_ClearInterrupt(CYBSP_DEBUG_UART_RX_PORT, CYBSP_DEBUG_UART_RX_PIN);
+    Cy_GPIO_SetInterruptMask(CYBSP_DEBUG_UART_RX_PORT, CYBSP_DEBUG_UART_RX_PIN, 1u);
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+#endif
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: debug_uart_is_on
+********************************************************************************
+* Summary:
+*  Returns whether the UART is powered.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - true if powered
+*
+*******************************************************************************/
+bool debug_uart_is_on(void)
+{
+    return uart_on;
+}
+
+/*******************************************************************************
+* Function Name: debug_uart_get_stats
+********************************************************************************
+* Summary:
+*  Copies the power-up statistics.
+*
+* Parameters:
+*  stc_debug_uart_stats_t *stats - destination
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void debug_uart_get_stats(stc_debug_uart_stats_t *stats)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    *stats = uart_stats;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/*******************************************************************************
+* Function Name: debug_uart_print_stats
+********************************************************************************
+* Summary:
+*  Prints, per wake type, the wakes that powered the UART and the charge saved
+*  by the others: one power-up of average length in Active mode each.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void debug_uart_print_stats(void)
+{
+    static const char *const wake_names[WAKE_SOURCE_COUNT] = { "boot", "alarm", "uart", "button" };
+    stc_debug_uart_stats_t stats;
+    uint32_t bringup_us = 0u;
+    uint32_t silent;
+    uint32_t i;
+
+    debug_uart_get_stats(&stats);
+    if (0u != stats.bringups)
+    {
+        bringup_us = CYCLES_TO_US(stats.bringup_cycles / stats.bringups);
+    }
+
+    printf("UART: %s, %lu power-ups of %lu us (max %lu cycles)\r\n",
+           (0u != DEBUG_UART_LAZY) ? "lazy" : "always on", (unsigned long)stats.bringups,
+           (unsigned long)bringup_us, (unsigned long)stats.max_bringup_cycles);
+    for (i = 0u; i < (uint32_t)WAKE_SOURCE_COUNT; i++)
+    {
+        if (0u == stats.wake[i].wakes)
+        {
+            continue;
+        }
+        silent = stats.wake[i].wakes - stats.wake[i].outputs;
+        printf("UART: %-6s %lu wakes, %lu with output, %lu silent, saved %lu nC\r\n",
+               wake_names[i], (unsigned long)stats.wake[i].wakes,
+               (unsigned long)stats.wake[i].outputs, (unsigned long)silent,
+               (unsigned long)(silent * ENERGY_CHARGE_NC(ENERGY_ACTIVE_UA, bringup_us)));
+    }
+}
+
+/*******************************************************************************
+* Function Name: debug_uart_power_up
+********************************************************************************
+* Summary:
+*  Clocks the SCB and hands the pins back to it. The first power-up also
+*  initializes the SCB, the HAL object and retarget-io; the SCB keeps its
+*  configuration while disabled, so later power-ups only enable it.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void debug_uart_power_up(void)
+{
+    cy_rslt_t result;
+
+    (void)Cy_SysClk_PeriPclkEnableDivider(DEBUG_UART_CLK_DST, DEBUG_UART_CLK_DIV_TYPE,
+                                          DEBUG_UART_CLK_DIV_NUM);
+    Cy_GPIO_SetInterruptMask(CYBSP_DEBUG_UART_RX_PORT, CYBSP_DEBUG_UART_RX_PIN, 0u);
+    Cy_GPIO_SetHSIOM(CYBSP_DEBUG_UART_TX_PORT, CYBSP_DEBUG_UART_TX_PIN, CYBSP_DEBUG_UART_TX_HSIOM);
+    Cy_GPIO_SetHSIOM(CYBSP_DEBUG_UART_RX_PORT, CYBSP_DEBUG_UART_RX_PIN, CYBSP_DEBUG_UART_RX_HSIOM);
+
+    if (!uart_configured)
+    {
+        result = Cy_SCB_UART_Init(DEBUG_UART_HW, &DEBUG_UART_config, &DEBUG_UART_context);
+        if (result != CY_RSLT_SUCCESS)
+        {
+            CY_ASSERT(0);
+        }
+        Cy_SCB_UART_Enable(DEBUG_UART_HW);
+
+        /* Initialize HAL UART */
+        result = mtb_hal_uart_setup(&DEBUG_UART_hal_obj, &DEBUG_UART_hal_config, &DEBUG_UART_context, NULL);
+        if (result != CY_RSLT_SUCCESS)
+        {
+            CY_ASSERT(0);
+        }
+
+        /* Initialize retarget-io to use the debug UART port */
+        result = cy_retarget_io_init(&DEBUG_UART_hal_obj);
+        if (result != CY_RSLT_SUCCESS)
+        {
+            CY_ASSERT(0);
+        }
+        uart_configured = true;
+    }
+    else
+    {
+        Cy_SCB_UART_Enable(DEBUG_UART_HW);
+    }
+
+    /* The shell receives through the RX FIFO interrupt */
+    Cy_SCB_ClearRxInterrupt(DEBUG_UART_HW, CY_SCB_RX_INTR_NOT_EMPTY);
+    Cy_SCB_SetRxInterruptMask(DEBUG_UART_HW, CY_SCB_RX_INTR_NOT_EMPTY);
+}
+
+#if (0u != DEBUG_UART_LAZY)
+/*******************************************************************************
+* Function Name: __wrap__write
+********************************************************************************
+* Summary:
+*  Wraps the _write of retarget-io (linker option --wrap=_write): powers the
+*  UART up before the first byte of any output.
+*
+* Parameters:
+*  int fd          - file descriptor
+*  const char *ptr - bytes to write
+*  int len         - number of bytes
+*
+* Return:
+*  int - bytes written, from retarget-io
+*
+*******************************************************************************/
+int __wrap__write(int fd, const char *ptr, int len)
+{
+    debug_uart_acquire();
+    return __real__write(fd, ptr, len);
+}
+#endif
+
+/*******************************************************************************
+* Function Name: debug_uart_put
+********************************************************************************
+* Summary:
+*  Output of the formatter: writes a run of characters to the UART.
+*
+* Parameters:
+*  void *context    - unused
+*  const char *data - characters
+*  uint32_t size    - number of characters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void debug_uart_put(void *context, const char *data, uint32_t size)
+{
+    (void)context;
+    debug_uart_write(data, size);
+}
+
+#if (0u != DEBUG_UART_FMT)
+/*******************************************************************************
+* Function Name: __wrap_printf
+********************************************************************************
+* Summary:
+*  Replaces newlib's printf (linker option --wrap=printf), so that its
+*  formatter is not linked.
+*
+* Parameters:
+*  const char *format - printf format
+*  ...                - arguments
+*
+* Return:
+*  int - characters written
+*
+*******************************************************************************/
+int __wrap_printf(const char *format, ...)
+{
+    va_list args;
+    int count;
+
+    va_start(args, format);
+    count = debug_uart_vprintf(format, args);
+    va_end(args);
+
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: __wrap_vprintf
+********************************************************************************
+* Summary:
+*  Replaces newlib's vprintf (linker option --wrap=vprintf).
+*
+* Parameters:
+*  const char *format - printf format
+*  va_list args       - arguments
+*
+* Return:
+*  int - characters written
+*
+*******************************************************************************/
+int __wrap_vprintf(const char *format, va_list args)
+{
+    return debug_uart_vprintf(format, args);
+}
+
+/*******************************************************************************
+* Function Name: __wrap_puts
+********************************************************************************
+* Summary:
+*  Replaces newlib's puts (linker option --wrap=puts). GCC turns a printf of
+*  a constant string that ends in a newline into puts.
+*
+* Parameters:
+*  const char *str - line, without the newline
+*
+* Return:
+*  int - non-negative
+*
+*******************************************************************************/
+int __wrap_puts(const char *str)
+{
+    debug_uart_write(str, (uint32_t)strlen(str));
+    debug_uart_write("\n", 1u);
+
+    return 1;
+}
+
+/*******************************************************************************
+* Function Name: __wrap_putchar
+********************************************************************************
+* Summary:
+*  Replaces newlib's putchar (linker option --wrap=putchar). GCC turns a
+*  printf of a single character into putchar.
+*
+* Parameters:
+*  int c - character
+*
+* Return:
+*  int - the character
+*
+*******************************************************************************/
+int __wrap_putchar(int c)
+{
+    char ch = (char)c;
+
+    debug_uart_write(&ch, 1u);
+
+    return (int)(unsigned char)ch;
+}
+#endif
+
+/* [] END OF FILE */
@@ -0,0 +1,102 @@
+/*******************************************************************************
+* File Name:   debug_uart.h
+*
+* Description: This file contains the interface of the lazily powered debug
+*              UART.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_DEBUG_UART_H_
+#define SOURCE_DEBUG_UART_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdarg.h>
+#include "cy_pdl.h"
+#include "wake_source.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* 1: the UART is powered on the first byte written and off before sleep.
+   Needs the _write hook set up by the Makefile (GCC_ARM); else the UART is
+   powered at boot and stays on. */
+#ifndef DEBUG_UART_LAZY
+#define DEBUG_UART_LAZY             (0u)
+#endif
+
+/* 1: printf, vprintf, puts and putchar go to debug_uart_vprintf and
+   debug_uart_write, and newlib's formatter is not linked. Needs the --wrap
+   options set up by the Makefile (GCC_ARM). */
+#ifndef DEBUG_UART_FMT
+#define DEBUG_UART_FMT              (0u)
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t    wakes;          /* Wakes of this type */
+    uint32_t    outputs;        /* Of them, wakes that powered the UART */
+} stc_debug_uart_wake_stats_t;
+
+typedef struct
+{
+    stc_debug_uart_wake_stats_t wake[WAKE_SOURCE_COUNT];    /* NONE: cold boot */
+    uint32_t    bringups;           /* UART power-ups */
+    uint32_t    bringup_cycles;     /* Total time of the power-ups */
+    uint32_t    max_bringup_cycles;
+} stc_debug_uart_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void debug_uart_init(void);
+void debug_uart_begin_wake(en_wake_source_t source);
+void debug_uart_acquire(void);
+bool debug_uart_release(void);
+void debug_uart_write(const char *data, uint32_t size);
+int debug_uart_vprintf(const char *format, va_list args);
+bool debug_uart_is_on(void);
+void debug_uart_get_stats(stc_debug_uart_stats_t *stats);
+void debug_uart_print_stats(void);
+
+#endif /* SOURCE_DEBUG_UART_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,430 @@
+/*******************************************************************************
+* File Name:   dsp.c
+*
+* Description: This file implements the batch processing kernels. On cores with
+*              the DSP extension (Cortex-M33) the inner loops use the dual 16-bit
+*              SIMD instructions through the CMSIS intrinsics; the scalar versions
+*              give the same results, build on a host, and serve as reference.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "dsp.h"
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#include "cmsis_compiler.h"
+#define DSP_SIMD                    (1u)
+#else
+#define DSP_SIMD                    (0u)
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define DSP_Q15_ROUND               (1L << 14)
+#define DSP_Q15_SHIFT               (15u)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static inline int16_t dsp_saturate16(int32_t value);
+static void dsp_count_crossings(stc_dsp_features_t *features, const int16_t *x, uint32_t n,
+                                int16_t threshold);
+#if (1u == DSP_SIMD)
+static inline uint32_t dsp_load_pair(const int16_t *x);
+#endif
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: dsp_features_reset
+********************************************************************************
+* Summary:
+*  Clears the accumulated features.
+*
+* Parameters:
+*  stc_dsp_features_t *features - features to clear
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void dsp_features_reset(stc_dsp_features_t *features)
+{
+    memset(features, 0, sizeof(*features));
+    features->min = INT16_MAX;
+    features->max = INT16_MIN;
+}
+
+/*******************************************************************************
+* Function Name: dsp_features_update
+********************************************************************************
+* Summary:
+*  Adds a block to the features. Sum, sum of squares and min/max take two
+*  samples per instruction with SMLAD, SMLALD and SSUB16/SEL.
+*
+* Parameters:
+*  stc_dsp_features_t *features - accumulated features
+*  const int16_t *x             - samples
+*  uint32_t n                   - number of samples
+*  int16_t threshold            - level whose rising crossings are counted
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void dsp_features_update(stc_dsp_features_t *features, const int16_t *x, uint32_t n,
+                         int16_t threshold)
+{
+#if (1u == DSP_SIMD)
+    uint32_t vmin = ((uint32_t)(uint16_t)features->min << 16) | (uint16_t)features->min;
+    uint32_t vmax = ((uint32_t)(uint16_t)features->max << 16) | (uint16_t)features->max;
+    uint64_t sum_sq = 0u;
+    int32_t sum = 0;
+    uint32_t pair;
+    uint32_t i;
+    int16_t lo, hi;
+
+    if (0u == n)
+    {
+        return;
+    }
+
+    for (i = 0u; (i + 1u) < n; i += 2u)
+    {
+        pair = dsp_load_pair(&x[i]);
+        sum = (int32_t)__SMLAD(pair, 0x00010001uL, (uint32_t)sum);
+        sum_sq = __SMLALD(pair, pair, sum_sq);
+        (void)__SSUB16(pair, vmin);
+        vmin = __SEL(vmin, pair);
+        (void)__SSUB16(pair, vmax);
+        vmax = __SEL(pair, vmax);
+    }
+    if (i < n)
+    {
+        sum += x[i];
+        sum_sq += (uint64_t)((int32_t)x[i] * (int32_t)x[i]);
+        pair = ((uint32_t)(uint16_t)x[i] << 16) | (uint16_t)x[i];
+        (void)__SSUB16(pair, vmin);
+        vmin = __SEL(vmin, pair);
+        (void)__SSUB16(pair, vmax);
+        vmax = __SEL(pair, vmax);
+    }
+
+    lo = (int16_t)(vmin & 0xFFFFu);
+    hi = (int16_t)(vmin >> 16);
+    features->min = (lo < hi) ? lo : hi;
+    lo = (int16_t)(vmax & 0xFFFFu);
+    hi = (int16_t)(vmax >> 16);
+    features->max = (lo > hi) ? lo : hi;
+    features->sum += sum;
+    features->sum_sq += sum_sq;
+
+    dsp_count_crossings(features, x, n, threshold);
+#else
+    dsp_features_update_scalar(features, x, n, threshold);
+#endif
+}
+
+/*******************************************************************************
+* Function Name: dsp_features_update_scalar
+********************************************************************************
+* Summary:
+*  Portable version of dsp_features_update().
+*
+* Parameters:
+*  stc_dsp_features_t *features - accumulated features
+*  const int16_t *x             - samples
+*  uint32_t n                   - number of samples
+*  int16_t threshold            - level whose rising crossings are counted
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void dsp_features_update_scalar(stc_dsp_features_t *features, const int16_t *x, uint32_t n,
+                                int16_t threshold)
+{
+    uint32_t i;
+
+    if (0u == n)
+    {
+        return;
+    }
+
+    for (i = 0u; i < n; i++)
+    {
+        features->sum += x[i];
+        features->sum_sq += (uint64_t)((int32_t)x[i] * (int32_t)x[i]);
+        features->min = (x[i] < features->min) ? x[i] : features->min;
+        features->max = (x[i] > features->max) ? x[i] : features->max;
+    }
+
+    dsp_count_crossings(features, x, n, threshold);
+}
+
+/*******************************************************************************
+* Function Name: dsp_features_mean
+********************************************************************************
+* Summary:
+*  Returns the mean of the accumulated samples, rounded toward zero.
+*
+* Parameters:
+*  const stc_dsp_features_t *features - accumulated features
+*
+* Return:
+*  int32_t - mean, 0 without samples
+*
+*******************************************************************************/
+int32_t dsp_features_mean(const stc_dsp_features_t *features)
+{
+    return (0u == features->count) ? 0 : (int32_t)(features->sum / (int64_t)features->count);
+}
+
+/*******************************************************************************
+* Function Name: dsp_features_rms
+********************************************************************************
+* Summary:
+*  Returns the root mean square of the accumulated samples, by an integer
+*  square root of the mean square.
+*
+* Parameters:
+*  const stc_dsp_features_t *features - accumulated features
+*
+* Return:
+*  uint32_t - RMS, rounded down; 0 without samples
+*
+*******************************************************************************/
+uint32_t dsp_features_rms(const stc_dsp_features_t *features)
+{
+    uint32_t mean_sq, root = 0u, bit = 1uL << 30;
+
+    if (0u == features->count)
+    {
+        return 0u;
+    }
+
+    /* The mean square of int16_t samples fits 30 bits */
+    mean_sq = (uint32_t)(features->sum_sq / features->count);
+    while (bit > mean_sq)
+    {
+        bit >>= 2;
+    }
+    while (0u != bit)
+    {
+        if (mean_sq >= (root + bit))
+        {
+            mean_sq -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return root;
+}
+
+/*******************************************************************************
+* Function Name: dsp_fir
+********************************************************************************
+* Summary:
+*  FIR filter with Q15 coefficients. y[i] is the sum of coeffs[k] * x[i - k]
+*  for k < taps, rounded and saturated. x[-taps + 1] to x[-1] must hold the
+*  previous samples. Pairs of taps run with one SMLAD each.
+*
+* Parameters:
+*  const int16_t *x      - input, preceded by taps - 1 samples of history
+*  int16_t *y            - output, n samples
+*  uint32_t n            - number of samples
+*  const int16_t *coeffs - Q15 coefficients
+*  uint32_t taps         - number of coefficients, up to DSP_FIR_MAX_TAPS
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void dsp_fir(const int16_t *x, int16_t *y, uint32_t n, const int16_t *coeffs, uint32_t taps)
+{
+#if (1u == DSP_SIMD)
+    int16_t reversed[DSP_FIR_MAX_TAPS];
+    const int16_t *window;
+    int32_t acc;
+    uint32_t i, k;
+
+    /* Reverse the taps so that both operands are read in ascending order */
+    for (k = 0u; k < taps; k++)
+    {
+        reversed[k] = coeffs[taps - 1u - k];
+    }
+
+    for (i = 0u; i < n; i++)
+    {
+        window = &x[(int32_t)i - (int32_t)(taps - 1u)];
+        acc = DSP_Q15_ROUND;
+        for (k = 0u; (k + 1u) < taps; k += 2u)
+        {
+            acc = (int32_t)__SMLAD(dsp_load_pair(&reversed[k]), dsp_load_pair(&window[k]), (uint32_t)acc);
+        }
+        if (k < taps)
+        {
+            acc += (int32_t)reversed[k] * (int32_t)window[k];
+        }
+        y[i] = (int16_t)__SSAT(acc >> DSP_Q15_SHIFT, 16);
+    }
+#else
+    dsp_fir_scalar(x, y, n, coeffs, taps);
+#endif
+}
+
+/*******************************************************************************
+* Function Name: dsp_fir_scalar
+********************************************************************************
+* Summary:
+*  Portable version of dsp_fir().
+*
+* Parameters:
+*  const int16_t *x      - input, preceded by taps - 1 samples of history
+*  int16_t *y            - output, n samples
+*  uint32_t n            - number of samples
+*  const int16_t *coeffs - Q15 coefficients
+*  uint32_t taps         - number of coefficients, up to DSP_FIR_MAX_TAPS
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void dsp_fir_scalar(const int16_t *x, int16_t *y, uint32_t n, const int16_t *coeffs,
+                    uint32_t taps)
+{
+    int32_t acc;
+    uint32_t i, k;
+
+    for (i = 0u; i < n; i++)
+    {
+        acc = DSP_Q15_ROUND;
+        for (k = 0u; k < taps; k++)
+        {
+            acc += (int32_t)coeffs[k] * (int32_t)x[(int32_t)i - (int32_t)k];
+        }
+        y[i] = dsp_saturate16(acc >> DSP_Q15_SHIFT);
+    }
+}
+
+/*******************************************************************************
+* Function Name: dsp_saturate16
+********************************************************************************
+* Summary:
+*  Clamps a value to the int16_t range.
+*
+* Parameters:
+*  int32_t value - value to clamp
+*
+* Return:
+*  int16_t - clamped value
+*
+*******************************************************************************/
+static inline int16_t dsp_saturate16(int32_t value)
+{
+    return (int16_t)((value > INT16_MAX) ? INT16_MAX : ((value < INT16_MIN) ? INT16_MIN : value));
+}
+
+/*******************************************************************************
+* Function Name: dsp_count_crossings
+********************************************************************************
+* Summary:
+*  Counts the rising crossings of 'threshold', including the one between the
+*  previous block and this one, and updates the sample count.
+*
+* Parameters:
+*  stc_dsp_features_t *features - accumulated features
+*  const int16_t *x             - samples
+*  uint32_t n                   - number of samples, at least 1
+*  int16_t threshold            - crossing level
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void dsp_count_crossings(stc_dsp_features_t *features, const int16_t *x, uint32_t n,
+                                int16_t threshold)
+{
+    int16_t prev = (0u == features->count) ? x[0] : features->last;
+    uint32_t i;
+
+    for (i = 0u; i < n; i++)
+    {
+        features->crossings += ((prev < threshold) && (x[i] >= threshold)) ? 1u : 0u;
+        prev = x[i];
+    }
+    features->last = prev;
+    features->count += n;
+}
+
+#if (1u == DSP_SIMD)
+/*******************************************************************************
+* Function Name: dsp_load_pair
+********************************************************************************
+* Summary:
+*  Loads two adjacent samples as one word; x[0] in the low half. The
+*  Cortex-M33 allows the unaligned access.
+*
+* Parameters:
+*  const int16_t *x - first sample
+*
+* Return:
+*  uint32_t - packed pair
+*
+*******************************************************************************/
+static inline uint32_t dsp_load_pair(const int16_t *x)
+{
+    uint32_t pair;
+
+    memcpy(&pair, x, sizeof(pair));
+    return pair;
+}
+#endif
+
+/* [] END OF FILE */
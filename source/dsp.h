@@ -0,0 +1,87 @@
+/*******************************************************************************
+* File Name:   dsp.h
+*
+* Description: This file contains the interface of the batch processing kernels:
+*              FIR filter, and mean, RMS, min/max and threshold crossing features.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_DSP_H_
+#define SOURCE_DSP_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define DSP_FIR_MAX_TAPS            (32u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Features accumulated over any number of blocks */
+typedef struct
+{
+    uint32_t count;
+    int64_t  sum;
+    uint64_t sum_sq;
+    int16_t  min;
+    int16_t  max;
+    int16_t  last;              /* Last sample, for crossings across blocks */
+    uint32_t crossings;         /* Rising crossings of the threshold */
+} stc_dsp_features_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void dsp_features_reset(stc_dsp_features_t *features);
+void dsp_features_update(stc_dsp_features_t *features, const int16_t *x, uint32_t n,
+                         int16_t threshold);
+void dsp_features_update_scalar(stc_dsp_features_t *features, const int16_t *x, uint32_t n,
+                                int16_t threshold);
+int32_t dsp_features_mean(const stc_dsp_features_t *features);
+uint32_t dsp_features_rms(const stc_dsp_features_t *features);
+void dsp_fir(const int16_t *x, int16_t *y, uint32_t n, const int16_t *coeffs, uint32_t taps);
+void dsp_fir_scalar(const int16_t *x, int16_t *y, uint32_t n, const int16_t *coeffs,
+                    uint32_t taps);
+
+#endif /* SOURCE_DSP_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,232 @@
+/*******************************************************************************
+* File Name:   dst.c
+*
+* Description: This file contains the daylight saving time transition table.
+*              The RTC keeps standard time, so it never jumps. The transitions
+*              of the next DST_YEARS years are computed once, as RTC seconds
+*              since 2000-01-01 in standard time. A wake then only compares the
+*              time with the next entry to know the local time offset.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "dst.h"
+#include "calendar.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define DST_TRANSITIONS         (2u * DST_YEARS)
+
+/* The stop hour is daylight time: the transition is DST_OFFSET_S earlier in
+   standard time */
+_Static_assert((DST_STOP_HOUR * 3600u) >= DST_OFFSET_S, "DST stop before midnight standard time");
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Start and stop of each year in turn: an odd index of the next transition
+   means that DST is active */
+static uint32_t dst_table[DST_TRANSITIONS];
+static uint32_t dst_next = 0u;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint32_t dst_transition(int32_t year, uint32_t month, uint32_t hour);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: dst_init
+********************************************************************************
+* Summary:
+*  Computes the transitions of DST_YEARS years, starting with the year of
+*  'rtc_s', and finds the next one. Call it again when the RTC is set.
+*
+* Parameters:
+*  uint32_t rtc_s - current RTC time, seconds since 2000-01-01
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void dst_init(uint32_t rtc_s)
+{
+    int32_t year;
+    uint32_t month;
+    uint32_t day;
+    uint32_t i;
+
+    calendar_civil_from_days((int32_t)((CALENDAR_EPOCH_RTC_BASE / CALENDAR_SECONDS_PER_DAY) +
+                                       (rtc_s / CALENDAR_SECONDS_PER_DAY)), &year, &month, &day);
+    for (i = 0u; i < DST_YEARS; i++)
+    {
+        dst_table[2u * i] = dst_transition(year + (int32_t)i, DST_START_MONTH, DST_START_HOUR);
+        dst_table[(2u * i) + 1u] = dst_transition(year + (int32_t)i, DST_STOP_MONTH, DST_STOP_HOUR) - DST_OFFSET_S;
+    }
+
+    dst_next = 0u;
+    (void)dst_update(rtc_s);
+}
+
+/*******************************************************************************
+* Function Name: dst_update
+********************************************************************************
+* Summary:
+*  Moves past the transitions reached by 'rtc_s'. Called on each wake, it
+*  compares with one table entry. The table is recomputed when it runs out.
+*
+* Parameters:
+*  uint32_t rtc_s - current RTC time, seconds since 2000-01-01
+*
+* Return:
+*  bool - true if the local time offset changed
+*
+*******************************************************************************/
+bool dst_update(uint32_t rtc_s)
+{
+    uint32_t offset = dst_offset();
+
+    while ((dst_next < DST_TRANSITIONS) && (rtc_s >= dst_table[dst_next]))
+    {
+        dst_next++;
+    }
+    if (DST_TRANSITIONS == dst_next)
+    {
+        dst_init(rtc_s);
+    }
+    return (offset != dst_offset());
+}
+
+/*******************************************************************************
+* Function Name: dst_offset
+********************************************************************************
+* Summary:
+*  Returns the local time offset at the last dst_update().
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t - DST_OFFSET_S during DST, else 0
+*
+*******************************************************************************/
+uint32_t dst_offset(void)
+{
+    return (0u != (dst_next & 1u)) ? DST_OFFSET_S : 0u;
+}
+
+/*******************************************************************************
+* Function Name: dst_offset_at
+********************************************************************************
+* Summary:
+*  Returns the local time offset at a later time, such as the next alarm,
+*  without moving the table position. Looks at most at two entries.
+*
+* Parameters:
+*  uint32_t rtc_s - RTC time, seconds since 2000-01-01
+*
+* Return:
+*  uint32_t - DST_OFFSET_S during DST, else 0
+*
+*******************************************************************************/
+uint32_t dst_offset_at(uint32_t rtc_s)
+{
+    uint32_t next = dst_next;
+
+    while ((next < DST_TRANSITIONS) && (rtc_s >= dst_table[next]) && (next < (dst_next + 2u)))
+    {
+        next++;
+    }
+    return (0u != (next & 1u)) ? DST_OFFSET_S : 0u;
+}
+
+/*******************************************************************************
+* Function Name: dst_next_transition
+********************************************************************************
+* Summary:
+*  Returns the time of the next transition.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t - RTC seconds since 2000-01-01, in standard time
+*
+*******************************************************************************/
+uint32_t dst_next_transition(void)
+{
+    return dst_table[dst_next];
+}
+
+/*******************************************************************************
+* Function Name: dst_transition
+********************************************************************************
+* Summary:
+*  Computes the time of a transition: the last DST_DAY_OF_WEEK of a month at
+*  an hour of standard time.
+*
+* Parameters:
+*  int32_t year   - full year
+*  uint32_t month - month of the transition
+*  uint32_t hour  - hour of standard time
+*
+* Return:
+*  uint32_t - RTC seconds since 2000-01-01
+*
+*******************************************************************************/
+static uint32_t dst_transition(int32_t year, uint32_t month, uint32_t hour)
+{
+    int32_t last;
+    int32_t rtc_days;
+
+    /* Last day of the month, then back to the day of the week */
+    last = (CY_RTC_DECEMBER == month) ? (calendar_days_from_civil(year + 1, CY_RTC_JANUARY, 1u) - 1)
+                                      : (calendar_days_from_civil(year, month + 1u, 1u) - 1);
+    last -= (int32_t)((calendar_day_of_week(last) + 7u - DST_DAY_OF_WEEK) % 7u);
+    rtc_days = last - (int32_t)(CALENDAR_EPOCH_RTC_BASE / CALENDAR_SECONDS_PER_DAY);
+
+    return ((uint32_t)rtc_days * CALENDAR_SECONDS_PER_DAY) + (hour * 3600u);
+}
+
+/* [] END OF FILE */
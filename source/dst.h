@@ -0,0 +1,80 @@
+/*******************************************************************************
+* File Name:   dst.h
+*
+* Description: This file contains the interface of the daylight saving time
+*              transition table.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_DST_H_
+#define SOURCE_DST_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Daylight saving time rule: starts and stops on the last DST_DAY_OF_WEEK of
+   a month, at the local hour the clocks change. These are the dstStart* and
+   dstStop* parameters of USER_RTC in design.modus, with the same values: keep
+   the two in step. The RTC keeps standard time, so its hardware DST ('dst')
+   stays disabled. The defaults are the EU rule for Central European Time. */
+#define DST_START_MONTH         (CY_RTC_MARCH)
+#define DST_START_HOUR          (2u)        /* 02:00 standard time to 03:00 */
+#define DST_STOP_MONTH          (CY_RTC_OCTOBER)
+#define DST_STOP_HOUR           (3u)        /* 03:00 daylight time to 02:00 */
+#define DST_DAY_OF_WEEK         (CY_RTC_SUNDAY)
+#define DST_OFFSET_S            (3600u)
+
+/* Years of transitions precomputed from the current RTC year */
+#define DST_YEARS               (16u)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void dst_init(uint32_t rtc_s);
+bool dst_update(uint32_t rtc_s);
+uint32_t dst_offset(void);
+uint32_t dst_offset_at(uint32_t rtc_s);
+uint32_t dst_next_transition(void);
+
+#endif /* SOURCE_DST_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,235 @@
+/*******************************************************************************
+* File Name:   energy_bucket.c
+*
+* Description: This file contains the token bucket of the daily energy budget.
+*              It is refilled at the budgeted average current, drained by the charge
+*              spent, and maps its fill level to a degradation level. It uses no PDL,
+*              so that tests/energy_bucket_test.c runs it on a host.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "energy_bucket.h"
+#include "energy_model.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define ENERGY_US_PER_S             (1000000u)
+
+/* Packed bucket: valid flag, level, and the fill as a binary fraction */
+#define ENERGY_PACK_VALID           (0x80000000u)
+#define ENERGY_PACK_LEVEL_POS       (28u)
+#define ENERGY_PACK_LEVEL_MASK      (0x3u)
+#define ENERGY_PACK_FILL_BITS       (24u)
+#define ENERGY_PACK_FILL_ONE        (1u << ENERGY_PACK_FILL_BITS)
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: energy_bucket_init
+********************************************************************************
+* Summary:
+*  Sets up a full bucket at the normal level.
+*
+* Parameters:
+*  stc_energy_bucket_t *bucket - bucket
+*  uint32_t uah_per_day        - daily budget
+*  uint32_t burst_s            - capacity, in seconds of budget
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void energy_bucket_init(stc_energy_bucket_t *bucket, uint32_t uah_per_day, uint32_t burst_s)
+{
+    bucket->refill_na = (uint32_t)(((uint64_t)uah_per_day * ENERGY_NC_PER_UAH) / ENERGY_SECONDS_PER_DAY);
+    bucket->capacity_nc = (uint64_t)bucket->refill_na * burst_s;
+    bucket->tokens_nc = bucket->capacity_nc;
+    bucket->level = ENERGY_LEVEL_NORMAL;
+}
+
+/*******************************************************************************
+* Function Name: energy_bucket_step
+********************************************************************************
+* Summary:
+*  Adds the budget of the elapsed time, up to the capacity, takes the charge
+*  spent, down to empty, and moves the level. A level drops below its fill
+*  threshold and rises only ENERGY_BUDGET_HYSTERESIS_PCT above it, so the
+*  effect of a level change does not flip it straight back.
+*
+* Parameters:
+*  stc_energy_bucket_t *bucket - bucket
+*  uint64_t elapsed_us         - time since the previous step
+*  uint64_t spent_nc           - charge drawn in that time
+*
+* Return:
+*  bool - true if the level changed
+*
+*******************************************************************************/
+bool energy_bucket_step(stc_energy_bucket_t *bucket, uint64_t elapsed_us, uint64_t spent_nc)
+{
+    en_energy_level_t level = bucket->level;
+    uint32_t fill_pct;
+
+    bucket->tokens_nc += ((uint64_t)bucket->refill_na * elapsed_us) / ENERGY_US_PER_S;
+    if (bucket->tokens_nc > bucket->capacity_nc)
+    {
+        bucket->tokens_nc = bucket->capacity_nc;
+    }
+    bucket->tokens_nc = (spent_nc < bucket->tokens_nc) ? (bucket->tokens_nc - spent_nc) : 0u;
+
+    fill_pct = energy_bucket_fill_pct(bucket);
+    if (fill_pct < ENERGY_BUDGET_CRITICAL_PCT)
+    {
+        level = ENERGY_LEVEL_CRITICAL;
+    }
+    else if (fill_pct < ENERGY_BUDGET_SAVE_PCT)
+    {
+        if ((ENERGY_LEVEL_NORMAL == level) ||
+            (fill_pct >= (ENERGY_BUDGET_CRITICAL_PCT + ENERGY_BUDGET_HYSTERESIS_PCT)))
+        {
+            level = ENERGY_LEVEL_SAVE;
+        }
+    }
+    else if (fill_pct >= (ENERGY_BUDGET_SAVE_PCT + ENERGY_BUDGET_HYSTERESIS_PCT))
+    {
+        level = ENERGY_LEVEL_NORMAL;
+    }
+    else if (ENERGY_LEVEL_CRITICAL == level)
+    {
+        level = ENERGY_LEVEL_SAVE;
+    }
+    else
+    {
+        /* Within the hysteresis band: keep the level */
+    }
+
+    if (level == bucket->level)
+    {
+        return false;
+    }
+    bucket->level = level;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: energy_bucket_fill_pct
+********************************************************************************
+* Summary:
+*  Returns the fill level of a bucket.
+*
+* Parameters:
+*  const stc_energy_bucket_t *bucket - bucket
+*
+* Return:
+*  uint32_t - 0 to 100 %
+*
+*******************************************************************************/
+uint32_t energy_bucket_fill_pct(const stc_energy_bucket_t *bucket)
+{
+    if (0u == bucket->capacity_nc)
+    {
+        return 0u;
+    }
+    return (uint32_t)((bucket->tokens_nc * 100u) / bucket->capacity_nc);
+}
+
+/*******************************************************************************
+* Function Name: energy_bucket_pack
+********************************************************************************
+* Summary:
+*  Packs the fill and the level of a bucket into one word, for a backup
+*  register. The fill is kept as a fraction of the capacity to 1/2^24.
+*
+* Parameters:
+*  const stc_energy_bucket_t *bucket - bucket
+*
+* Return:
+*  uint32_t - packed state, never 0
+*
+*******************************************************************************/
+uint32_t energy_bucket_pack(const stc_energy_bucket_t *bucket)
+{
+    uint32_t fill = 0u;
+
+    if (0u != bucket->capacity_nc)
+    {
+        fill = (uint32_t)((bucket->tokens_nc << ENERGY_PACK_FILL_BITS) / bucket->capacity_nc);
+    }
+
+    return ENERGY_PACK_VALID | ((uint32_t)bucket->level << ENERGY_PACK_LEVEL_POS) | fill;
+}
+
+/*******************************************************************************
+* Function Name: energy_bucket_unpack
+********************************************************************************
+* Summary:
+*  Restores the fill and the level saved by energy_bucket_pack() into an
+*  initialized bucket. The fill is scaled to the capacity of the bucket, so
+*  a changed budget still resumes at the same share.
+*
+* Parameters:
+*  stc_energy_bucket_t *bucket - bucket set up by energy_bucket_init()
+*  uint32_t packed             - packed state
+*
+* Return:
+*  bool - false, and the bucket unchanged, if 'packed' is not a valid state
+*
+*******************************************************************************/
+bool energy_bucket_unpack(stc_energy_bucket_t *bucket, uint32_t packed)
+{
+    uint32_t level = (packed >> ENERGY_PACK_LEVEL_POS) & ENERGY_PACK_LEVEL_MASK;
+    uint32_t fill = packed & (ENERGY_PACK_FILL_ONE | (ENERGY_PACK_FILL_ONE - 1u));
+
+    if ((0u == (packed & ENERGY_PACK_VALID)) || (level >= (uint32_t)ENERGY_LEVEL_COUNT) ||
+        (fill > ENERGY_PACK_FILL_ONE))
+    {
+        return false;
+    }
+
+    bucket->tokens_nc = (bucket->capacity_nc * fill) >> ENERGY_PACK_FILL_BITS;
+    bucket->level = (en_energy_level_t)level;
+    return true;
+}
+
+/* [] END OF FILE */
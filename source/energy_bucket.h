@@ -0,0 +1,95 @@
+/*******************************************************************************
+* File Name:   energy_bucket.h
+*
+* Description: This file contains the interface of the token bucket of the daily
+*              energy budget. It includes no PDL header.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_ENERGY_BUCKET_H_
+#define SOURCE_ENERGY_BUCKET_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Fill levels (%) below which the level drops; it rises again only
+   ENERGY_BUDGET_HYSTERESIS_PCT above them */
+#define ENERGY_BUDGET_SAVE_PCT          (50u)
+#define ENERGY_BUDGET_CRITICAL_PCT      (20u)
+#define ENERGY_BUDGET_HYSTERESIS_PCT    (10u)
+
+#define ENERGY_NC_PER_UAH               (3600000u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Degradation steps, in order */
+typedef enum
+{
+    ENERGY_LEVEL_NORMAL     = 0u,   /* Everything as configured */
+    ENERGY_LEVEL_SAVE       = 1u,   /* Longer period, less log, no optional jobs */
+    ENERGY_LEVEL_CRITICAL   = 2u,   /* Longest period, errors only, critical jobs */
+    ENERGY_LEVEL_COUNT      = 3u,
+} en_energy_level_t;
+
+/* Token bucket of charge */
+typedef struct
+{
+    uint64_t            tokens_nc;
+    uint64_t            capacity_nc;
+    uint32_t            refill_na;      /* Budget as an average current */
+    en_energy_level_t   level;
+} stc_energy_bucket_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void energy_bucket_init(stc_energy_bucket_t *bucket, uint32_t uah_per_day, uint32_t burst_s);
+bool energy_bucket_step(stc_energy_bucket_t *bucket, uint64_t elapsed_us, uint64_t spent_nc);
+uint32_t energy_bucket_fill_pct(const stc_energy_bucket_t *bucket);
+uint32_t energy_bucket_pack(const stc_energy_bucket_t *bucket);
+bool energy_bucket_unpack(stc_energy_bucket_t *bucket, uint32_t packed);
+
+#endif /* SOURCE_ENERGY_BUCKET_H_ */
+
+/* [] END OF FILE */
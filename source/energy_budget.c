@@ -0,0 +1,256 @@
+/*******************************************************************************
+* File Name:   energy_budget.c
+*
+* Description: This file contains the daily energy budget: a token bucket of
+*              charge (energy_bucket.c), drained by the charge that the energy
+*              model assigns to the power mode residency and kept across
+*              Hibernate in a backup register. The fill level selects a
+*              degradation level that the application maps to its wake period,
+*              log verbosity and optional jobs.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdio.h>
+#include "energy_budget.h"
+#include "energy_model.h"
+#include "residency.h"
+#include "lptimer.h"
+#include "retained.h"
+#include "timebase.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define ENERGY_US_PER_S             (1000000u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const uint32_t mode_current_ua[POWER_MODE_COUNT] =
+{
+    ENERGY_ACTIVE_UA,
+    ENERGY_SLEEP_UA,
+    ENERGY_DEEPSLEEP_UA
+};
+
+static const char *const level_names[ENERGY_LEVEL_COUNT] = { "normal", "save", "critical" };
+
+static stc_energy_bucket_t budget_bucket;
+static stc_residency_t budget_last;
+static stc_energy_budget_stats_t budget_stats;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: energy_budget_init
+********************************************************************************
+* Summary:
+*  Starts the budget of the device. After a Hibernate wakeup, the bucket
+*  resumes from the state saved by energy_budget_save(), charged with the
+*  Hibernate time at ENERGY_HIBERNATE_UA; else it starts full. The residency
+*  accounting and the timebase must be running.
+*
+* Parameters:
+*  bool from_hibernate - true on a Hibernate wakeup
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void energy_budget_init(bool from_hibernate)
+{
+    stc_timebase_stats_t timebase;
+    uint64_t hibernate_us;
+
+    energy_bucket_init(&budget_bucket, ENERGY_BUDGET_UAH_PER_DAY, ENERGY_BUDGET_BURST_S);
+    if (from_hibernate && energy_bucket_unpack(&budget_bucket, retained_read(RETAINED_SLOT_ENERGY)))
+    {
+        timebase_get_stats(&timebase);
+        hibernate_us = (uint64_t)timebase.hibernate_s * ENERGY_US_PER_S;
+        (void)energy_bucket_step(&budget_bucket, hibernate_us,
+                                 ((uint64_t)ENERGY_HIBERNATE_UA * hibernate_us) / 1000u);
+    }
+    retained_write(RETAINED_SLOT_ENERGY, 0u);
+
+    residency_get(&budget_last);
+}
+
+/*******************************************************************************
+* Function Name: energy_budget_save
+********************************************************************************
+* Summary:
+*  Charges the bucket up to now and saves its fill and level in the backup
+*  registers. Call it just before Hibernate.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void energy_budget_save(void)
+{
+    (void)energy_budget_update();
+    retained_write(RETAINED_SLOT_ENERGY, energy_bucket_pack(&budget_bucket));
+}
+
+/*******************************************************************************
+* Function Name: energy_budget_update
+********************************************************************************
+* Summary:
+*  Charges the bucket with the residency since the last update, at the
+*  currents of energy_model.h. Call on every alarm wakeup.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - true if the degradation level changed
+*
+*******************************************************************************/
+bool energy_budget_update(void)
+{
+    stc_residency_t now;
+    uint64_t ticks;
+    uint64_t elapsed_ticks = 0u;
+    uint64_t charge = 0u;   /* uA x ticks */
+    uint64_t spent_nc;
+    uint64_t elapsed_us;
+    uint32_t mode;
+    bool changed;
+
+    residency_get(&now);
+    for (mode = 0u; mode < (uint32_t)POWER_MODE_COUNT; mode++)
+    {
+        ticks = now.ticks[mode] - budget_last.ticks[mode];
+        elapsed_ticks += ticks;
+        charge += ticks * mode_current_ua[mode];
+    }
+    budget_last = now;
+
+    spent_nc = (charge * 1000u) / LPTIMER_CLOCK_HZ;
+    elapsed_us = (elapsed_ticks * ENERGY_US_PER_S) / LPTIMER_CLOCK_HZ;
+    changed = energy_bucket_step(&budget_bucket, elapsed_us, spent_nc);
+
+    budget_stats.spent_nc += spent_nc;
+    budget_stats.elapsed_us += elapsed_us;
+    if (changed)
+    {
+        budget_stats.level_changes++;
+    }
+
+    return changed;
+}
+
+/*******************************************************************************
+* Function Name: energy_budget_level
+********************************************************************************
+* Summary:
+*  Returns the current degradation level.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  en_energy_level_t - level
+*
+*******************************************************************************/
+en_energy_level_t energy_budget_level(void)
+{
+    return budget_bucket.level;
+}
+
+/*******************************************************************************
+* Function Name: energy_budget_get_stats
+********************************************************************************
+* Summary:
+*  Copies the bucket state and the counters.
+*
+* Parameters:
+*  stc_energy_budget_stats_t *stats - destination
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void energy_budget_get_stats(stc_energy_budget_stats_t *stats)
+{
+    *stats = budget_stats;
+    stats->fill_pct = energy_bucket_fill_pct(&budget_bucket);
+    stats->level = budget_bucket.level;
+}
+
+/*******************************************************************************
+* Function Name: energy_budget_print
+********************************************************************************
+* Summary:
+*  Prints the budget, the bucket fill, the level and the average current
+*  drawn since boot.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void energy_budget_print(void)
+{
+    stc_energy_budget_stats_t stats;
+    uint64_t average_na = 0u;
+
+    energy_budget_get_stats(&stats);
+    if (0u != stats.elapsed_us)
+    {
+        average_na = (stats.spent_nc * ENERGY_US_PER_S) / stats.elapsed_us;
+    }
+    printf("Energy: budget %lu uAh/day (%lu nA), bucket %lu%% full, level %s, %lu changes\r\n",
+           (unsigned long)ENERGY_BUDGET_UAH_PER_DAY, (unsigned long)budget_bucket.refill_na,
+           (unsigned long)stats.fill_pct, level_names[stats.level],
+           (unsigned long)stats.level_changes);
+    printf("Energy: %lu nA on average over %lu s\r\n",
+           (unsigned long)average_na, (unsigned long)(stats.elapsed_us / ENERGY_US_PER_S));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,81 @@
+/*******************************************************************************
+* File Name:   energy_budget.h
+*
+* Description: This file contains the interface of the daily energy budget.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_ENERGY_BUDGET_H_
+#define SOURCE_ENERGY_BUDGET_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "energy_bucket.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define ENERGY_BUDGET_UAH_PER_DAY       (720u)      /* 30 uA on average */
+#define ENERGY_BUDGET_BURST_S           (3600u)     /* Bucket holds an hour of budget */
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t            fill_pct;
+    en_energy_level_t   level;
+    uint32_t            level_changes;
+    uint64_t            spent_nc;       /* Since boot */
+    uint64_t            elapsed_us;
+} stc_energy_budget_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void energy_budget_init(bool from_hibernate);
+void energy_budget_save(void);
+bool energy_budget_update(void);
+en_energy_level_t energy_budget_level(void);
+void energy_budget_get_stats(stc_energy_budget_stats_t *stats);
+void energy_budget_print(void);
+
+#endif /* SOURCE_ENERGY_BUDGET_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,74 @@
+/*******************************************************************************
+* File Name:   energy_model.h
+*
+* Description: This file contains the current consumption model of the device
+*              used to quantify the energy cost of firmware features. The values
+*              are typical figures for PSOC Control C3 at 3.3 V; replace them
+*              with measurements of your board for accurate budgets.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_ENERGY_MODEL_H_
+#define SOURCE_ENERGY_MODEL_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Supply current per power mode (uA) */
+#define ENERGY_ACTIVE_UA            (9000u) /* CPU running from the PLL */
+#define ENERGY_SLEEP_UA             (3500u) /* CPU clock gated */
+#define ENERGY_DEEPSLEEP_UA         (8u)    /* All SRAM retained, LDO normal */
+#define ENERGY_HIBERNATE_UA         (1u)    /* RTC and ILO running */
+
+/* Shares of ENERGY_DEEPSLEEP_UA, modeled */
+#define ENERGY_SRAM_RETAIN_NA_PER_KB (50u)  /* Retention of one KB of SRAM */
+#define ENERGY_LDO_MIN_SAVING_NA    (1500u) /* LDO in minimum current mode */
+
+/* Charge (nC) drawn at 'ua' microamps for 'us' microseconds */
+#define ENERGY_CHARGE_NC(ua, us)    ((uint32_t)(((uint64_t)(ua) * (uint64_t)(us)) / 1000u))
+
+/* Seconds in a day, for per-day budgets */
+#define ENERGY_SECONDS_PER_DAY      (86400u)
+
+#endif /* SOURCE_ENERGY_MODEL_H_ */
+
+/* [] END OF FILE */
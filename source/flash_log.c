@@ -0,0 +1,445 @@
+/*******************************************************************************
+* File Name:   flash_log.c
+*
+* Description: This file implements a log-structured, append-only flash store.
+*              Records are batched in a RAM page and committed as a whole flash
+*              row to the next page of a rotation, so every row wears evenly and a
+*              commit never rewrites data already stored. Each page carries a
+*              sequence number and each record a CRC; a page torn by a power loss
+*              fails its CRC and is skipped, leaving the older pages intact.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stddef.h>
+#include <string.h>
+#include "flash_log.h"
+#include "crc16.h"
+#include "sram_retain.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define FLASH_LOG_PAGE_SIZE         (CY_FLASH_SIZEOF_ROW)
+#define FLASH_LOG_MAGIC             (0x474F4C46uL)  /* "FLOG" */
+#define FLASH_LOG_NO_PAGE           (FLASH_LOG_PAGES)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t magic;
+    uint32_t sequence;          /* Increments with every commit, never 0 */
+    uint16_t used;              /* Bytes in use, header included */
+    uint16_t crc;               /* Of the fields above */
+} stc_page_header_t;
+
+typedef struct
+{
+    uint8_t  type;              /* en_flash_log_type_t */
+    uint8_t  size;              /* Payload bytes */
+    uint16_t crc;               /* Of type, size and payload */
+} stc_record_header_t;
+
+#define FLASH_LOG_HEADER_CRC_SIZE   (offsetof(stc_page_header_t, crc))
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* The rows of the rotation, in the flash region reserved for EEPROM data */
+CY_SECTION(".cy_em_eeprom") CY_ALIGN(FLASH_LOG_PAGE_SIZE)
+static const uint8_t flash_log_area[FLASH_LOG_PAGES][FLASH_LOG_PAGE_SIZE] = {{0u}};
+
+/* Page being batched; programmed as one row */
+static uint32_t page_buffer[FLASH_LOG_PAGE_SIZE / sizeof(uint32_t)] SRAM_RETAIN;
+static uint32_t buffer_used;
+
+static uint32_t head_page = FLASH_LOG_NO_PAGE;  /* Newest committed page */
+static uint32_t head_sequence = 0u;
+static stc_flash_log_stats_t flash_log_stats;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint32_t page_sequence(uint32_t page);
+static uint32_t mount_probe(uint32_t page);
+static void buffer_reset(void);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: flash_log_init
+********************************************************************************
+* Summary:
+*  Mounts the log. The sequence numbers rise along the rotation up to the
+*  newest page and then drop, and erased or torn pages count as 0, so the
+*  newest page is found by binary search in O(log n) page header reads.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void flash_log_init(void)
+{
+    uint32_t first, low, high, mid;
+
+    memset(&flash_log_stats, 0, sizeof(flash_log_stats));
+    buffer_reset();
+
+    first = mount_probe(0u);
+    if (0u == first)
+    {
+        /* Empty, or page 0 was being rewritten: then the last page is newest */
+        head_page = (0u != mount_probe(FLASH_LOG_PAGES - 1u)) ? (FLASH_LOG_PAGES - 1u)
+                                                                 : FLASH_LOG_NO_PAGE;
+    }
+    else
+    {
+        /* Last page whose sequence is not below that of page 0 */
+        low = 0u;
+        high = FLASH_LOG_PAGES - 1u;
+        while (low < high)
+        {
+            mid = (low + high + 1u) / 2u;
+            if (mount_probe(mid) >= first)
+            {
+                low = mid;
+            }
+            else
+            {
+                high = mid - 1u;
+            }
+        }
+        head_page = low;
+    }
+
+    head_sequence = (FLASH_LOG_NO_PAGE == head_page) ? 0u : mount_probe(head_page);
+}
+
+/*******************************************************************************
+* Function Name: flash_log_append
+********************************************************************************
+* Summary:
+*  Adds a record to the page being batched. A full page is committed first.
+*
+* Parameters:
+*  en_flash_log_type_t type - record type
+*  const void *payload      - record data
+*  uint32_t size            - bytes, up to FLASH_LOG_MAX_PAYLOAD
+*
+* Return:
+*  bool - false if the record is too large or the commit failed
+*
+*******************************************************************************/
+bool flash_log_append(en_flash_log_type_t type, const void *payload, uint32_t size)
+{
+    uint8_t *page = (uint8_t *)page_buffer;
+    stc_record_header_t record;
+
+    if (size > FLASH_LOG_MAX_PAYLOAD)
+    {
+        return false;
+    }
+    if (((buffer_used + sizeof(record) + size) > FLASH_LOG_PAGE_SIZE) && (!flash_log_commit()))
+    {
+        return false;
+    }
+
+    record.type = (uint8_t)type;
+    record.size = (uint8_t)size;
+    record.crc = crc16_update(crc16_update(CRC16_INIT, &record, offsetof(stc_record_header_t, crc)),
+                              payload, size);
+    memcpy(&page[buffer_used], &record, sizeof(record));
+    memcpy(&page[buffer_used + sizeof(record)], payload, size);
+    buffer_used += sizeof(record) + size;
+    flash_log_stats.records++;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: flash_log_commit
+********************************************************************************
+* Summary:
+*  Programs the batched records as the next page of the rotation, erasing the
+*  oldest one. The previous pages stay valid until the new one is complete.
+*  Call before Hibernate; records not committed are lost on a reset.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - false if programming failed; the records stay batched
+*
+*******************************************************************************/
+bool flash_log_commit(void)
+{
+    stc_page_header_t header;
+    uint32_t next;
+
+    if (buffer_used <= sizeof(header))
+    {
+        return true;
+    }
+
+    header.magic = FLASH_LOG_MAGIC;
+    header.sequence = head_sequence + 1u;
+    header.used = (uint16_t)buffer_used;
+    header.crc = crc16_update(CRC16_INIT, &header, FLASH_LOG_HEADER_CRC_SIZE);
+    memcpy(page_buffer, &header, sizeof(header));
+
+    next = (FLASH_LOG_NO_PAGE == head_page) ? 0u : ((head_page + 1u) % FLASH_LOG_PAGES);
+    if (CY_FLASH_DRV_SUCCESS != Cy_Flash_WriteRow((uint32_t)flash_log_area[next], page_buffer))
+    {
+        return false;
+    }
+
+    head_page = next;
+    head_sequence++;
+    flash_log_stats.commits++;
+    buffer_reset();
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: flash_log_next
+********************************************************************************
+* Summary:
+*  Reads the record at 'cursor' and advances it. Walks the committed pages
+*  from the oldest one, then the batched records. Start with a zeroed cursor.
+*
+* Parameters:
+*  stc_flash_log_cursor_t *cursor - position, advanced on return
+*  en_flash_log_type_t *type      - record type
+*  void *payload                  - FLASH_LOG_MAX_PAYLOAD bytes
+*  uint32_t *size                 - payload bytes
+*
+* Return:
+*  bool - false at the end of the log
+*
+*******************************************************************************/
+bool flash_log_next(stc_flash_log_cursor_t *cursor, en_flash_log_type_t *type,
+                    void *payload, uint32_t *size)
+{
+    stc_flash_log_ref_t ref;
+
+    if (!flash_log_next_ref(cursor, &ref))
+    {
+        return false;
+    }
+    memcpy(payload, ref.payload, ref.size);
+    *type = ref.type;
+    *size = ref.size;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: flash_log_next_ref
+********************************************************************************
+* Summary:
+*  flash_log_next() without the copy: points at the record where it is
+*  stored, and gives its position, which stays the same across commits,
+*  rotations and resets.
+*
+* Parameters:
+*  stc_flash_log_cursor_t *cursor - position, advanced on return
+*  stc_flash_log_ref_t *ref       - destination
+*
+* Return:
+*  bool - false at the end of the log
+*
+*******************************************************************************/
+bool flash_log_next_ref(stc_flash_log_cursor_t *cursor, stc_flash_log_ref_t *ref)
+{
+    const uint8_t *page;
+    stc_page_header_t header;
+    stc_record_header_t record;
+    uint32_t physical, used, sequence;
+
+    while (cursor->page <= FLASH_LOG_PAGES)
+    {
+        if (FLASH_LOG_PAGES == cursor->page)
+        {
+            page = (const uint8_t *)page_buffer;
+            used = buffer_used;
+            sequence = head_sequence + 1u;
+        }
+        else
+        {
+            physical = (FLASH_LOG_NO_PAGE == head_page) ? 0u
+                     : ((head_page + 1u + cursor->page) % FLASH_LOG_PAGES);
+            page = flash_log_area[physical];
+            memcpy(&header, page, sizeof(header));
+            sequence = page_sequence(physical);
+            used = (0u != sequence) ? header.used : 0u;
+        }
+        if (0u == cursor->offset)
+        {
+            cursor->offset = sizeof(header);
+        }
+
+        if ((cursor->offset + sizeof(record)) <= used)
+        {
+            memcpy(&record, &page[cursor->offset], sizeof(record));
+            if (((cursor->offset + sizeof(record) + record.size) <= used) &&
+                (record.size <= FLASH_LOG_MAX_PAYLOAD) &&
+                (record.crc == crc16_update(crc16_update(CRC16_INIT, &record,
+                                                         offsetof(stc_record_header_t, crc)),
+                                            &page[cursor->offset + sizeof(record)], record.size)))
+            {
+                ref->type = (en_flash_log_type_t)record.type;
+                ref->payload = &page[cursor->offset + sizeof(record)];
+                ref->size = record.size;
+                ref->position = (sequence * FLASH_LOG_PAGE_SIZE) + cursor->offset;
+                cursor->offset += sizeof(record) + record.size;
+                return true;
+            }
+        }
+
+        /* End of the page, or a torn record: the rest of the page is lost */
+        cursor->page++;
+        cursor->offset = 0u;
+    }
+
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: flash_log_get_stats
+********************************************************************************
+* Summary:
+*  Copies the log statistics.
+*
+* Parameters:
+*  stc_flash_log_stats_t *stats - destination
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void flash_log_get_stats(stc_flash_log_stats_t *stats)
+{
+    uint32_t i;
+
+    *stats = flash_log_stats;
+    stats->sequence = head_sequence;
+    stats->buffered = buffer_used - sizeof(stc_page_header_t);
+    stats->pages = 0u;
+    for (i = 0u; i < FLASH_LOG_PAGES; i++)
+    {
+        stats->pages += (0u != page_sequence(i)) ? 1u : 0u;
+    }
+}
+
+/*******************************************************************************
+* Function Name: page_sequence
+********************************************************************************
+* Summary:
+*  Returns the sequence number of a page, or 0 if it is erased or torn.
+*
+* Parameters:
+*  uint32_t page - physical page
+*
+* Return:
+*  uint32_t - sequence number
+*
+*******************************************************************************/
+static uint32_t page_sequence(uint32_t page)
+{
+    stc_page_header_t header;
+
+    memcpy(&header, flash_log_area[page], sizeof(header));
+    if ((FLASH_LOG_MAGIC != header.magic) || (0u == header.sequence) ||
+        (header.used < sizeof(header)) || (header.used > FLASH_LOG_PAGE_SIZE) ||
+        (header.crc != crc16_update(CRC16_INIT, &header, FLASH_LOG_HEADER_CRC_SIZE)))
+    {
+        return 0u;
+    }
+
+    return header.sequence;
+}
+
+/*******************************************************************************
+* Function Name: mount_probe
+********************************************************************************
+* Summary:
+*  page_sequence() for the mount, counting the header reads.
+*
+* Parameters:
+*  uint32_t page - physical page
+*
+* Return:
+*  uint32_t - sequence number
+*
+*******************************************************************************/
+static uint32_t mount_probe(uint32_t page)
+{
+    flash_log_stats.mount_probes++;
+    return page_sequence(page);
+}
+
+/*******************************************************************************
+* Function Name: buffer_reset
+********************************************************************************
+* Summary:
+*  Empties the page being batched. Unused bytes stay erased.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void buffer_reset(void)
+{
+    memset(page_buffer, 0xFF, sizeof(page_buffer));
+    buffer_used = sizeof(stc_page_header_t);
+}
+
+/* [] END OF FILE */
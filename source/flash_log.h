@@ -0,0 +1,138 @@
+/*******************************************************************************
+* File Name:   flash_log.h
+*
+* Description: This file contains the interface of the log-structured flash store
+*              that keeps history across Hibernate and resets.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_FLASH_LOG_H_
+#define SOURCE_FLASH_LOG_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define FLASH_LOG_PAGES             (16u)   /* Flash rows in the rotation */
+#define FLASH_LOG_MAX_PAYLOAD       (64u)   /* Largest record payload */
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef enum
+{
+    FLASH_LOG_WAKE      = 1u,   /* stc_flash_log_wake_t */
+    FLASH_LOG_STATS     = 2u,   /* stc_flash_log_snapshot_t */
+    FLASH_LOG_SAMPLES   = 3u,   /* Coded sample block, see compress.h */
+    FLASH_LOG_FEATURES  = 4u,   /* stc_flash_log_features_t */
+} en_flash_log_type_t;
+
+/* FLASH_LOG_WAKE payload */
+typedef struct
+{
+    uint32_t rtc_seconds;       /* RTC time of day */
+    uint8_t  source;            /* en_wake_source_t */
+    uint8_t  from_hibernate;
+    uint16_t reserved;
+} stc_flash_log_wake_t;
+
+/* FLASH_LOG_STATS payload */
+typedef struct
+{
+    uint32_t rtc_seconds;       /* RTC time of day */
+    uint32_t samples;           /* ADC samples since boot */
+    uint32_t wakes;             /* Pre-armed DeepSleep wakeups since boot */
+    uint32_t missed_wakes;      /* Alarm wakeups missing, all boots */
+} stc_flash_log_snapshot_t;
+
+/* FLASH_LOG_FEATURES payload: the filtered samples of one batch */
+typedef struct
+{
+    uint32_t rtc_seconds;       /* RTC time of day at the end of the batch */
+    uint16_t count;             /* Samples in the batch */
+    int16_t  mean;
+    uint16_t rms;
+    int16_t  min;
+    int16_t  max;
+    uint16_t crossings;         /* Rising crossings of PROCESSING_THRESHOLD */
+} stc_flash_log_features_t;
+
+/* Position in the log, from the oldest record to the newest */
+typedef struct
+{
+    uint32_t page;              /* Pages visited */
+    uint32_t offset;            /* Byte offset in the page */
+} stc_flash_log_cursor_t;
+
+/* Record read in place, in flash or in the page being batched */
+typedef struct
+{
+    en_flash_log_type_t type;
+    const uint8_t       *payload;   /* Valid until the next append or commit */
+    uint32_t            size;
+    uint32_t            position;   /* Page sequence * page size + offset; a
+                                       record keeps it when its page commits */
+} stc_flash_log_ref_t;
+
+typedef struct
+{
+    uint32_t pages;             /* Pages holding records */
+    uint32_t sequence;          /* Sequence number of the newest page */
+    uint32_t mount_probes;      /* Page headers read to find the head */
+    uint32_t commits;           /* Pages programmed since boot */
+    uint32_t buffered;          /* Bytes waiting for the next commit */
+    uint32_t records;           /* Records appended since boot */
+} stc_flash_log_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void flash_log_init(void);
+bool flash_log_append(en_flash_log_type_t type, const void *payload, uint32_t size);
+bool flash_log_commit(void);
+bool flash_log_next(stc_flash_log_cursor_t *cursor, en_flash_log_type_t *type,
+                    void *payload, uint32_t *size);
+bool flash_log_next_ref(stc_flash_log_cursor_t *cursor, stc_flash_log_ref_t *ref);
+void flash_log_get_stats(stc_flash_log_stats_t *stats);
+
+#endif /* SOURCE_FLASH_LOG_H_ */
+
+/* [] END OF FILE */
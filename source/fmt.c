@@ -0,0 +1,526 @@
+/*******************************************************************************
+* File Name:   fmt.c
+*
+* Description: This file implements a small printf formatter for the conversions the
+*              firmware uses: %d %i %u %x %X %c %s and %%, with the flags '-' and '0', a
+*              width, a precision and the 'l' length. It has no floating point, no heap
+*              and no static state, so it is reentrant, and it hands each run of output
+*              to the caller without a line buffer. It uses no PDL calls, so it also
+*              builds on a host.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdbool.h>
+#include <string.h>
+#include "fmt.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define FMT_NUMBER_SIZE             (24u)   /* Digits of a 64-bit long, with room */
+#define FMT_PAD_RUN                 (16u)   /* Characters in each padding string */
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    fmt_put_t   put;
+    void        *context;
+    int         count;          /* Characters produced so far */
+} stc_fmt_out_t;
+
+/* Destination of fmt_vsnprintf */
+typedef struct
+{
+    char        *buffer;
+    size_t      size;
+    size_t      used;           /* Characters stored, without the terminator */
+} stc_fmt_buffer_t;
+
+/* Conversion specification after the '%' */
+typedef struct
+{
+    bool        left;           /* '-': pad on the right */
+    bool        zero;           /* '0': pad numbers with zeros */
+    bool        is_long;        /* 'l' */
+    uint32_t    width;
+    int32_t     precision;      /* -1 if not given */
+} stc_fmt_spec_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const char fmt_spaces[FMT_PAD_RUN + 1u] = "                ";
+static const char fmt_zeros[FMT_PAD_RUN + 1u] = "0000000000000000";
+static const char fmt_lower[] = "0123456789abcdef";
+static const char fmt_upper[] = "0123456789ABCDEF";
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void fmt_emit(stc_fmt_out_t *out, const char *data, uint32_t size);
+static void fmt_pad(stc_fmt_out_t *out, const char *run, uint32_t count);
+static const char *fmt_parse(const char *format, stc_fmt_spec_t *spec, va_list *args);
+static void fmt_number(stc_fmt_out_t *out, const stc_fmt_spec_t *spec, unsigned long value,
+                       unsigned int base, const char *digits, bool negative);
+static void fmt_string(stc_fmt_out_t *out, const stc_fmt_spec_t *spec, const char *str);
+static void fmt_put_buffer(void *context, const char *data, uint32_t size);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: fmt_vformat
+********************************************************************************
+* Summary:
+*  Formats like vprintf, for the conversions the firmware uses, and passes the
+*  output to 'put' in runs: the literal text between conversions straight from
+*  the format, each field from a few bytes of stack. An unknown conversion is
+*  copied as it is and takes no argument.
+*
+* Parameters:
+*  fmt_put_t put      - takes the output
+*  void *context      - passed to 'put'
+*  const char *format - printf format
+*  va_list args       - arguments
+*
+* Return:
+*  int - characters produced
+*
+*******************************************************************************/
+int fmt_vformat(fmt_put_t put, void *context, const char *format, va_list args)
+{
+    stc_fmt_out_t out = { put, context, 0 };
+    stc_fmt_spec_t spec;
+    const char *run;
+    const char *start;
+    long value;
+    char c;
+    va_list ap;
+
+    va_copy(ap, args);
+    while ('\0' != *format)
+    {
+        run = format;
+        while (('\0' != *format) && ('%' != *format))
+        {
+            format++;
+        }
+        fmt_emit(&out, run, (uint32_t)(format - run));
+        if ('\0' == *format)
+        {
+            break;
+        }
+
+        start = format;
+        format = fmt_parse(format + 1, &spec, &ap);
+        switch (*format)
+        {
+            case 'd':
+            case 'i':
+                value = spec.is_long ? va_arg(ap, long) : (long)va_arg(ap, int);
+                fmt_number(&out, &spec, (value < 0) ? (0ul - (unsigned long)value) : (unsigned long)value,
+                           10u, fmt_lower, (value < 0));
+                break;
+            case 'u':
+            case 'x':
+            case 'X':
+                fmt_number(&out, &spec,
+                           spec.is_long ? va_arg(ap, unsigned long) : (unsigned long)va_arg(ap, unsigned int),
+                           ('u' == *format) ? 10u : 16u, ('X' == *format) ? fmt_upper : fmt_lower, false);
+                break;
+            case 's':
+                fmt_string(&out, &spec, va_arg(ap, const char *));
+                break;
+            case 'c':
+                c = (char)va_arg(ap, int);
+                spec.width = (spec.width > 1u) ? spec.width : 1u;
+                fmt_pad(&out, fmt_spaces, spec.left ? 0u : (spec.width - 1u));
+                fmt_emit(&out, &c, 1u);
+                fmt_pad(&out, fmt_spaces, spec.left ? (spec.width - 1u) : 0u);
+                break;
+            case '%':
+                fmt_emit(&out, format, 1u);
+                break;
+            default:
+                /* Not supported: print the specification */
+                if ('\0' == *format)
+                {
+                    format--;
+                }
+                fmt_emit(&out, start, (uint32_t)(format + 1 - start));
+                break;
+        }
+        format++;
+    }
+    va_end(ap);
+
+    return out.count;
+}
+
+/*******************************************************************************
+* Function Name: fmt_vsnprintf
+********************************************************************************
+* Summary:
+*  Formats like vsnprintf into 'buffer': stores at most size - 1 characters
+*  and a terminator, if size is not 0.
+*
+* Parameters:
+*  char *buffer       - destination
+*  size_t size        - size of the destination
+*  const char *format - printf format
+*  va_list args       - arguments
+*
+* Return:
+*  int - characters the whole output has, stored or not
+*
+*******************************************************************************/
+int fmt_vsnprintf(char *buffer, size_t size, const char *format, va_list args)
+{
+    stc_fmt_buffer_t dest = { buffer, size, 0u };
+    int count;
+
+    count = fmt_vformat(fmt_put_buffer, &dest, format, args);
+    if (0u != size)
+    {
+        buffer[dest.used] = '\0';
+    }
+
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: fmt_snprintf
+********************************************************************************
+* Summary:
+*  Formats like snprintf into 'buffer', see fmt_vsnprintf.
+*
+* Parameters:
+*  char *buffer       - destination
+*  size_t size        - size of the destination
+*  const char *format - printf format
+*  ...                - arguments
+*
+* Return:
+*  int - characters the whole output has, stored or not
+*
+*******************************************************************************/
+int fmt_snprintf(char *buffer, size_t size, const char *format, ...)
+{
+    va_list args;
+    int count;
+
+    va_start(args, format);
+    count = fmt_vsnprintf(buffer, size, format, args);
+    va_end(args);
+
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: fmt_emit
+********************************************************************************
+* Summary:
+*  Passes a run of output on and counts it.
+*
+* Parameters:
+*  stc_fmt_out_t *out - output
+*  const char *data   - characters
+*  uint32_t size      - number of characters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void fmt_emit(stc_fmt_out_t *out, const char *data, uint32_t size)
+{
+    if (0u != size)
+    {
+        out->put(out->context, data, size);
+        out->count += (int)size;
+    }
+}
+
+/*******************************************************************************
+* Function Name: fmt_pad
+********************************************************************************
+* Summary:
+*  Outputs 'count' padding characters, in runs of up to FMT_PAD_RUN.
+*
+* Parameters:
+*  stc_fmt_out_t *out - output
+*  const char *run    - fmt_spaces or fmt_zeros
+*  uint32_t count     - number of characters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void fmt_pad(stc_fmt_out_t *out, const char *run, uint32_t count)
+{
+    uint32_t size;
+
+    while (0u != count)
+    {
+        size = (count > FMT_PAD_RUN) ? FMT_PAD_RUN : count;
+        fmt_emit(out, run, size);
+        count -= size;
+    }
+}
+
+/*******************************************************************************
+* Function Name: fmt_parse
+********************************************************************************
+* Summary:
+*  Reads the flags, width, precision and length of a conversion. A '*' width
+*  or precision takes an int argument, as in printf.
+*
+* Parameters:
+*  const char *format   - first character after the '%'
+*  stc_fmt_spec_t *spec - filled in
+*  va_list *args        - arguments, for '*'
+*
+* Return:
+*  const char * - the conversion character
+*
+*******************************************************************************/
+static const char *fmt_parse(const char *format, stc_fmt_spec_t *spec, va_list *args)
+{
+    int star;
+
+    spec->left = false;
+    spec->zero = false;
+    spec->is_long = false;
+    spec->width = 0u;
+    spec->precision = -1;
+
+    for (;; format++)
+    {
+        if ('-' == *format)
+        {
+            spec->left = true;
+        }
+        else if ('0' == *format)
+        {
+            spec->zero = true;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    if ('*' == *format)
+    {
+        star = va_arg(*args, int);
+        spec->left = spec->left || (star < 0);
+        spec->width = (star < 0) ? (0u - (uint32_t)star) : (uint32_t)star;
+        format++;
+    }
+    while (('0' <= *format) && (*format <= '9'))
+    {
+        spec->width = (spec->width * 10u) + (uint32_t)(*format++ - '0');
+    }
+
+    if ('.' == *format)
+    {
+        format++;
+        spec->precision = 0;
+        if ('*' == *format)
+        {
+            star = va_arg(*args, int);
+            spec->precision = (star < 0) ? -1 : star;
+            format++;
+        }
+        while (('0' <= *format) && (*format <= '9'))
+        {
+            spec->precision = (spec->precision * 10) + (*format++ - '0');
+        }
+    }
+
+    if ('l' == *format)
+    {
+        spec->is_long = true;
+        format++;
+    }
+
+    return format;
+}
+
+/*******************************************************************************
+* Function Name: fmt_number
+********************************************************************************
+* Summary:
+*  Outputs an integer field: the sign, the zeros of the precision or of the
+*  '0' flag, the digits, and the spaces that fill the width.
+*
+* Parameters:
+*  stc_fmt_out_t *out         - output
+*  const stc_fmt_spec_t *spec - conversion
+*  unsigned long value        - magnitude
+*  unsigned int base          - 10 or 16
+*  const char *digits         - fmt_lower or fmt_upper
+*  bool negative              - print a minus sign
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void fmt_number(stc_fmt_out_t *out, const stc_fmt_spec_t *spec, unsigned long value,
+                       unsigned int base, const char *digits, bool negative)
+{
+    char number[FMT_NUMBER_SIZE];
+    uint32_t length = 0u;
+    uint32_t sign = negative ? 1u : 0u;
+    uint32_t zeros = 0u;
+    uint32_t total;
+
+    /* A zero precision prints no digits for 0 */
+    if ((0ul != value) || (0 != spec->precision))
+    {
+        do
+        {
+            number[FMT_NUMBER_SIZE - 1u - length] = digits[value % base];
+            value /= base;
+            length++;
+        } while (0ul != value);
+    }
+
+    if ((spec->precision >= 0) && ((uint32_t)spec->precision > length))
+    {
+        zeros = (uint32_t)spec->precision - length;
+    }
+    else if (spec->zero && (!spec->left) && (spec->precision < 0) && (spec->width > (sign + length)))
+    {
+        zeros = spec->width - sign - length;
+    }
+    total = sign + zeros + length;
+
+    if ((!spec->left) && (spec->width > total))
+    {
+        fmt_pad(out, fmt_spaces, spec->width - total);
+    }
+    fmt_emit(out, "-", sign);
+    fmt_pad(out, fmt_zeros, zeros);
+    fmt_emit(out, &number[FMT_NUMBER_SIZE - length], length);
+    if (spec->left && (spec->width > total))
+    {
+        fmt_pad(out, fmt_spaces, spec->width - total);
+    }
+}
+
+/*******************************************************************************
+* Function Name: fmt_string
+********************************************************************************
+* Summary:
+*  Outputs a string field: at most 'precision' characters, padded with spaces
+*  to the width. A NULL string prints as "(null)".
+*
+* Parameters:
+*  stc_fmt_out_t *out         - output
+*  const stc_fmt_spec_t *spec - conversion
+*  const char *str            - string
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void fmt_string(stc_fmt_out_t *out, const stc_fmt_spec_t *spec, const char *str)
+{
+    uint32_t length = 0u;
+
+    if (NULL == str)
+    {
+        str = "(null)";
+    }
+    while (((spec->precision < 0) || (length < (uint32_t)spec->precision)) && ('\0' != str[length]))
+    {
+        length++;
+    }
+
+    if ((!spec->left) && (spec->width > length))
+    {
+        fmt_pad(out, fmt_spaces, spec->width - length);
+    }
+    fmt_emit(out, str, length);
+    if (spec->left && (spec->width > length))
+    {
+        fmt_pad(out, fmt_spaces, spec->width - length);
+    }
+}
+
+/*******************************************************************************
+* Function Name: fmt_put_buffer
+********************************************************************************
+* Summary:
+*  Output of fmt_vsnprintf: stores what fits, keeping room for the
+*  terminator.
+*
+* Parameters:
+*  void *context    - stc_fmt_buffer_t
+*  const char *data - characters
+*  uint32_t size    - number of characters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void fmt_put_buffer(void *context, const char *data, uint32_t size)
+{
+    stc_fmt_buffer_t *dest = (stc_fmt_buffer_t *)context;
+    size_t room;
+
+    if (0u == dest->size)
+    {
+        return;
+    }
+    room = dest->size - 1u - dest->used;
+    if (size > room)
+    {
+        size = (uint32_t)room;
+    }
+    memcpy(&dest->buffer[dest->used], data, size);
+    dest->used += size;
+}
+
+/* [] END OF FILE */
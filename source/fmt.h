@@ -0,0 +1,78 @@
+/*******************************************************************************
+* File Name:   fmt.h
+*
+* Description: This file contains the interface of the integer-only formatter that
+*              replaces newlib's printf family for the firmware's output.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_FMT_H_
+#define SOURCE_FMT_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Lets the compiler check the arguments against the format */
+#if defined(__GNUC__)
+#define FMT_CHECK(format_index, first_arg)  __attribute__((format(printf, format_index, first_arg)))
+#else
+#define FMT_CHECK(format_index, first_arg)
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Output of the formatter: takes each run of characters as it is produced */
+typedef void (*fmt_put_t)(void *context, const char *data, uint32_t size);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+int fmt_vformat(fmt_put_t put, void *context, const char *format, va_list args);
+int fmt_vsnprintf(char *buffer, size_t size, const char *format, va_list args);
+int fmt_snprintf(char *buffer, size_t size, const char *format, ...) FMT_CHECK(3, 4);
+
+#endif /* SOURCE_FMT_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,358 @@
+/*******************************************************************************
+* File Name:   jobs.c
+*
+* Description: Registry of the periodic jobs run after a wakeup, with
+*              execution budgets and runtime statistics.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdio.h>
+#include "jobs.h"
+#include "cycles.h"
+#include "timebase.h"
+#include "trace.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const stc_job_t *job_table;
+static uint32_t job_count = 0u;
+
+static stc_job_stats_t job_stats[JOBS_MAX];
+static uint64_t job_next_due[JOBS_MAX];     /* Timebase microseconds */
+static bool job_has_run[JOBS_MAX];
+
+static const char *const priority_names[] = { "crit", "normal", "low" };
+static const char *const catch_up_names[] = { "skip", "once", "all" };
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: jobs_init
+********************************************************************************
+* Summary:
+*  Registers the job table and clears the statistics. Every job is due on the
+*  first dispatch.
+*
+* Parameters:
+*  const stc_job_t *table - jobs, in dispatch order within a priority
+*  uint32_t count         - number of jobs, at most JOBS_MAX
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void jobs_init(const stc_job_t *table, uint32_t count)
+{
+    uint32_t i;
+
+    CY_ASSERT(count <= JOBS_MAX);
+
+    job_table = table;
+    job_count = count;
+    for (i = 0u; i < JOBS_MAX; i++)
+    {
+        job_stats[i] = (stc_job_stats_t){ .min_cycles = UINT32_MAX };
+        job_has_run[i] = false;
+    }
+    cycles_init();
+}
+
+/*******************************************************************************
+* Function Name: job_is_due
+********************************************************************************
+* Summary:
+*  Checks whether a job's deadline has come.
+*
+* Parameters:
+*  uint32_t index - job index
+*  uint64_t now   - timebase microseconds
+*
+* Return:
+*  bool - true if the job should run
+*
+*******************************************************************************/
+static bool job_is_due(uint32_t index, uint64_t now)
+{
+    return (!job_has_run[index]) || (now >= job_next_due[index]);
+}
+
+/*******************************************************************************
+* Function Name: job_catch_up
+********************************************************************************
+* Summary:
+*  Moves a due job's deadline to the first one of its grid after 'now' and
+*  counts the deadlines missed on the way, the ones passed a whole period
+*  ago. The catch-up policy of the job decides how many runs make up for
+*  them; the rest are dropped.
+*
+* Parameters:
+*  uint32_t index - job index
+*  uint64_t now   - timebase microseconds
+*
+* Return:
+*  uint32_t - runs due now, 0 if the policy skips them all
+*
+*******************************************************************************/
+static uint32_t job_catch_up(uint32_t index, uint64_t now)
+{
+    const stc_job_t *job = &job_table[index];
+    stc_job_stats_t *stats = &job_stats[index];
+    uint64_t period_us = (uint64_t)job->period_s * TIMEBASE_US_PER_S;
+    uint64_t late_us;
+    uint32_t missed;
+    uint32_t runs;
+
+    if ((!job_has_run[index]) || (0u == period_us))
+    {
+        job_next_due[index] = now + period_us;
+        return 1u;
+    }
+
+    late_us = now - job_next_due[index];
+    missed = (uint32_t)(late_us / period_us);
+    job_next_due[index] += ((uint64_t)missed + 1u) * period_us;
+    stats->missed += missed;
+    if (late_us > stats->max_late_us)
+    {
+        stats->max_late_us = (late_us > UINT32_MAX) ? UINT32_MAX : (uint32_t)late_us;
+    }
+
+    switch (job->catch_up)
+    {
+        case JOB_CATCH_UP_ONCE:
+            runs = 1u;
+            break;
+        case JOB_CATCH_UP_ALL:
+            runs = missed + 1u;
+            if (runs > job->catch_up_max)
+            {
+                runs = (0u != job->catch_up_max) ? job->catch_up_max : 1u;
+            }
+            break;
+        default:
+            runs = (0u == missed) ? 1u : 0u;
+            break;
+    }
+    stats->dropped += (missed + 1u) - runs;
+
+    return runs;
+}
+
+/*******************************************************************************
+* Function Name: job_execute
+********************************************************************************
+* Summary:
+*  Runs a job once and updates its runtime statistics. A run longer than its
+*  budget is counted and traced as an overrun.
+*
+* Parameters:
+*  uint32_t index - job index
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void job_execute(uint32_t index)
+{
+    const stc_job_t *job = &job_table[index];
+    stc_job_stats_t *stats = &job_stats[index];
+    uint32_t begin = cycles_now();
+    uint32_t cycles;
+
+    job->run();
+    cycles = cycles_now() - begin;
+
+    stats->runs++;
+    stats->total_cycles += cycles;
+    if (cycles < stats->min_cycles)
+    {
+        stats->min_cycles = cycles;
+    }
+    if (cycles > stats->max_cycles)
+    {
+        stats->max_cycles = cycles;
+    }
+    if (CYCLES_TO_US(cycles) > job->budget_us)
+    {
+        stats->overruns++;
+        trace_record(TRACE_EVENT_OVERRUN, index);
+    }
+}
+
+/*******************************************************************************
+* Function Name: jobs_run
+********************************************************************************
+* Summary:
+*  Runs the due jobs, highest priority first, and measures their runtimes.
+*  Critical jobs always run. Other jobs are skipped, and stay due, if their
+*  priority is below 'lowest' or their budget does not fit in the time left.
+*  A job that missed deadlines runs as its catch-up policy says; catch-up
+*  runs that no longer fit in the time left are dropped.
+*
+* Parameters:
+*  uint32_t time_budget_us    - time available for this dispatch
+*  en_job_priority_t lowest   - lowest priority allowed to run
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void jobs_run(uint32_t time_budget_us, en_job_priority_t lowest)
+{
+    uint64_t now = timebase_now_us();
+    uint32_t start = cycles_now();
+    uint32_t priority, i;
+    uint32_t runs, elapsed_us;
+    const stc_job_t *job;
+    stc_job_stats_t *stats;
+
+    for (priority = JOB_PRIORITY_CRITICAL; priority <= JOB_PRIORITY_LOW; priority++)
+    {
+        for (i = 0u; i < job_count; i++)
+        {
+            job = &job_table[i];
+            stats = &job_stats[i];
+            if ((job->priority != priority) || !job_is_due(i, now))
+            {
+                continue;
+            }
+
+            elapsed_us = CYCLES_TO_US(cycles_now() - start);
+            if ((JOB_PRIORITY_CRITICAL != job->priority) &&
+                ((job->priority > lowest) || ((elapsed_us + job->budget_us) > time_budget_us)))
+            {
+                stats->skips++;
+                continue;
+            }
+
+            runs = job_catch_up(i, now);
+            job_has_run[i] = true;
+            while (0u != runs)
+            {
+                job_execute(i);
+                runs--;
+
+                elapsed_us = CYCLES_TO_US(cycles_now() - start);
+                if ((0u != runs) && (JOB_PRIORITY_CRITICAL != job->priority) &&
+                    ((elapsed_us + job->budget_us) > time_budget_us))
+                {
+                    stats->dropped += runs;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: jobs_get_stats
+********************************************************************************
+* Summary:
+*  Returns the runtime statistics of a job.
+*
+* Parameters:
+*  uint32_t index           - job index
+*  stc_job_stats_t *stats   - filled with the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void jobs_get_stats(uint32_t index, stc_job_stats_t *stats)
+{
+    CY_ASSERT(index < job_count);
+
+    *stats = job_stats[index];
+}
+
+/*******************************************************************************
+* Function Name: jobs_print_stats
+********************************************************************************
+* Summary:
+*  Prints the job table with the min/avg/max runtimes in microseconds, and
+*  the missed deadlines: how many, how many were dropped, and the longest
+*  delay past one.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void jobs_print_stats(void)
+{
+    uint32_t i;
+    const stc_job_t *job;
+    const stc_job_stats_t *stats;
+    uint32_t avg_cycles;
+
+    printf("Job       prio    period  budget    runs skips overr     min     avg     max (us)\r\n");
+    for (i = 0u; i < job_count; i++)
+    {
+        job = &job_table[i];
+        stats = &job_stats[i];
+        avg_cycles = (0u != stats->runs) ? (uint32_t)(stats->total_cycles / stats->runs) : 0u;
+        printf("%-9s %-6s %6lus %7lu %7lu %5lu %5lu %7lu %7lu %7lu\r\n",
+               job->name, priority_names[job->priority], (unsigned long)job->period_s,
+               (unsigned long)job->budget_us, (unsigned long)stats->runs,
+               (unsigned long)stats->skips, (unsigned long)stats->overruns,
+               (unsigned long)((0u != stats->runs) ? CYCLES_TO_US(stats->min_cycles) : 0u),
+               (unsigned long)CYCLES_TO_US(avg_cycles),
+               (unsigned long)CYCLES_TO_US(stats->max_cycles));
+    }
+    printf("\r\nJob       catch-up  missed dropped  max late (ms)\r\n");
+    for (i = 0u; i < job_count; i++)
+    {
+        job = &job_table[i];
+        stats = &job_stats[i];
+        printf("%-9s %-5s %2lu %7lu %7lu %14lu\r\n", job->name, catch_up_names[job->catch_up],
+               (unsigned long)((JOB_CATCH_UP_ALL == job->catch_up) ? job->catch_up_max : 1u),
+               (unsigned long)stats->missed, (unsigned long)stats->dropped,
+               (unsigned long)(stats->max_late_us / 1000u));
+    }
+    printf("\r\n");
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,115 @@
+/*******************************************************************************
+* File Name:   jobs.h
+*
+* Description: Registry of the periodic jobs run after a wakeup, with
+*              execution budgets and runtime statistics.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_JOBS_H_
+#define SOURCE_JOBS_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define JOBS_MAX                    (8u)        /* Size of the statistics table */
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Job priority, highest first. Critical jobs are never skipped. */
+typedef enum
+{
+    JOB_PRIORITY_CRITICAL   = 0u,
+    JOB_PRIORITY_NORMAL     = 1u,
+    JOB_PRIORITY_LOW        = 2u,
+} en_job_priority_t;
+
+/* What a job does about the periods it missed entirely, for example while
+   a long button press or an RTC retry kept the CPU busy */
+typedef enum
+{
+    JOB_CATCH_UP_SKIP       = 0u,   /* Drop them and wait for the next period */
+    JOB_CATCH_UP_ONCE       = 1u,   /* Run once now for all of them */
+    JOB_CATCH_UP_ALL        = 2u,   /* Run once per period, up to catch_up_max */
+} en_job_catch_up_t;
+
+typedef void (*job_fn_t)(void);
+
+/* Periodic job. A period of 0 runs the job on every dispatch. Periodic jobs
+   are due on a fixed grid of deadlines, period_s apart from the first run. */
+typedef struct
+{
+    const char          *name;
+    job_fn_t            run;
+    uint32_t            period_s;
+    uint32_t            budget_us;  /* Worst-case runtime */
+    en_job_priority_t   priority;
+    en_job_catch_up_t   catch_up;
+    uint32_t            catch_up_max;   /* Runs per dispatch with JOB_CATCH_UP_ALL */
+} stc_job_t;
+
+/* Runtime statistics of a job */
+typedef struct
+{
+    uint32_t    runs;
+    uint32_t    skips;          /* Due but shed for lack of time or energy */
+    uint32_t    overruns;       /* Runs longer than the budget */
+    uint32_t    missed;         /* Deadlines passed a whole period ago */
+    uint32_t    dropped;        /* Missed deadlines not made up */
+    uint32_t    max_late_us;    /* Longest delay past a deadline */
+    uint32_t    min_cycles;
+    uint32_t    max_cycles;
+    uint64_t    total_cycles;
+} stc_job_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void jobs_init(const stc_job_t *table, uint32_t count);
+void jobs_run(uint32_t time_budget_us, en_job_priority_t lowest);
+void jobs_get_stats(uint32_t index, stc_job_stats_t *stats);
+void jobs_print_stats(void);
+
+#endif /* SOURCE_JOBS_H_ */
+
+/* [] END OF FILE */
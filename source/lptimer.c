@@ -0,0 +1,330 @@
+/*******************************************************************************
+* File Name:   lptimer.c
+*
+* Description: This file implements a free-running low-power timer on MCWDT0.
+*              Counter 2 is the 32-bit timebase; counters 0 and 1 provide one-shot
+*              match interrupts that wake the CPU from DeepSleep.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "lptimer.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define LPTIMER_HW                  MCWDT_STRUCT0
+#define LPTIMER_IRQ                 srss_interrupt_mcwdt_0_IRQn
+#define LPTIMER_INTERRUPT_PRIORITY  (3u)
+#define LPTIMER_SYNC_DELAY_US       (93u)   /* 3 LFCLK cycles for register sync */
+#define LPTIMER_MIN_ARM_TICKS       (4u)    /* Shortest match past the sync delay */
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const cy_stc_mcwdt_config_t lptimer_config =
+{
+    .c0Match        = 0xFFFFu,
+    .c1Match        = 0xFFFFu,
+    .c0Mode         = CY_MCWDT_MODE_INT,
+    .c1Mode         = CY_MCWDT_MODE_INT,
+    .c2ToggleBit    = 31u,
+    .c2Mode         = CY_MCWDT_MODE_NONE,
+    .c0ClearOnMatch = false,
+    .c1ClearOnMatch = false,
+    .c0c1Cascade    = false,
+    .c1c2Cascade    = false
+};
+
+/* Counter and interrupt mask of each channel */
+static const cy_en_mcwdtctr_t lptimer_counter[LPTIMER_CH_COUNT] =
+{
+    CY_MCWDT_COUNTER0,
+    CY_MCWDT_COUNTER1
+};
+static const uint32_t lptimer_mask[LPTIMER_CH_COUNT] =
+{
+    CY_MCWDT_CTR0,
+    CY_MCWDT_CTR1
+};
+
+static uint32_t lptimer_target[LPTIMER_CH_COUNT];
+static volatile bool lptimer_expired[LPTIMER_CH_COUNT];
+static lptimer_callback_t lptimer_callback[LPTIMER_CH_COUNT];
+static volatile uint32_t lptimer_armed_mask = 0u;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void lptimer_program_match(en_lptimer_channel_t channel);
+static void lptimer_interrupt_handler(void);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: lptimer_init
+********************************************************************************
+* Summary:
+*  Configures MCWDT0 counter 2 as a free-running 32-bit timebase clocked from
+*  LFCLK, and counters 0 and 1 as one-shot match sources. The match interrupts
+*  stay masked until lptimer_arm() is called.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void lptimer_init(void)
+{
+    cy_stc_sysint_t lptimer_intr_config =
+    {
+        .intrSrc = LPTIMER_IRQ,
+        .intrPriority = LPTIMER_INTERRUPT_PRIORITY
+    };
+
+    if (CY_MCWDT_SUCCESS != Cy_MCWDT_Init(LPTIMER_HW, &lptimer_config))
+    {
+        CY_ASSERT(0);
+    }
+    Cy_MCWDT_SetInterruptMask(LPTIMER_HW, 0u);
+    Cy_MCWDT_Enable(LPTIMER_HW, CY_MCWDT_CTR0 | CY_MCWDT_CTR1 | CY_MCWDT_CTR2,
+                    LPTIMER_SYNC_DELAY_US);
+
+    Cy_SysInt_Init(&lptimer_intr_config, lptimer_interrupt_handler);
+    NVIC_ClearPendingIRQ(lptimer_intr_config.intrSrc);
+    NVIC_EnableIRQ(lptimer_intr_config.intrSrc);
+}
+
+/*******************************************************************************
+* Function Name: lptimer_now
+********************************************************************************
+* Summary:
+*  Returns the current value of the 32-bit timebase in LFCLK ticks. The value
+*  wraps every ~36 hours, so compare timestamps with unsigned subtraction.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t - current tick count
+*
+*******************************************************************************/
+uint32_t lptimer_now(void)
+{
+    return Cy_MCWDT_GetCount(LPTIMER_HW, CY_MCWDT_COUNTER2);
+}
+
+/*******************************************************************************
+* Function Name: lptimer_register_callback
+********************************************************************************
+* Summary:
+*  Registers a function called from the MCWDT interrupt when 'channel'
+*  expires. Pass NULL to only poll with lptimer_is_expired().
+*
+* Parameters:
+*  en_lptimer_channel_t channel - one-shot channel
+*  lptimer_callback_t callback  - expiry callback or NULL
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void lptimer_register_callback(en_lptimer_channel_t channel, lptimer_callback_t callback)
+{
+    lptimer_callback[channel] = callback;
+}
+
+/*******************************************************************************
+* Function Name: lptimer_arm
+********************************************************************************
+* Summary:
+*  Arms a one-shot interrupt at the absolute timebase value 'target'. Targets
+*  more than LPTIMER_MAX_ARM_TICKS ahead take several matches; the interrupt
+*  handler re-arms the counter until the target is reached. Targets already in
+*  the past expire after LPTIMER_MIN_ARM_TICKS.
+*
+* Parameters:
+*  en_lptimer_channel_t channel - one-shot channel
+*  uint32_t target              - absolute tick count at which to expire
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void lptimer_arm(en_lptimer_channel_t channel, uint32_t target)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    lptimer_target[channel] = target;
+    lptimer_expired[channel] = false;
+    lptimer_armed_mask |= lptimer_mask[channel];
+    lptimer_program_match(channel);
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/*******************************************************************************
+* Function Name: lptimer_disarm
+********************************************************************************
+* Summary:
+*  Cancels a pending one-shot interrupt.
+*
+* Parameters:
+*  en_lptimer_channel_t channel - one-shot channel
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void lptimer_disarm(en_lptimer_channel_t channel)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    lptimer_armed_mask &= ~lptimer_mask[channel];
+    Cy_MCWDT_SetInterruptMask(LPTIMER_HW, lptimer_armed_mask);
+    Cy_MCWDT_ClearInterrupt(LPTIMER_HW, lptimer_mask[channel]);
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/*******************************************************************************
+* Function Name: lptimer_is_expired
+********************************************************************************
+* Summary:
+*  Returns true once the armed one-shot interrupt has fired.
+*
+* Parameters:
+*  en_lptimer_channel_t channel - one-shot channel
+*
+* Return:
+*  bool - true if the target was reached since the last lptimer_arm()
+*
+*******************************************************************************/
+bool lptimer_is_expired(en_lptimer_channel_t channel)
+{
+    return lptimer_expired[channel];
+}
+
+/*******************************************************************************
+* Function Name: lptimer_program_match
+********************************************************************************
+* Summary:
+*  Programs the channel counter to match at the target, or at most
+*  LPTIMER_MAX_ARM_TICKS ahead. All counters tick from the same clock, so a
+*  match on the 16-bit counter lands on the same edge as the 32-bit target.
+*
+* Parameters:
+*  en_lptimer_channel_t channel - one-shot channel
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void lptimer_program_match(en_lptimer_channel_t channel)
+{
+    uint32_t delta = lptimer_target[channel] - lptimer_now();
+    uint32_t count;
+
+    if ((((int32_t)delta) <= 0) || (delta < LPTIMER_MIN_ARM_TICKS))
+    {
+        /* The match must land after the register write has synchronized */
+        delta = LPTIMER_MIN_ARM_TICKS;
+    }
+    else if (delta > LPTIMER_MAX_ARM_TICKS)
+    {
+        delta = LPTIMER_MAX_ARM_TICKS;
+    }
+
+    count = Cy_MCWDT_GetCount(LPTIMER_HW, lptimer_counter[channel]);
+    Cy_MCWDT_SetMatch(LPTIMER_HW, lptimer_counter[channel], (count + delta) & 0xFFFFu,
+                      LPTIMER_SYNC_DELAY_US);
+    Cy_MCWDT_ClearInterrupt(LPTIMER_HW, lptimer_mask[channel]);
+    Cy_MCWDT_SetInterruptMask(LPTIMER_HW, lptimer_armed_mask);
+}
+
+/*******************************************************************************
+* Function Name: lptimer_interrupt_handler
+********************************************************************************
+* Summary:
+*  MCWDT0 interrupt handler. Re-arms channels whose target is still ahead,
+*  otherwise masks the channel, flags expiry and calls its callback.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void lptimer_interrupt_handler(void)
+{
+    uint32_t status = Cy_MCWDT_GetInterruptStatusMasked(LPTIMER_HW);
+    uint32_t channel;
+
+    for (channel = 0u; channel < (uint32_t)LPTIMER_CH_COUNT; channel++)
+    {
+        if (0u == (status & lptimer_mask[channel]))
+        {
+            continue;
+        }
+
+        Cy_MCWDT_ClearInterrupt(LPTIMER_HW, lptimer_mask[channel]);
+        if (((int32_t)(lptimer_now() - lptimer_target[channel])) < 0)
+        {
+            lptimer_program_match((en_lptimer_channel_t)channel);
+        }
+        else
+        {
+            lptimer_armed_mask &= ~lptimer_mask[channel];
+            Cy_MCWDT_SetInterruptMask(LPTIMER_HW, lptimer_armed_mask);
+            lptimer_expired[channel] = true;
+            if (NULL != lptimer_callback[channel])
+            {
+                lptimer_callback[channel]();
+            }
+        }
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,88 @@
+/*******************************************************************************
+* File Name:   lptimer.h
+*
+* Description: This file contains the interface of the low-power timer built on
+*              the MCWDT block. The timer keeps counting in DeepSleep and is used
+*              for sub-second wakeups and timestamps.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_LPTIMER_H_
+#define SOURCE_LPTIMER_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define LPTIMER_CLOCK_HZ            (32768u) /* LFCLK frequency (ILO) */
+#define LPTIMER_MAX_ARM_TICKS       (0xFFF0u) /* Longest single match (~2 s) */
+
+/* Convert between LFCLK ticks and microseconds */
+#define LPTIMER_TICKS_TO_US(ticks)  ((uint32_t)(((uint64_t)(ticks) * 1000000u) / LPTIMER_CLOCK_HZ))
+#define LPTIMER_US_TO_TICKS(us)     ((uint32_t)((((uint64_t)(us) * LPTIMER_CLOCK_HZ) + 999999u) / 1000000u))
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* One-shot channels. Each channel maps to a 16-bit MCWDT counter. */
+typedef enum
+{
+    LPTIMER_CH_WAKE     = 0u,   /* Counter 0: pre-armed DeepSleep wakeup */
+    LPTIMER_CH_AUX      = 1u,   /* Counter 1: user button gesture timeouts */
+    LPTIMER_CH_COUNT    = 2u,
+} en_lptimer_channel_t;
+
+/* Called from the MCWDT interrupt when a channel expires */
+typedef void (*lptimer_callback_t)(void);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void lptimer_init(void);
+uint32_t lptimer_now(void);
+void lptimer_register_callback(en_lptimer_channel_t channel, lptimer_callback_t callback);
+void lptimer_arm(en_lptimer_channel_t channel, uint32_t target);
+void lptimer_disarm(en_lptimer_channel_t channel);
+bool lptimer_is_expired(en_lptimer_channel_t channel);
+
+#endif /* SOURCE_LPTIMER_H_ */
+
+/* [] END OF FILE */
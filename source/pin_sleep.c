@@ -0,0 +1,461 @@
+/*******************************************************************************
+* File Name:   pin_sleep.c
+*
+* Description: This file contains the pin manager for the low-power modes. Before
+*              DeepSleep it saves the routing, drive mode and output of the board
+*              pins and applies a low-leakage profile to each; right after the
+*              wakeup it restores them. Before Hibernate it applies the profiles
+*              only: Hibernate freezes the pins in that state and the boot path
+*              configures them again.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdio.h>
+#include "cybsp.h"
+#include "pin_sleep.h"
+#include "cycles.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Runs after the other callbacks before the transition, first after it */
+#define PIN_SLEEP_CALLBACK_ORDER    (255u)
+
+#if (0u != PIN_SLEEP_KEEP_DEBUG)
+#define PIN_SLEEP_DEBUG_HIBERNATE   (PIN_PROFILE_KEEP)
+#else
+#define PIN_SLEEP_DEBUG_HIBERNATE   (PIN_PROFILE_ANALOG)
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    en_hsiom_sel_t  hsiom;
+    uint32_t        drive_mode;
+    uint32_t        out;
+} stc_pin_saved_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Board pins configured in design.modus. The ECO pins are analog already. */
+static const stc_pin_sleep_t pin_table[] =
+{
+    /* name      port                       pin                       DeepSleep              Hibernate */
+    /* The RX edge wakes DeepSleep; the pull-up holds the idle level without a host */
+    { "uart rx", CYBSP_DEBUG_UART_RX_PORT,  CYBSP_DEBUG_UART_RX_PIN,  PIN_PROFILE_PULLUP,    PIN_PROFILE_ANALOG },
+    /* Hold the idle level so that the host sees no start bit */
+    { "uart tx", CYBSP_DEBUG_UART_TX_PORT,  CYBSP_DEBUG_UART_TX_PIN,  PIN_PROFILE_HOLD_HIGH, PIN_PROFILE_ANALOG },
+    /* SW2 wakes both modes */
+    { "sw2",     CYBSP_USER_BTN2_PORT,      CYBSP_USER_BTN2_PIN,      PIN_PROFILE_KEEP,      PIN_PROFILE_KEEP },
+    /* A probe stays attached through DeepSleep */
+    { "swdck",   CYBSP_SWDCK_PORT,          CYBSP_SWDCK_PIN,          PIN_PROFILE_KEEP,      PIN_SLEEP_DEBUG_HIBERNATE },
+    { "swdio",   CYBSP_SWDIO_PORT,          CYBSP_SWDIO_PIN,          PIN_PROFILE_KEEP,      PIN_SLEEP_DEBUG_HIBERNATE },
+};
+
+#define PIN_SLEEP_COUNT             (sizeof(pin_table) / sizeof(pin_table[0]))
+
+static stc_pin_saved_t pin_saved[PIN_SLEEP_COUNT];
+static stc_pin_sleep_stats_t pin_stats;
+
+static cy_stc_syspm_callback_params_t pin_pm_params =
+{
+    .base       = NULL,
+    .context    = NULL
+};
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void pin_sleep_apply(uint32_t index, en_pin_profile_t profile);
+static uint32_t pin_sleep_profile_na(en_pin_profile_t profile, uint32_t drive_mode);
+static cy_en_syspm_status_t pin_sleep_deepsleep_callback(cy_stc_syspm_callback_params_t *params,
+                                                         cy_en_syspm_callback_mode_t mode);
+static cy_en_syspm_status_t pin_sleep_hibernate_callback(cy_stc_syspm_callback_params_t *params,
+                                                         cy_en_syspm_callback_mode_t mode);
+
+static cy_stc_syspm_callback_t pin_deepsleep_callback =
+{
+    .callback       = pin_sleep_deepsleep_callback,
+    .type           = CY_SYSPM_DEEPSLEEP,
+    .skipMode       = 0u,
+    .callbackParams = &pin_pm_params,
+    .prevItm        = NULL,
+    .nextItm        = NULL,
+    .order          = PIN_SLEEP_CALLBACK_ORDER
+};
+
+static cy_stc_syspm_callback_t pin_hibernate_callback =
+{
+    .callback       = pin_sleep_hibernate_callback,
+    .type           = CY_SYSPM_HIBERNATE,
+    .skipMode       = 0u,
+    .callbackParams = &pin_pm_params,
+    .prevItm        = NULL,
+    .nextItm        = NULL,
+    .order          = PIN_SLEEP_CALLBACK_ORDER
+};
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: pin_sleep_init
+********************************************************************************
+* Summary:
+*  Registers the DeepSleep and Hibernate callbacks that apply the pin
+*  profiles. Call after the pins are configured and the I/O unfrozen.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void pin_sleep_init(void)
+{
+    cycles_init();
+
+    if ((!Cy_SysPm_RegisterCallback(&pin_deepsleep_callback)) ||
+        (!Cy_SysPm_RegisterCallback(&pin_hibernate_callback)))
+    {
+        CY_ASSERT(0);
+    }
+}
+
+/*******************************************************************************
+* Function Name: pin_sleep_model_na
+********************************************************************************
+* Summary:
+*  Returns the modeled current of an unconnected pin in a low-power mode.
+*  A drive mode with the input buffer off leaks at the pad only; with the
+*  buffer on, a pull or a drive holds the level, and high-Z leaves the line
+*  floating.
+*
+* Parameters:
+*  uint32_t drive_mode - CY_GPIO_DM_xxx
+*
+* Return:
+*  uint32_t - current in nA
+*
+*******************************************************************************/
+uint32_t pin_sleep_model_na(uint32_t drive_mode)
+{
+    uint32_t current_na;
+
+    if ((CY_GPIO_DM_ANALOG == drive_mode) || (0u == (drive_mode & CY_GPIO_DM_HIGHZ)))
+    {
+        current_na = PIN_LEAK_PAD_NA;
+    }
+    else if (CY_GPIO_DM_HIGHZ == drive_mode)
+    {
+        current_na = PIN_LEAK_FLOAT_NA;
+    }
+    else
+    {
+        current_na = PIN_LEAK_BUFFER_NA;
+    }
+
+    return current_na;
+}
+
+/*******************************************************************************
+* Function Name: pin_sleep_get_stats
+********************************************************************************
+* Summary:
+*  Copies the DeepSleep entry and restore statistics.
+*
+* Parameters:
+*  stc_pin_sleep_stats_t *stats - destination
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void pin_sleep_get_stats(stc_pin_sleep_stats_t *stats)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    *stats = pin_stats;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/*******************************************************************************
+* Function Name: pin_sleep_print
+********************************************************************************
+* Summary:
+*  Prints the profile of each pin and the modeled current as configured, in
+*  DeepSleep and in Hibernate, with the totals and the restore time.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void pin_sleep_print(void)
+{
+    static const char *const profile_names[PIN_PROFILE_COUNT] = { "keep", "analog", "pullup", "hold" };
+    stc_pin_sleep_stats_t stats;
+    uint32_t drive_mode;
+    uint32_t active_na;
+    uint32_t deepsleep_na;
+    uint32_t hibernate_na;
+    uint32_t total_active_na = 0u;
+    uint32_t total_deepsleep_na = 0u;
+    uint32_t total_hibernate_na = 0u;
+    uint32_t i;
+
+    printf("Pin      DeepSleep  Hibernate   as is nA  DeepSleep nA  Hibernate nA\r\n");
+    for (i = 0u; i < PIN_SLEEP_COUNT; i++)
+    {
+        drive_mode = Cy_GPIO_GetDrivemode(pin_table[i].port, pin_table[i].pin);
+        active_na = pin_sleep_model_na(drive_mode);
+        deepsleep_na = pin_sleep_profile_na(pin_table[i].deepsleep, drive_mode);
+        hibernate_na = pin_sleep_profile_na(pin_table[i].hibernate, drive_mode);
+        total_active_na += active_na;
+        total_deepsleep_na += deepsleep_na;
+        total_hibernate_na += hibernate_na;
+
+        printf("%-8s %-10s %-10s %9lu %13lu %13lu\r\n", pin_table[i].name,
+               profile_names[pin_table[i].deepsleep], profile_names[pin_table[i].hibernate],
+               (unsigned long)active_na, (unsigned long)deepsleep_na, (unsigned long)hibernate_na);
+    }
+    printf("%-30s %9lu %13lu %13lu\r\n", "total", (unsigned long)total_active_na,
+           (unsigned long)total_deepsleep_na, (unsigned long)total_hibernate_na);
+
+    pin_sleep_get_stats(&stats);
+    printf("Pins: %lu DeepSleep entries, restore %lu cycles (max %lu)\r\n",
+           (unsigned long)stats.applies, (unsigned long)stats.restore_cycles,
+           (unsigned long)stats.max_restore_cycles);
+}
+
+/*******************************************************************************
+* Function Name: pin_sleep_apply
+********************************************************************************
+* Summary:
+*  Puts one pin in a profile. The pin becomes a GPIO unless the profile keeps
+*  it as configured.
+*
+* Parameters:
+*  uint32_t index           - entry of 'pin_table'
+*  en_pin_profile_t profile - state to apply
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void pin_sleep_apply(uint32_t index, en_pin_profile_t profile)
+{
+    GPIO_PRT_Type *port = pin_table[index].port;
+    uint32_t pin = pin_table[index].pin;
+
+    switch (profile)
+    {
+        case PIN_PROFILE_ANALOG:
+            Cy_GPIO_SetDrivemode(port, pin, CY_GPIO_DM_ANALOG);
+            Cy_GPIO_SetHSIOM(port, pin, HSIOM_SEL_GPIO);
+            break;
+
+        case PIN_PROFILE_PULLUP:
+            Cy_GPIO_Write(port, pin, 1u);
+            Cy_GPIO_SetDrivemode(port, pin, CY_GPIO_DM_PULLUP);
+            Cy_GPIO_SetHSIOM(port, pin, HSIOM_SEL_GPIO);
+            break;
+
+        case PIN_PROFILE_HOLD_HIGH:
+            Cy_GPIO_Write(port, pin, 1u);
+            Cy_GPIO_SetDrivemode(port, pin, CY_GPIO_DM_STRONG_IN_OFF);
+            Cy_GPIO_SetHSIOM(port, pin, HSIOM_SEL_GPIO);
+            break;
+
+        default:
+            break;
+    }
+}
+
+/*******************************************************************************
+* Function Name: pin_sleep_profile_na
+********************************************************************************
+* Summary:
+*  Returns the modeled current of a pin in a profile.
+*
+* Parameters:
+*  en_pin_profile_t profile - low-power profile
+*  uint32_t drive_mode      - configured drive mode, for PIN_PROFILE_KEEP
+*
+* Return:
+*  uint32_t - current in nA
+*
+*******************************************************************************/
+static uint32_t pin_sleep_profile_na(en_pin_profile_t profile, uint32_t drive_mode)
+{
+    uint32_t current_na;
+
+    switch (profile)
+    {
+        case PIN_PROFILE_ANALOG:
+            current_na = pin_sleep_model_na(CY_GPIO_DM_ANALOG);
+            break;
+        case PIN_PROFILE_PULLUP:
+            current_na = pin_sleep_model_na(CY_GPIO_DM_PULLUP);
+            break;
+        case PIN_PROFILE_HOLD_HIGH:
+            current_na = pin_sleep_model_na(CY_GPIO_DM_STRONG_IN_OFF);
+            break;
+        default:
+            current_na = pin_sleep_model_na(drive_mode);
+            break;
+    }
+
+    return current_na;
+}
+
+/*******************************************************************************
+* Function Name: pin_sleep_deepsleep_callback
+********************************************************************************
+* Summary:
+*  DeepSleep callback. Saves the pins and applies their DeepSleep profiles
+*  right before the transition, and restores them first after the wakeup.
+*  The GPIO interrupt configuration is left alone, so the RX and button edges
+*  still wake the device.
+*
+* Parameters:
+*  cy_stc_syspm_callback_params_t *params - unused
+*  cy_en_syspm_callback_mode_t mode       - transition phase
+*
+* Return:
+*  cy_en_syspm_status_t - always CY_SYSPM_SUCCESS
+*
+*******************************************************************************/
+static cy_en_syspm_status_t pin_sleep_deepsleep_callback(cy_stc_syspm_callback_params_t *params,
+                                                         cy_en_syspm_callback_mode_t mode)
+{
+    uint32_t start;
+    uint32_t cycles;
+    uint32_t i;
+
+    CY_UNUSED_PARAMETER(params);
+
+    switch (mode)
+    {
+        case CY_SYSPM_BEFORE_TRANSITION:
+            for (i = 0u; i < PIN_SLEEP_COUNT; i++)
+            {
+                if (PIN_PROFILE_KEEP != pin_table[i].deepsleep)
+                {
+                    pin_saved[i].hsiom = Cy_GPIO_GetHSIOM(pin_table[i].port, pin_table[i].pin);
+                    pin_saved[i].drive_mode = Cy_GPIO_GetDrivemode(pin_table[i].port, pin_table[i].pin);
+                    pin_saved[i].out = Cy_GPIO_ReadOut(pin_table[i].port, pin_table[i].pin);
+                    pin_sleep_apply(i, pin_table[i].deepsleep);
+                }
+            }
+            pin_stats.applies++;
+            break;
+
+        case CY_SYSPM_AFTER_TRANSITION:
+            start = cycles_now();
+            for (i = 0u; i < PIN_SLEEP_COUNT; i++)
+            {
+                if (PIN_PROFILE_KEEP != pin_table[i].deepsleep)
+                {
+                    Cy_GPIO_Write(pin_table[i].port, pin_table[i].pin, pin_saved[i].out);
+                    Cy_GPIO_SetDrivemode(pin_table[i].port, pin_table[i].pin, pin_saved[i].drive_mode);
+                    Cy_GPIO_SetHSIOM(pin_table[i].port, pin_table[i].pin, pin_saved[i].hsiom);
+                }
+            }
+            cycles = cycles_now() - start;
+            pin_stats.restore_cycles = cycles;
+            if (cycles > pin_stats.max_restore_cycles)
+            {
+                pin_stats.max_restore_cycles = cycles;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return CY_SYSPM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: pin_sleep_hibernate_callback
+********************************************************************************
+* Summary:
+*  Hibernate callback. Applies the Hibernate profiles right before the
+*  transition; Hibernate then freezes the pins. There is no restore: the
+*  wakeup is a reset, and the boot path configures the pins and unfreezes
+*  them.
+*
+* Parameters:
+*  cy_stc_syspm_callback_params_t *params - unused
+*  cy_en_syspm_callback_mode_t mode       - transition phase
+*
+* Return:
+*  cy_en_syspm_status_t - always CY_SYSPM_SUCCESS
+*
+*******************************************************************************/
+static cy_en_syspm_status_t pin_sleep_hibernate_callback(cy_stc_syspm_callback_params_t *params,
+                                                         cy_en_syspm_callback_mode_t mode)
+{
+    uint32_t i;
+
+    CY_UNUSED_PARAMETER(params);
+
+    if (CY_SYSPM_BEFORE_TRANSITION == mode)
+    {
+        for (i = 0u; i < PIN_SLEEP_COUNT; i++)
+        {
+            pin_sleep_apply(i, pin_table[i].hibernate);
+        }
+    }
+
+    return CY_SYSPM_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,106 @@
+/*******************************************************************************
+* File Name:   pin_sleep.h
+*
+* Description: This file contains the interface of the pin manager that puts the
+*              board pins in low-leakage states for DeepSleep and Hibernate.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_PIN_SLEEP_H_
+#define SOURCE_PIN_SLEEP_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* 1: the SWD pins stay configured in Hibernate, so a probe can reattach */
+#ifndef PIN_SLEEP_KEEP_DEBUG
+#define PIN_SLEEP_KEEP_DEBUG        (1u)
+#endif
+
+/* Modeled current of one pin in a low-power mode, with the line unconnected
+   (debugger unpowered). From the GPIO leakage of the datasheet: the pad
+   leaks nanoamperes, an input buffer with a defined level adds a little, and
+   an input buffer on a floating line draws crossbar current. */
+#define PIN_LEAK_PAD_NA             (1u)        /* Input buffer off */
+#define PIN_LEAK_BUFFER_NA          (10u)       /* Input buffer on, level held */
+#define PIN_LEAK_FLOAT_NA           (20000u)    /* Input buffer on, line floating */
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* State of a pin in a low-power mode */
+typedef enum
+{
+    PIN_PROFILE_KEEP        = 0u,   /* As configured; needed by a wake source */
+    PIN_PROFILE_ANALOG      = 1u,   /* Input buffer off, no drive */
+    PIN_PROFILE_PULLUP      = 2u,   /* GPIO input pulled to its idle high level */
+    PIN_PROFILE_HOLD_HIGH   = 3u,   /* GPIO driving its idle high level, input off */
+    PIN_PROFILE_COUNT       = 4u,
+} en_pin_profile_t;
+
+typedef struct
+{
+    const char          *name;
+    GPIO_PRT_Type       *port;
+    uint32_t            pin;
+    en_pin_profile_t    deepsleep;      /* Profile in DeepSleep */
+    en_pin_profile_t    hibernate;      /* Profile in Hibernate, frozen */
+} stc_pin_sleep_t;
+
+typedef struct
+{
+    uint32_t    applies;            /* DeepSleep entries with the profiles */
+    uint32_t    restore_cycles;     /* Last restore after the wakeup */
+    uint32_t    max_restore_cycles;
+} stc_pin_sleep_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void pin_sleep_init(void);
+uint32_t pin_sleep_model_na(uint32_t drive_mode);
+void pin_sleep_get_stats(stc_pin_sleep_stats_t *stats);
+void pin_sleep_print(void);
+
+#endif /* SOURCE_PIN_SLEEP_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,166 @@
+/*******************************************************************************
+* File Name:   processing.c
+*
+* Description: This file implements the batch processing stage. The samples of a
+*              batch pass an 8-tap low-pass FIR filter; mean, RMS, min/max and
+*              threshold crossings of the filtered signal are accumulated, so the
+*              batch can be reported and stored as a few numbers.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "processing.h"
+#include "sampler.h"
+#include "cycles.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define PROCESSING_TAPS             (8u)
+#define PROCESSING_HISTORY          (PROCESSING_TAPS - 1u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Binomial-like low pass, Q15, unity gain: {1, 3, 6, 8, 8, 6, 3, 1} / 36 */
+static const int16_t fir_coeffs[PROCESSING_TAPS] =
+{
+    910, 2731, 5461, 7282, 7282, 5461, 2731, 910
+};
+
+/* Filter input: history, then the block being filtered */
+static int16_t fir_input[PROCESSING_HISTORY + SAMPLER_BLOCK_SIZE];
+static int16_t fir_output[SAMPLER_BLOCK_SIZE];
+static bool history_valid;
+static stc_dsp_features_t batch_features;
+static uint32_t batch_cycles;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: processing_begin
+********************************************************************************
+* Summary:
+*  Starts a batch.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void processing_begin(void)
+{
+    dsp_features_reset(&batch_features);
+    history_valid = false;
+    batch_cycles = 0u;
+}
+
+/*******************************************************************************
+* Function Name: processing_add
+********************************************************************************
+* Summary:
+*  Filters samples of the batch and adds them to the features. The filter
+*  history starts filled with the first sample, so there is no step at the
+*  start of the batch.
+*
+* Parameters:
+*  const int16_t *samples - samples, in order
+*  uint32_t count         - number of samples
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void processing_add(const int16_t *samples, uint32_t count)
+{
+    uint32_t start = cycles_now();
+    uint32_t chunk, i;
+
+    if ((0u != count) && (!history_valid))
+    {
+        for (i = 0u; i < PROCESSING_HISTORY; i++)
+        {
+            fir_input[i] = samples[0];
+        }
+        history_valid = true;
+    }
+
+    while (0u != count)
+    {
+        chunk = (count < SAMPLER_BLOCK_SIZE) ? count : SAMPLER_BLOCK_SIZE;
+        memcpy(&fir_input[PROCESSING_HISTORY], samples, chunk * sizeof(int16_t));
+        dsp_fir(&fir_input[PROCESSING_HISTORY], fir_output, chunk, fir_coeffs, PROCESSING_TAPS);
+        dsp_features_update(&batch_features, fir_output, chunk, PROCESSING_THRESHOLD);
+
+        /* The last inputs are the history of the next chunk */
+        memmove(fir_input, &fir_input[chunk], PROCESSING_HISTORY * sizeof(int16_t));
+        samples += chunk;
+        count -= chunk;
+    }
+
+    batch_cycles += cycles_now() - start;
+}
+
+/*******************************************************************************
+* Function Name: processing_end
+********************************************************************************
+* Summary:
+*  Returns the features of the batch and the cycles spent on it.
+*
+* Parameters:
+*  stc_dsp_features_t *features - destination
+*  uint32_t *cycles             - destination
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void processing_end(stc_dsp_features_t *features, uint32_t *cycles)
+{
+    *features = batch_features;
+    *cycles = batch_cycles;
+}
+
+/* [] END OF FILE */
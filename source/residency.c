@@ -0,0 +1,217 @@
+/*******************************************************************************
+* File Name:   residency.c
+*
+* Description: Time spent in each CPU power mode, and the average supply
+*              current it implies under the energy model.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "residency.h"
+#include "lptimer.h"
+#include "energy_model.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const uint32_t mode_current_ua[POWER_MODE_COUNT] =
+{
+    ENERGY_ACTIVE_UA,
+    ENERGY_SLEEP_UA,
+    ENERGY_DEEPSLEEP_UA
+};
+
+static const char *const mode_names[POWER_MODE_COUNT] = { "active", "sleep", "deepsleep" };
+
+static stc_residency_t residency;
+static en_power_mode_t current_mode = POWER_MODE_ACTIVE;
+static uint32_t mode_since;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: residency_init
+********************************************************************************
+* Summary:
+*  Clears the counters and starts accounting in Active mode. The low-power
+*  timer must be running.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void residency_init(void)
+{
+    memset(&residency, 0, sizeof(residency));
+    current_mode = POWER_MODE_ACTIVE;
+    mode_since = lptimer_now();
+}
+
+/*******************************************************************************
+* Function Name: residency_enter
+********************************************************************************
+* Summary:
+*  Charges the time since the last call to the previous mode and switches to
+*  'mode'. Call right before a low-power entry with the mode entered, and
+*  right after it with POWER_MODE_ACTIVE.
+*
+* Parameters:
+*  en_power_mode_t mode - mode entered
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void residency_enter(en_power_mode_t mode)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+    uint32_t now = lptimer_now();
+
+    residency.ticks[current_mode] += now - mode_since;
+    mode_since = now;
+    current_mode = mode;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/*******************************************************************************
+* Function Name: residency_get
+********************************************************************************
+* Summary:
+*  Copies the counters, including the time spent so far in the current mode.
+*
+* Parameters:
+*  stc_residency_t *dest - destination
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void residency_get(stc_residency_t *dest)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    *dest = residency;
+    dest->ticks[current_mode] += lptimer_now() - mode_since;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/*******************************************************************************
+* Function Name: residency_average_na
+********************************************************************************
+* Summary:
+*  Returns the average supply current over the counted time, weighting the
+*  current of each mode in energy_model.h by its residency.
+*
+* Parameters:
+*  const stc_residency_t *counters - counters
+*
+* Return:
+*  uint32_t - average current in nA, 0 if no time was counted
+*
+*******************************************************************************/
+uint32_t residency_average_na(const stc_residency_t *counters)
+{
+    uint64_t total = 0u;
+    uint64_t charge = 0u;   /* uA x ticks */
+    uint32_t mode;
+
+    for (mode = 0u; mode < (uint32_t)POWER_MODE_COUNT; mode++)
+    {
+        total += counters->ticks[mode];
+        charge += counters->ticks[mode] * mode_current_ua[mode];
+    }
+    if (0u == total)
+    {
+        return 0u;
+    }
+
+    return (uint32_t)(((charge / total) * 1000u) + (((charge % total) * 1000u) / total));
+}
+
+/*******************************************************************************
+* Function Name: residency_print
+********************************************************************************
+* Summary:
+*  Prints the share of time in each mode and the average current.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void residency_print(void)
+{
+    stc_residency_t counters;
+    uint64_t total = 0u;
+    uint32_t mode, share;
+
+    residency_get(&counters);
+    for (mode = 0u; mode < (uint32_t)POWER_MODE_COUNT; mode++)
+    {
+        total += counters.ticks[mode];
+    }
+    if (0u == total)
+    {
+        return;
+    }
+
+    printf("Residency over %lu s:", (unsigned long)(total / LPTIMER_CLOCK_HZ));
+    for (mode = 0u; mode < (uint32_t)POWER_MODE_COUNT; mode++)
+    {
+        /* Per mille, printed as a percentage with one decimal */
+        share = (uint32_t)((counters.ticks[mode] * 1000u) / total);
+        printf(" %s %lu.%lu%%", mode_names[mode], (unsigned long)(share / 10u),
+               (unsigned long)(share % 10u));
+    }
+    printf(", average %lu nA\r\n", (unsigned long)residency_average_na(&counters));
+}
+
+/* [] END OF FILE */
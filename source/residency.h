@@ -0,0 +1,79 @@
+/*******************************************************************************
+* File Name:   residency.h
+*
+* Description: Time spent in each CPU power mode, and the average supply
+*              current it implies under the energy model.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_RESIDENCY_H_
+#define SOURCE_RESIDENCY_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef enum
+{
+    POWER_MODE_ACTIVE       = 0u,
+    POWER_MODE_SLEEP        = 1u,
+    POWER_MODE_DEEPSLEEP    = 2u,
+    POWER_MODE_COUNT        = 3u,
+} en_power_mode_t;
+
+/* Low-power timer ticks spent in each mode */
+typedef struct
+{
+    uint64_t    ticks[POWER_MODE_COUNT];
+} stc_residency_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void residency_init(void);
+void residency_enter(en_power_mode_t mode);
+void residency_get(stc_residency_t *dest);
+uint32_t residency_average_na(const stc_residency_t *counters);
+void residency_print(void);
+
+#endif /* SOURCE_RESIDENCY_H_ */
+
+/* [] END OF FILE */
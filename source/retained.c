@@ -0,0 +1,152 @@
+/*******************************************************************************
+* File Name:   retained.c
+*
+* Description: This file implements the retained storage in the backup
+*              registers. The slots are cleared on the first boot after the
+*              backup domain lost power or after the layout changed.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "retained.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define RETAINED_MAGIC              (0x52545704uL) /* "RTW" + layout version */
+
+/* Backup register holding slot 'slot' */
+#define RETAINED_BREG(slot)         (BACKUP->BREG[(slot)])
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: retained_init
+********************************************************************************
+* Summary:
+*  Validates the retained storage and clears all slots if the signature does
+*  not match.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void retained_init(void)
+{
+    uint32_t slot;
+
+    if (RETAINED_MAGIC != RETAINED_BREG(RETAINED_SLOT_MAGIC))
+    {
+        for (slot = 0u; slot < (uint32_t)RETAINED_SLOT_COUNT; slot++)
+        {
+            RETAINED_BREG(slot) = 0u;
+        }
+        RETAINED_BREG(RETAINED_SLOT_MAGIC) = RETAINED_MAGIC;
+    }
+}
+
+/*******************************************************************************
+* Function Name: retained_read
+********************************************************************************
+* Summary:
+*  Reads a retained slot.
+*
+* Parameters:
+*  en_retained_slot_t slot - slot to read
+*
+* Return:
+*  uint32_t - slot value
+*
+*******************************************************************************/
+uint32_t retained_read(en_retained_slot_t slot)
+{
+    return RETAINED_BREG(slot);
+}
+
+/*******************************************************************************
+* Function Name: retained_write
+********************************************************************************
+* Summary:
+*  Writes a retained slot.
+*
+* Parameters:
+*  en_retained_slot_t slot - slot to write
+*  uint32_t value          - new value
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void retained_write(en_retained_slot_t slot, uint32_t value)
+{
+    RETAINED_BREG(slot) = value;
+}
+
+/*******************************************************************************
+* Function Name: retained_increment
+********************************************************************************
+* Summary:
+*  Increments a retained counter slot, saturating at UINT32_MAX.
+*
+* Parameters:
+*  en_retained_slot_t slot - slot to increment
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void retained_increment(en_retained_slot_t slot)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    if (UINT32_MAX != RETAINED_BREG(slot))
+    {
+        RETAINED_BREG(slot) = RETAINED_BREG(slot) + 1u;
+    }
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,80 @@
+/*******************************************************************************
+* File Name:   retained.h
+*
+* Description: This file contains the layout and interface of the retained
+*              storage in the backup registers. The backup domain keeps its
+*              contents in DeepSleep and Hibernate.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_RETAINED_H_
+#define SOURCE_RETAINED_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Backup register slots. Add new slots before RETAINED_SLOT_COUNT. */
+typedef enum
+{
+    RETAINED_SLOT_MAGIC         = 0u,   /* Layout signature */
+    RETAINED_SLOT_RESET_CAUSE   = 1u,   /* Reset reason of the last boot */
+    RETAINED_SLOT_WDT_RESETS    = 2u,   /* Number of watchdog resets */
+    RETAINED_SLOT_MISSED_WAKES  = 3u,   /* Alarm wakeups seen missing */
+    RETAINED_SLOT_TIME_US_LO    = 4u,   /* Timebase before Hibernate, low word */
+    RETAINED_SLOT_TIME_US_HI    = 5u,   /* Timebase before Hibernate, high word */
+    RETAINED_SLOT_TIME_RTC      = 6u,   /* RTC seconds before Hibernate, 0 if none */
+    RETAINED_SLOT_UPLINK_LOG    = 7u,   /* Flash log position acked by the host */
+    RETAINED_SLOT_ENERGY        = 8u,   /* Energy bucket before Hibernate, 0 if none */
+    RETAINED_SLOT_COUNT         = 9u,
+} en_retained_slot_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void retained_init(void);
+uint32_t retained_read(en_retained_slot_t slot);
+void retained_write(en_retained_slot_t slot, uint32_t value);
+void retained_increment(en_retained_slot_t slot);
+
+#endif /* SOURCE_RETAINED_H_ */
+
+/* [] END OF FILE */
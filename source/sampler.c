@@ -0,0 +1,367 @@
+/*******************************************************************************
+* File Name:   sampler.c
+*
+* Description: This file implements the ADC sampling stage. Each RTC alarm wakeup
+*              converts one HPPASS SAR channel. Blocks of samples are compressed
+*              into a byte ring in SRAM, which DeepSleep retains. The rest of
+*              the system is woken only when a batch is full or a sample is out
+*              of the window.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "cybsp.h"
+#include "sampler.h"
+#include "cycles.h"
+#include "trace.h"
+#include "sram_retain.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* HPPASS is configured in the Device Configurator (pass_0 in design.modus).
+   SAR group 0 converts CYBSP_POT on firmware trigger 0. Without it, every
+   alarm would wake the system: build without the ADC only on request. */
+#ifndef SAMPLER_ADC_ENABLED
+#if defined(pass_0_ENABLED)
+#define SAMPLER_ADC_ENABLED         (1u)
+#else
+#error "No HPPASS (pass_0) in design.modus: add it, or set SAMPLER_ADC_ENABLED=0u to wake on every alarm"
+#endif
+#endif
+
+#define SAMPLER_CHANNEL             (12u)   /* pass[0].sar[0].ch[12], CYBSP_POT */
+#define SAMPLER_TRIGGER             (CY_HPPASS_TRIG_0_MSK)
+#define SAMPLER_AC_START_US         (1000u) /* Autonomous controller start timeout */
+#define SAMPLER_CONVERT_TIMEOUT_US  (100u)
+
+#define SAMPLER_BATCH_TRIPPED       (0x80000000uL)
+
+/* Store record: one length byte, then the coded block */
+#define SAMPLER_STORE_MASK          (SAMPLER_STORE_SIZE - 1u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Block being collected */
+static int16_t sample_block[SAMPLER_BLOCK_SIZE] SRAM_RETAIN;
+static uint32_t block_count = 0u;
+
+/* Coded blocks, oldest first */
+static uint8_t sample_store[SAMPLER_STORE_SIZE] SRAM_RETAIN;
+static uint32_t store_head = 0u;    /* Next write, free-running */
+static uint32_t store_tail = 0u;    /* Next read, free-running */
+static uint32_t store_samples = 0u; /* Samples in the store */
+
+static uint32_t batch_samples = 0u; /* Samples since the last system wakeup */
+static stc_sampler_stats_t sampler_stats;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static bool sampler_convert(int16_t *value);
+static void sampler_flush_block(void);
+static void store_drop_oldest(void);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: sampler_init
+********************************************************************************
+* Summary:
+*  Initializes HPPASS and starts its autonomous controller. Without a pass_0
+*  configuration the stage is disabled and every alarm wakes the system.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void sampler_init(void)
+{
+    memset(&sampler_stats, 0, sizeof(sampler_stats));
+
+#if (1u == SAMPLER_ADC_ENABLED)
+    if ((CY_HPPASS_SUCCESS != Cy_HPPASS_Init(&pass_0_config)) ||
+        (CY_HPPASS_SUCCESS != Cy_HPPASS_AC_Start(0u, SAMPLER_AC_START_US)))
+    {
+        CY_ASSERT(0);
+        return;
+    }
+    sampler_stats.adc_enabled = true;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: sampler_run
+********************************************************************************
+* Summary:
+*  Sampling stage of an RTC alarm wakeup. Converts one sample and stores it;
+*  a full block is compressed into the store. Call from the DeepSleep wakeup
+*  path, before anything else is started.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - true if the rest of the system should wake: the batch is full, a
+*         sample is outside the threshold window, or the ADC is unavailable
+*
+*******************************************************************************/
+bool sampler_run(void)
+{
+    uint32_t start = cycles_now();
+    uint32_t cost;
+    int16_t value;
+    bool wake = false;
+
+    if (!sampler_convert(&value))
+    {
+        return true;
+    }
+
+    sample_block[block_count++] = value;
+    if (SAMPLER_BLOCK_SIZE == block_count)
+    {
+        sampler_flush_block();
+    }
+    batch_samples++;
+    sampler_stats.samples++;
+    sampler_stats.last_value = value;
+
+    if ((value < SAMPLER_THRESHOLD_LOW) || (value > SAMPLER_THRESHOLD_HIGH))
+    {
+        sampler_stats.threshold_trips++;
+        trace_record(TRACE_EVENT_BATCH, batch_samples | SAMPLER_BATCH_TRIPPED);
+        wake = true;
+    }
+    else if (batch_samples >= SAMPLER_BATCH_SIZE)
+    {
+        sampler_stats.batches++;
+        trace_record(TRACE_EVENT_BATCH, batch_samples);
+        wake = true;
+    }
+    else
+    {
+        /* Keep sleeping */
+    }
+    if (wake)
+    {
+        batch_samples = 0u;
+    }
+
+    cost = cycles_now() - start;
+    if (cost > sampler_stats.convert_cycles)
+    {
+        sampler_stats.convert_cycles = cost;
+    }
+
+    return wake;
+}
+
+/*******************************************************************************
+* Function Name: sampler_read_block
+********************************************************************************
+* Summary:
+*  Moves the oldest coded block out of the store. Once the store is empty, the
+*  block being collected is coded and moved as well. Decode the block with
+*  compress_block_decode().
+*
+* Parameters:
+*  uint8_t *block - destination, SAMPLER_CODED_BLOCK_MAX bytes
+*  uint32_t size  - capacity of 'block'
+*
+* Return:
+*  uint32_t - bytes of the coded block, 0 if there are no samples
+*
+*******************************************************************************/
+uint32_t sampler_read_block(uint8_t *block, uint32_t size)
+{
+    uint32_t length, i;
+
+    if ((store_tail == store_head) && (0u != block_count))
+    {
+        sampler_flush_block();
+    }
+    if (store_tail == store_head)
+    {
+        return 0u;
+    }
+
+    length = sample_store[store_tail & SAMPLER_STORE_MASK];
+    if (length > size)
+    {
+        return 0u;
+    }
+    for (i = 0u; i < length; i++)
+    {
+        block[i] = sample_store[(store_tail + 1u + i) & SAMPLER_STORE_MASK];
+    }
+    store_samples -= block[0];
+    store_tail += length + 1u;
+
+    return length;
+}
+
+/*******************************************************************************
+* Function Name: sampler_get_stats
+********************************************************************************
+* Summary:
+*  Copies the sampling statistics.
+*
+* Parameters:
+*  stc_sampler_stats_t *stats - destination
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void sampler_get_stats(stc_sampler_stats_t *stats)
+{
+    *stats = sampler_stats;
+    stats->pending = store_samples + block_count;
+    stats->store_samples = store_samples;
+    stats->store_bytes = store_head - store_tail;
+}
+
+/*******************************************************************************
+* Function Name: sampler_flush_block
+********************************************************************************
+* Summary:
+*  Compresses the collected block into the store, dropping the oldest blocks
+*  if there is no room.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void sampler_flush_block(void)
+{
+    uint8_t record[SAMPLER_CODED_BLOCK_MAX];
+    uint32_t length, i;
+
+    length = compress_block_encode(sample_block, block_count, (0u != SAMPLER_COMPRESS_BITPACK),
+                                   record, sizeof(record));
+    while ((SAMPLER_STORE_SIZE - (store_head - store_tail)) < (length + 1u))
+    {
+        store_drop_oldest();
+    }
+
+    sample_store[store_head & SAMPLER_STORE_MASK] = (uint8_t)length;
+    for (i = 0u; i < length; i++)
+    {
+        sample_store[(store_head + 1u + i) & SAMPLER_STORE_MASK] = record[i];
+    }
+    store_head += length + 1u;
+    store_samples += block_count;
+    block_count = 0u;
+}
+
+/*******************************************************************************
+* Function Name: store_drop_oldest
+********************************************************************************
+* Summary:
+*  Drops the oldest coded block: nobody read the last batches.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void store_drop_oldest(void)
+{
+    uint32_t block = sample_store[(store_tail + 1u) & SAMPLER_STORE_MASK];
+
+    store_tail += sample_store[store_tail & SAMPLER_STORE_MASK] + 1u;
+    store_samples -= block;
+    sampler_stats.overruns += block;
+}
+
+/*******************************************************************************
+* Function Name: sampler_convert
+********************************************************************************
+* Summary:
+*  Starts one conversion with a firmware trigger. The HPPASS sequencer runs
+*  the group on its own; the CPU only waits for the result of the channel.
+*
+* Parameters:
+*  int16_t *value - conversion result
+*
+* Return:
+*  bool - false if the ADC is disabled or the conversion timed out
+*
+*******************************************************************************/
+static bool sampler_convert(int16_t *value)
+{
+#if (1u == SAMPLER_ADC_ENABLED)
+    uint32_t wait_us = SAMPLER_CONVERT_TIMEOUT_US;
+
+    Cy_HPPASS_SAR_Result_ClearStatus(1uL << SAMPLER_CHANNEL);
+    Cy_HPPASS_SetFwTrigger(SAMPLER_TRIGGER);
+    while (0u == (Cy_HPPASS_SAR_Result_GetStatus() & (1uL << SAMPLER_CHANNEL)))
+    {
+        if (0u == wait_us)
+        {
+            return false;
+        }
+        Cy_SysLib_DelayUs(1u);
+        wait_us--;
+    }
+    *value = (int16_t)Cy_HPPASS_SAR_Result_ChannelRead(SAMPLER_CHANNEL);
+    Cy_HPPASS_SAR_Result_ClearStatus(1uL << SAMPLER_CHANNEL);
+
+    return true;
+#else
+    (void)value;
+    return false;
+#endif
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,92 @@
+/*******************************************************************************
+* File Name:   sampler.h
+*
+* Description: This file contains the interface of the ADC sampling stage run on
+*              the RTC alarm wakeups.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_SAMPLER_H_
+#define SOURCE_SAMPLER_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "compress.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SAMPLER_BATCH_SIZE          (16u)   /* Samples per system wakeup */
+#define SAMPLER_BLOCK_SIZE          (16u)   /* Samples per compressed block */
+#define SAMPLER_STORE_SIZE          (8192u) /* Compressed store, power of two */
+#define SAMPLER_COMPRESS_BITPACK    (1u)    /* 0: delta/varint coding only */
+
+/* Largest coded block returned by sampler_read_block() */
+#define SAMPLER_CODED_BLOCK_MAX     (COMPRESS_MAX_BLOCK_SIZE(SAMPLER_BLOCK_SIZE))
+#define SAMPLER_THRESHOLD_LOW       (256)   /* ADC counts; below wakes the system */
+#define SAMPLER_THRESHOLD_HIGH      (3840)  /* ADC counts; above wakes the system */
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    bool     adc_enabled;       /* false if HPPASS is not configured */
+    uint32_t samples;           /* Conversions since boot */
+    uint32_t batches;           /* System wakeups on a full batch */
+    uint32_t threshold_trips;   /* System wakeups on a threshold */
+    uint32_t overruns;          /* Samples lost to a full ring */
+    uint32_t pending;           /* Samples not yet read */
+    uint32_t store_samples;     /* Samples in the compressed store */
+    uint32_t store_bytes;       /* Bytes they take there */
+    int16_t  last_value;
+    uint32_t convert_cycles;    /* Worst-case cost of one sampling stage */
+} stc_sampler_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void sampler_init(void);
+bool sampler_run(void);
+uint32_t sampler_read_block(uint8_t *block, uint32_t size);
+void sampler_get_stats(stc_sampler_stats_t *stats);
+
+#endif /* SOURCE_SAMPLER_H_ */
+
+/* [] END OF FILE */
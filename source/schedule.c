@@ -0,0 +1,296 @@
+/*******************************************************************************
+* File Name:   schedule.c
+*
+* Description: Table-driven RTC alarm schedules: the current schedule and the
+*              position in its precomputed alarm sequence.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "schedule.h"
+#include "schedule_tables.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Build-time validation of every SCHEDULE_TABLE row. tools/schedule_gen.py
+   applies the same rules when it generates the sequences. */
+#define SCHEDULE_CHECK(name, period_s, offset_s, mode, awake_us) \
+    _Static_assert(((period_s) % SCHEDULE_ALARM_RESOLUTION_S) == 0u, \
+                   #name ": period is not a multiple of the alarm resolution"); \
+    _Static_assert((0u != (period_s)) && ((SCHEDULE_SECONDS_PER_DAY % (period_s)) == 0u), \
+                   #name ": period does not divide a day"); \
+    _Static_assert(((offset_s) < (period_s)) && (((offset_s) % SCHEDULE_ALARM_RESOLUTION_S) == 0u), \
+                   #name ": offset is not an alarm time within the period"); \
+    _Static_assert((1u == (period_s)) || ((SCHEDULE_SECONDS_PER_DAY / (period_s)) <= SCHEDULE_MAX_SLOTS), \
+                   #name ": too many alarms per day for a sequence table"); \
+    _Static_assert((uint64_t)(awake_us) <= ((uint64_t)(period_s) * SCHEDULE_MAX_DUTY_PPM), \
+                   #name ": worst-case awake duty cycle above SCHEDULE_MAX_DUTY_PPM"); \
+    _Static_assert(((mode) != SCHEDULE_MODE_HIBERNATE) || ((period_s) >= SCHEDULE_MIN_HIBERNATE_PERIOD_S), \
+                   #name ": period too short for Hibernate"); \
+    _Static_assert((SCHEDULE_GEN_PERIOD_##name == (period_s)) && (SCHEDULE_GEN_OFFSET_##name == (offset_s)), \
+                   #name ": schedule_tables.c is out of date, run tools/schedule_gen.py");
+
+SCHEDULE_TABLE(SCHEDULE_CHECK)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+const stc_schedule_t schedule_table[SCHEDULE_COUNT] =
+{
+#define SCHEDULE_ENTRY(name, period_s, offset_s, mode, awake_us) \
+    { #name, (period_s), (offset_s), (mode), (awake_us), SCHEDULE_GEN_SLOTS_##name, SCHEDULE_GEN_COUNT_##name },
+    SCHEDULE_TABLE(SCHEDULE_ENTRY)
+#undef SCHEDULE_ENTRY
+};
+
+static const stc_schedule_t *schedule = &schedule_table[SCHEDULE_DEFAULT];
+static uint32_t schedule_slot = 0u;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: schedule_get
+********************************************************************************
+* Summary:
+*  Returns the current schedule.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  const stc_schedule_t * - entry of schedule_table
+*
+*******************************************************************************/
+const stc_schedule_t *schedule_get(void)
+{
+    return schedule;
+}
+
+/*******************************************************************************
+* Function Name: schedule_select_period
+********************************************************************************
+* Summary:
+*  Makes the schedule with the given period current. Call schedule_start()
+*  before arming the next alarm.
+*
+* Parameters:
+*  uint32_t period_s - period of a SCHEDULE_TABLE row
+*
+* Return:
+*  bool - false if no schedule has this period
+*
+*******************************************************************************/
+bool schedule_select_period(uint32_t period_s)
+{
+    uint32_t i;
+
+    for (i = 0u; i < (uint32_t)SCHEDULE_COUNT; i++)
+    {
+        if (schedule_table[i].period_s == period_s)
+        {
+            schedule = &schedule_table[i];
+            schedule_slot = 0u;
+            return true;
+        }
+    }
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: schedule_stretch_period
+********************************************************************************
+* Summary:
+*  Returns the period of the schedule 'steps' rows after the one with
+*  'period_s', among the rows of the same low-power mode. Stops at the
+*  longest such row. The table lists the periods in increasing order.
+*
+* Parameters:
+*  uint32_t period_s - period of a SCHEDULE_TABLE row
+*  uint32_t steps    - rows to move on
+*
+* Return:
+*  uint32_t - stretched period; 'period_s' if no row has it
+*
+*******************************************************************************/
+uint32_t schedule_stretch_period(uint32_t period_s, uint32_t steps)
+{
+    uint32_t i;
+    uint32_t base = (uint32_t)SCHEDULE_COUNT;
+    uint32_t result = period_s;
+
+    for (i = 0u; i < (uint32_t)SCHEDULE_COUNT; i++)
+    {
+        if (schedule_table[i].period_s == period_s)
+        {
+            base = i;
+            break;
+        }
+    }
+    for (i = base + 1u; (i < (uint32_t)SCHEDULE_COUNT) && (0u != steps); i++)
+    {
+        if (schedule_table[i].mode == schedule_table[base].mode)
+        {
+            result = schedule_table[i].period_s;
+            steps--;
+        }
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: schedule_start
+********************************************************************************
+* Summary:
+*  Positions the schedule on its first alarm after 'seconds_of_day'. This is
+*  the only place that computes a position; after it, schedule_advance()
+*  steps through the precomputed sequence.
+*
+* Parameters:
+*  uint32_t seconds_of_day - current RTC time of day
+*
+* Return:
+*  uint32_t - seconds to the first alarm (>= 1)
+*
+*******************************************************************************/
+uint32_t schedule_start(uint32_t seconds_of_day)
+{
+    const stc_schedule_slot_t *slot;
+    uint32_t slot_s;
+
+    if (0u == schedule->slot_count)
+    {
+        return 1u;
+    }
+
+    schedule_slot = (seconds_of_day < schedule->offset_s) ? 0u :
+                    (((seconds_of_day - schedule->offset_s) / schedule->period_s) + 1u);
+    if (schedule_slot >= schedule->slot_count)
+    {
+        schedule_slot = 0u;
+    }
+
+    slot = &schedule->slots[schedule_slot];
+    slot_s = (slot->hour * 3600u) + (slot->min * 60u) + slot->sec;
+    return (slot_s > seconds_of_day) ? (slot_s - seconds_of_day)
+                                     : ((slot_s + SCHEDULE_SECONDS_PER_DAY) - seconds_of_day);
+}
+
+/*******************************************************************************
+* Function Name: schedule_advance
+********************************************************************************
+* Summary:
+*  Moves to the next alarm of the sequence, after the current one fired.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t - seconds from the current alarm to the next
+*
+*******************************************************************************/
+uint32_t schedule_advance(void)
+{
+    if (0u != schedule->slot_count)
+    {
+        schedule_slot++;
+        if (schedule_slot == schedule->slot_count)
+        {
+            schedule_slot = 0u;
+        }
+    }
+    return schedule->period_s;
+}
+
+/*******************************************************************************
+* Function Name: schedule_get_alarm
+********************************************************************************
+* Summary:
+*  Fills an ALARM_2 configuration for the current alarm of the schedule: the
+*  time of day of the slot, or a match on every second. Slots are local time;
+*  the RTC keeps standard time, so the local time offset is subtracted.
+*
+* Parameters:
+*  cy_stc_rtc_alarm_t *alarm - destination
+*  uint32_t offset_s         - local time offset at the alarm, for example DST
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void schedule_get_alarm(cy_stc_rtc_alarm_t *alarm, uint32_t offset_s)
+{
+    const stc_schedule_slot_t *slot;
+    cy_en_rtc_alarm_enable_t match;
+    uint32_t slot_s;
+
+    /* Date fields are not matched but must hold valid values */
+    alarm->dayOfWeek    = CY_RTC_SUNDAY;
+    alarm->dayOfWeekEn  = CY_RTC_ALARM_DISABLE;
+    alarm->date         = 1u;
+    alarm->dateEn       = CY_RTC_ALARM_DISABLE;
+    alarm->month        = CY_RTC_JANUARY;
+    alarm->monthEn      = CY_RTC_ALARM_DISABLE;
+    alarm->almEn        = CY_RTC_ALARM_ENABLE;
+
+    if (0u == schedule->slot_count)
+    {
+        slot_s = 0u;
+        match = CY_RTC_ALARM_DISABLE;
+    }
+    else
+    {
+        slot = &schedule->slots[schedule_slot];
+        slot_s = (slot->hour * 3600u) + (slot->min * 60u) + slot->sec;
+        slot_s = (slot_s + SCHEDULE_SECONDS_PER_DAY - (offset_s % SCHEDULE_SECONDS_PER_DAY)) % SCHEDULE_SECONDS_PER_DAY;
+        match = CY_RTC_ALARM_ENABLE;
+    }
+    alarm->sec = slot_s % 60u;
+    alarm->min = (slot_s / 60u) % 60u;
+    alarm->hour = slot_s / 3600u;
+    alarm->secEn = match;
+    alarm->minEn = match;
+    alarm->hourEn = match;
+}
+
+/* [] END OF FILE */
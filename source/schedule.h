@@ -0,0 +1,111 @@
+/*******************************************************************************
+* File Name:   schedule.h
+*
+* Description: Table-driven RTC alarm schedules: the current schedule and the
+*              position in its precomputed alarm sequence.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_SCHEDULE_H_
+#define SOURCE_SCHEDULE_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "schedule_config.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SCHEDULE_SECONDS_PER_DAY    (86400u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef enum
+{
+    SCHEDULE_MODE_DEEPSLEEP = 0u,
+    SCHEDULE_MODE_HIBERNATE = 1u,
+} en_schedule_mode_t;
+
+/* Schedule identifiers, in SCHEDULE_TABLE order */
+typedef enum
+{
+#define SCHEDULE_ID(name, period_s, offset_s, mode, awake_us)   SCHEDULE_##name,
+    SCHEDULE_TABLE(SCHEDULE_ID)
+#undef SCHEDULE_ID
+    SCHEDULE_COUNT
+} en_schedule_id_t;
+
+/* One alarm of a sequence: a time of day */
+typedef struct
+{
+    uint8_t     hour;
+    uint8_t     min;
+    uint8_t     sec;
+} stc_schedule_slot_t;
+
+typedef struct
+{
+    const char                  *name;
+    uint32_t                    period_s;
+    uint32_t                    offset_s;
+    en_schedule_mode_t          mode;
+    uint32_t                    awake_us;
+    const stc_schedule_slot_t   *slots;         /* Alarms of a day, in order */
+    uint32_t                    slot_count;     /* 0: every-second match */
+} stc_schedule_t;
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern const stc_schedule_t schedule_table[SCHEDULE_COUNT];
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+const stc_schedule_t *schedule_get(void);
+bool schedule_select_period(uint32_t period_s);
+uint32_t schedule_stretch_period(uint32_t period_s, uint32_t steps);
+uint32_t schedule_start(uint32_t seconds_of_day);
+uint32_t schedule_advance(void);
+void schedule_get_alarm(cy_stc_rtc_alarm_t *alarm, uint32_t offset_s);
+
+#endif /* SOURCE_SCHEDULE_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,80 @@
+/*******************************************************************************
+* File Name:   schedule_config.h
+*
+* Description: Wake schedule specification: the one table of RTC alarm
+*              schedules, validated at build time.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_SCHEDULE_CONFIG_H_
+#define SOURCE_SCHEDULE_CONFIG_H_
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Build-time limits checked against every schedule */
+#define SCHEDULE_ALARM_RESOLUTION_S     (1u)        /* RTC alarm match granularity */
+#define SCHEDULE_MAX_SLOTS              (1440u)     /* Alarms per day in a sequence table */
+#define SCHEDULE_MAX_DUTY_PPM           (10000u)    /* Worst-case time awake: 1% */
+#define SCHEDULE_MIN_HIBERNATE_PERIOD_S (60u)       /* Hibernate wakeups reboot */
+
+/* Wake schedules, selected at run time by their period:
+
+   X(name, period_s, offset_s, mode, awake_us)
+     period_s - time between RTC alarms; divides a day, so the alarm times of
+                day repeat daily. 1 uses the every-second alarm match.
+     offset_s - first alarm after midnight, below period_s
+     mode     - low-power mode the schedule is meant for
+     awake_us - worst-case time awake per wakeup
+
+   Rows are in increasing period order: the energy budget stretches the
+   period by moving down the table.
+
+   tools/schedule_gen.py turns this table into the alarm sequences of
+   schedule_tables.c. The build runs it as a prebuild step. */
+#define SCHEDULE_TABLE(X) \
+    X(FAST,     1u,     0u,     SCHEDULE_MODE_DEEPSLEEP,    5000u) \
+    X(MINUTE,   60u,    0u,     SCHEDULE_MODE_DEEPSLEEP,    100000u) \
+    X(QUARTER,  900u,   0u,     SCHEDULE_MODE_DEEPSLEEP,    100000u) \
+    X(HOURLY,   3600u,  30u,    SCHEDULE_MODE_HIBERNATE,    500000u)
+
+/* Schedule after reset */
+#define SCHEDULE_DEFAULT                SCHEDULE_FAST
+
+#endif /* SOURCE_SCHEDULE_CONFIG_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,41 @@
+/******************************************************************************
+* File Name:   schedule_tables.h
+*
+* Description: RTC alarm sequences of the wake schedules.
+*
+*              Generated by tools/schedule_gen.py from schedule_config.h.
+*              Do not edit.
+*
+*******************************************************************************/
+
+#ifndef SOURCE_SCHEDULE_TABLES_H_
+#define SOURCE_SCHEDULE_TABLES_H_
+
+#include "schedule.h"
+
+#define SCHEDULE_GEN_PERIOD_FAST 1u
+#define SCHEDULE_GEN_OFFSET_FAST 0u
+#define SCHEDULE_GEN_SLOTS_FAST NULL
+#define SCHEDULE_GEN_COUNT_FAST 0u
+
+#define SCHEDULE_GEN_PERIOD_MINUTE 60u
+#define SCHEDULE_GEN_OFFSET_MINUTE 0u
+#define SCHEDULE_GEN_SLOTS_MINUTE schedule_slots_minute
+#define SCHEDULE_GEN_COUNT_MINUTE 1440u
+extern const stc_schedule_slot_t schedule_slots_minute[1440];
+
+#define SCHEDULE_GEN_PERIOD_QUARTER 900u
+#define SCHEDULE_GEN_OFFSET_QUARTER 0u
+#define SCHEDULE_GEN_SLOTS_QUARTER schedule_slots_quarter
+#define SCHEDULE_GEN_COUNT_QUARTER 96u
+extern const stc_schedule_slot_t schedule_slots_quarter[96];
+
+#define SCHEDULE_GEN_PERIOD_HOURLY 3600u
+#define SCHEDULE_GEN_OFFSET_HOURLY 30u
+#define SCHEDULE_GEN_SLOTS_HOURLY schedule_slots_hourly
+#define SCHEDULE_GEN_COUNT_HOURLY 24u
+extern const stc_schedule_slot_t schedule_slots_hourly[24];
+
+#endif /* SOURCE_SCHEDULE_TABLES_H_ */
+
+/* [] END OF FILE */
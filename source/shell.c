@@ -0,0 +1,413 @@
+/*******************************************************************************
+* File Name:   shell.c
+*
+* Description: This file implements the command shell on the debug UART. The RX
+*              interrupt assembles a line; commands are parsed and run from the
+*              main loop only once a full line has arrived, so the shell never
+*              polls or blocks. During DeepSleep, a falling edge on the RX pin
+*              wakes the CPU; the character that caused it is lost.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "cybsp.h"
+#include "shell.h"
+#include "wake_source.h"
+#include "trace.h"
+#include "debug_uart.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SHELL_INTERRUPT_PRIORITY    (3u)
+#define SHELL_PROMPT                "> "
+
+#define ASCII_BACKSPACE             (0x08u)
+#define ASCII_DELETE                (0x7Fu)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const stc_shell_command_t *shell_table;
+static uint32_t shell_table_count;
+
+/* Line being received, owned by the RX interrupt */
+static char rx_line[SHELL_LINE_SIZE];
+static uint32_t rx_length = 0u;
+static bool rx_discard = false;     /* Line lost its first character */
+static volatile bool rx_woken = false;  /* Typing powered the UART up */
+
+/* Complete line handed to the main loop */
+static char cmd_line[SHELL_LINE_SIZE];
+static volatile bool cmd_ready = false;
+
+static cy_stc_syspm_callback_params_t shell_pm_params =
+{
+    .base       = NULL,
+    .context    = NULL
+};
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void shell_rx_interrupt_handler(void);
+static void shell_rx_pin_interrupt_handler(void);
+static cy_en_syspm_status_t shell_deepsleep_callback(cy_stc_syspm_callback_params_t *params,
+                                                     cy_en_syspm_callback_mode_t mode);
+
+static cy_stc_syspm_callback_t shell_pm_callback =
+{
+    .callback       = shell_deepsleep_callback,
+    .type           = CY_SYSPM_DEEPSLEEP,
+    .skipMode       = 0u,
+    .callbackParams = &shell_pm_params,
+    .prevItm        = NULL,
+    .nextItm        = NULL,
+    .order          = 0u
+};
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: shell_init
+********************************************************************************
+* Summary:
+*  Registers the command table, enables the UART RX interrupt and the RX pin
+*  edge used to wake from DeepSleep. The debug UART must be initialized.
+*
+* Parameters:
+*  const stc_shell_command_t *table - commands
+*  uint32_t count                   - number of entries in 'table'
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void shell_init(const stc_shell_command_t *table, uint32_t count)
+{
+    cy_stc_sysint_t uart_intr_config =
+    {
+        .intrSrc = DEBUG_UART_IRQ,
+        .intrPriority = SHELL_INTERRUPT_PRIORITY
+    };
+    cy_stc_sysint_t rx_pin_intr_config =
+    {
+        .intrSrc = CYBSP_DEBUG_UART_RX_IRQ,
+        .intrPriority = SHELL_INTERRUPT_PRIORITY
+    };
+
+    shell_table = table;
+    shell_table_count = count;
+
+    Cy_SysInt_Init(&uart_intr_config, shell_rx_interrupt_handler);
+    NVIC_ClearPendingIRQ(uart_intr_config.intrSrc);
+    NVIC_EnableIRQ(uart_intr_config.intrSrc);
+    Cy_SCB_ClearRxInterrupt(DEBUG_UART_HW, CY_SCB_RX_INTR_NOT_EMPTY);
+    Cy_SCB_SetRxInterruptMask(DEBUG_UART_HW, CY_SCB_RX_INTR_NOT_EMPTY);
+
+    /* The RX pin edge stays masked until DeepSleep entry or UART power-down */
+    Cy_GPIO_SetInterruptEdge(CYBSP_DEBUG_UART_RX_PORT, CYBSP_DEBUG_UART_RX_PIN, CY_GPIO_INTR_FALLING);
+    Cy_GPIO_SetInterruptMask(CYBSP_DEBUG_UART_RX_PORT, CYBSP_DEBUG_UART_RX_PIN, 0u);
+    Cy_SysInt_Init(&rx_pin_intr_config, shell_rx_pin_interrupt_handler);
+    NVIC_ClearPendingIRQ(rx_pin_intr_config.intrSrc);
+    NVIC_EnableIRQ(rx_pin_intr_config.intrSrc);
+
+    if (!Cy_SysPm_RegisterCallback(&shell_pm_callback))
+    {
+        CY_ASSERT(0);
+    }
+}
+
+/*******************************************************************************
+* Function Name: shell_is_pending
+********************************************************************************
+* Summary:
+*  Returns true if a complete command line, or the notice of a character lost
+*  while the UART was powered down, waits to be processed.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - true if a line is ready
+*
+*******************************************************************************/
+bool shell_is_pending(void)
+{
+    return (cmd_ready || rx_woken);
+}
+
+/*******************************************************************************
+* Function Name: shell_process
+********************************************************************************
+* Summary:
+*  Splits the received line into words and runs the matching command. Returns
+*  at once if no complete line has arrived. Asks to retype a line whose first
+*  character arrived while the UART was powered down.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void shell_process(void)
+{
+    char *argv[SHELL_MAX_ARGS];
+    uint32_t argc = 0u;
+    char *token;
+    char *save = NULL;
+    uint32_t i;
+
+    if (rx_woken)
+    {
+        rx_woken = false;
+        printf("UART powered up by typing, retype the command\r\n");
+    }
+    if (!cmd_ready)
+    {
+        return;
+    }
+
+    token = strtok_r(cmd_line, " \t", &save);
+    while ((NULL != token) && (argc < SHELL_MAX_ARGS))
+    {
+        argv[argc++] = token;
+        token = strtok_r(NULL, " \t", &save);
+    }
+
+    if (0u != argc)
+    {
+        for (i = 0u; i < shell_table_count; i++)
+        {
+            if (0 == strcmp(argv[0], shell_table[i].name))
+            {
+                trace_record(TRACE_EVENT_COMMAND, i);
+                shell_table[i].handler(argc, argv);
+                break;
+            }
+        }
+        if (i == shell_table_count)
+        {
+            printf("Unknown command '%s', type 'help'\r\n", argv[0]);
+        }
+    }
+
+    printf(SHELL_PROMPT);
+
+    /* Release the buffer to the RX interrupt */
+    cmd_ready = false;
+}
+
+/*******************************************************************************
+* Function Name: shell_print_help
+********************************************************************************
+* Summary:
+*  Prints the registered commands and their usage.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void shell_print_help(void)
+{
+    uint32_t i;
+
+    for (i = 0u; i < shell_table_count; i++)
+    {
+        printf("  %-10s %s\r\n", shell_table[i].name, shell_table[i].usage);
+    }
+}
+
+/*******************************************************************************
+* Function Name: shell_rx_interrupt_handler
+********************************************************************************
+* Summary:
+*  Debug UART RX interrupt handler. Echoes and collects characters. On CR or LF
+*  the line is handed to the main loop; lines arriving while the previous one
+*  is still being processed are dropped, and so is the line whose first
+*  character woke the device.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void shell_rx_interrupt_handler(void)
+{
+    uint32_t ch;
+
+    while (0u != Cy_SCB_UART_GetNumInRxFifo(DEBUG_UART_HW))
+    {
+        ch = Cy_SCB_UART_Get(DEBUG_UART_HW);
+
+        if (('\r' == ch) || ('\n' == ch))
+        {
+            if ((0u != rx_length) && (!cmd_ready) && (!rx_discard))
+            {
+                memcpy(cmd_line, rx_line, rx_length);
+                cmd_line[rx_length] = '\0';
+                cmd_ready = true;
+            }
+            rx_length = 0u;
+            rx_discard = false;
+            (void)Cy_SCB_UART_Put(DEBUG_UART_HW, '\r');
+            (void)Cy_SCB_UART_Put(DEBUG_UART_HW, '\n');
+        }
+        else if ((ASCII_BACKSPACE == ch) || (ASCII_DELETE == ch))
+        {
+            if (0u != rx_length)
+            {
+                rx_length--;
+                (void)Cy_SCB_UART_PutArray(DEBUG_UART_HW, "\b \b", 3u);
+            }
+        }
+        else if ((ch >= ' ') && (rx_length < (SHELL_LINE_SIZE - 1u)))
+        {
+            rx_line[rx_length++] = (char)ch;
+            (void)Cy_SCB_UART_Put(DEBUG_UART_HW, ch);
+        }
+        else
+        {
+            /* Drop control characters and overlong lines */
+        }
+    }
+
+    Cy_SCB_ClearRxInterrupt(DEBUG_UART_HW, CY_SCB_RX_INTR_NOT_EMPTY);
+}
+
+/*******************************************************************************
+* Function Name: shell_rx_pin_interrupt_handler
+********************************************************************************
+* Summary:
+*  RX pin edge interrupt, armed in DeepSleep and while the UART is powered
+*  down. Powers the UART up and signals a UART wakeup.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void shell_rx_pin_interrupt_handler(void)
+{
+    Cy_GPIO_SetInterruptMask(CYBSP_DEBUG_UART_RX_PORT, CYBSP_DEBUG_UART_RX_PIN, 0u);
+    Cy_GPIO_ClearInterrupt(CYBSP_DEBUG_UART_RX_PORT, CYBSP_DEBUG_UART_RX_PIN);
+    rx_discard = true;
+    if (!debug_uart_is_on())
+    {
+        debug_uart_acquire();
+        rx_woken = true;
+    }
+    wake_source_signal(WAKE_SOURCE_UART);
+}
+
+/*******************************************************************************
+* Function Name: shell_deepsleep_callback
+********************************************************************************
+* Summary:
+*  DeepSleep callback. Refuses DeepSleep while output is still being sent, so
+*  that the caller drains it with the CPU asleep (co_uart_drain in main.c)
+*  and tries again. Arms the RX pin edge for the duration of DeepSleep and
+*  disarms it after, unless the UART stays powered down. A character powers
+*  the UART up at once.
+*
+* Parameters:
+*  cy_stc_syspm_callback_params_t *params - unused
+*  cy_en_syspm_callback_mode_t mode       - transition phase
+*
+* Return:
+*  cy_en_syspm_status_t - CY_SYSPM_FAIL if the UART is still sending
+*
+*******************************************************************************/
+static cy_en_syspm_status_t shell_deepsleep_callback(cy_stc_syspm_callback_params_t *params,
+                                                     cy_en_syspm_callback_mode_t mode)
+{
+    CY_UNUSED_PARAMETER(params);
+
+    switch (mode)
+    {
+        case CY_SYSPM_CHECK_READY:
+            if (debug_uart_is_on() && (!Cy_SCB_UART_IsTxComplete(DEBUG_UART_HW)))
+            {
+                return CY_SYSPM_FAIL;
+            }
+            break;
+
+        case CY_SYSPM_BEFORE_TRANSITION:
+            Cy_GPIO_ClearInterrupt(CYBSP_DEBUG_UART_RX_PORT, CYBSP_DEBUG_UART_RX_PIN);
+            Cy_GPIO_SetInterruptMask(CYBSP_DEBUG_UART_RX_PORT, CYBSP_DEBUG_UART_RX_PIN, 1u);
+            break;
+
+        case CY_SYSPM_AFTER_TRANSITION:
+            /* Interrupts are still disabled here; record an RX wakeup before
+               the edge is disarmed */
+            if (0u != Cy_GPIO_GetInterruptStatusMasked(CYBSP_DEBUG_UART_RX_PORT, CYBSP_DEBUG_UART_RX_PIN))
+            {
+                rx_discard = true;
+                wake_source_signal(WAKE_SOURCE_UART);
+                debug_uart_acquire();
+            }
+            if (debug_uart_is_on())
+            {
+                Cy_GPIO_SetInterruptMask(CYBSP_DEBUG_UART_RX_PORT, CYBSP_DEBUG_UART_RX_PIN, 0u);
+                Cy_GPIO_ClearInterrupt(CYBSP_DEBUG_UART_RX_PORT, CYBSP_DEBUG_UART_RX_PIN);
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return CY_SYSPM_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,81 @@
+/*******************************************************************************
+* File Name:   shell.h
+*
+* Description: This file contains the interface of the line-oriented command
+*              shell on the debug UART.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_SHELL_H_
+#define SOURCE_SHELL_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SHELL_LINE_SIZE             (64u)   /* Longest command line */
+#define SHELL_MAX_ARGS              (4u)    /* Command name included */
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Command handler. argv[0] is the command name. */
+typedef void (*shell_handler_t)(uint32_t argc, char *argv[]);
+
+/* Entry of the application command table */
+typedef struct
+{
+    const char          *name;
+    const char          *usage;
+    shell_handler_t     handler;
+} stc_shell_command_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void shell_init(const stc_shell_command_t *table, uint32_t count);
+bool shell_is_pending(void);
+void shell_process(void);
+void shell_print_help(void);
+
+#endif /* SOURCE_SHELL_H_ */
+
+/* [] END OF FILE */
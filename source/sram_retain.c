@@ -0,0 +1,294 @@
+/*******************************************************************************
+* File Name:   sram_retain.c
+*
+* Description: This file contains the DeepSleep SRAM retention and regulator
+*              control. The linker groups the data, .bss and SRAM_RETAIN data in
+*              the lowest SRAM macros; the macros above them, up to the stack,
+*              are powered down for DeepSleep and powered up, with undefined
+*              contents, after the wakeup. The LDO is switched to its minimum
+*              current mode for the DeepSleep duration.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdio.h>
+#include "sram_retain.h"
+#include "energy_model.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Runs after the other callbacks before the transition, first after it */
+#define SRAM_RETAIN_CALLBACK_ORDER  (255u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+#if (0u != SRAM_RETAIN_GROUPED)
+/* Bounds of the SRAM_RETAIN data, from sram_retain.ld, and the bottom of the
+   stack, from the BSP linker script */
+extern uint8_t __sram_retain_start__[];
+extern uint8_t __sram_retain_end__[];
+extern uint8_t __StackLimit[];
+#endif
+
+static uint32_t first_off_macro;
+static stc_sram_retain_stats_t sram_stats;
+
+static cy_stc_syspm_callback_params_t sram_pm_params =
+{
+    .base       = NULL,
+    .context    = NULL
+};
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static cy_en_syspm_status_t sram_retain_deepsleep_callback(cy_stc_syspm_callback_params_t *params,
+                                                           cy_en_syspm_callback_mode_t mode);
+
+static cy_stc_syspm_callback_t sram_pm_callback =
+{
+    .callback       = sram_retain_deepsleep_callback,
+    .type           = CY_SYSPM_DEEPSLEEP,
+    .skipMode       = 0u,
+    .callbackParams = &sram_pm_params,
+    .prevItm        = NULL,
+    .nextItm        = NULL,
+    .order          = SRAM_RETAIN_CALLBACK_ORDER
+};
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: sram_retain_init
+********************************************************************************
+* Summary:
+*  Finds the SRAM macros that lie entirely between the retained data and the
+*  stack and registers the DeepSleep callback. Everything below the end of
+*  the SRAM_RETAIN group, and the macros of the stack, stay retained. The
+*  macro size comes from the device header.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void sram_retain_init(void)
+{
+#if (0u != SRAM_RETAIN_GROUPED)
+    uint32_t end = (uint32_t)__sram_retain_end__ - CY_SRAM_BASE;
+    uint32_t stack = (uint32_t)__StackLimit - CY_SRAM_BASE;
+    uint32_t stack_macro;
+
+    sram_stats.group_bytes = (uint32_t)__sram_retain_end__ - (uint32_t)__sram_retain_start__;
+    first_off_macro = (end + SRAM_RETAIN_MACRO_SIZE - 1u) / SRAM_RETAIN_MACRO_SIZE;
+    stack_macro = stack / SRAM_RETAIN_MACRO_SIZE;
+    sram_stats.off_macros = (stack_macro > first_off_macro) ? (stack_macro - first_off_macro) : 0u;
+#else
+    first_off_macro = 0u;
+    sram_stats.off_macros = 0u;
+#endif
+    sram_stats.retained_bytes = CY_SRAM_SIZE - (sram_stats.off_macros * SRAM_RETAIN_MACRO_SIZE);
+
+    if (!Cy_SysPm_RegisterCallback(&sram_pm_callback))
+    {
+        CY_ASSERT(0);
+    }
+}
+
+/*******************************************************************************
+* Function Name: sram_retain_deepsleep_na
+********************************************************************************
+* Summary:
+*  Returns the modeled DeepSleep current with a number of SRAM macros kept:
+*  ENERGY_DEEPSLEEP_UA is the current with all macros kept and the LDO in
+*  normal mode.
+*
+* Parameters:
+*  uint32_t retained_macros - macros kept, up to SRAM_RETAIN_MACRO_COUNT
+*  bool ldo_min             - true with the LDO in minimum current mode
+*
+* Return:
+*  uint32_t - current in nA
+*
+*******************************************************************************/
+uint32_t sram_retain_deepsleep_na(uint32_t retained_macros, bool ldo_min)
+{
+    uint32_t off_kb = ((SRAM_RETAIN_MACRO_COUNT - retained_macros) * SRAM_RETAIN_MACRO_SIZE) / 1024u;
+    uint32_t current_na = (ENERGY_DEEPSLEEP_UA * 1000u) - (off_kb * ENERGY_SRAM_RETAIN_NA_PER_KB);
+
+    if (ldo_min)
+    {
+        current_na -= ENERGY_LDO_MIN_SAVING_NA;
+    }
+
+    return current_na;
+}
+
+/*******************************************************************************
+* Function Name: sram_retain_get_stats
+********************************************************************************
+* Summary:
+*  Copies the retention layout and counters.
+*
+* Parameters:
+*  stc_sram_retain_stats_t *stats - destination
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void sram_retain_get_stats(stc_sram_retain_stats_t *stats)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    *stats = sram_stats;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/*******************************************************************************
+* Function Name: sram_retain_print
+********************************************************************************
+* Summary:
+*  Prints the retained SRAM, why no macro is powered down if none is, and
+*  the tradeoff: the modeled DeepSleep current for each number of retained
+*  macros, the current layout marked.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void sram_retain_print(void)
+{
+    stc_sram_retain_stats_t stats;
+    uint32_t macros;
+
+    sram_retain_get_stats(&stats);
+    printf("SRAM: %lu of %lu bytes retained, %lu of %lu macros off, %lu SRAM_RETAIN bytes\r\n",
+           (unsigned long)stats.retained_bytes, (unsigned long)CY_SRAM_SIZE,
+           (unsigned long)stats.off_macros, (unsigned long)SRAM_RETAIN_MACRO_COUNT,
+           (unsigned long)stats.group_bytes);
+    if (0u == stats.off_macros)
+    {
+        printf("SRAM: no macro powered down: %s\r\n",
+               (0u == SRAM_RETAIN_GROUPED) ? "SRAM_RETAIN data is not grouped (GCC_ARM only)" :
+               "no whole macro between the retained data and the stack");
+    }
+    printf("SRAM: %lu DeepSleep entries, LDO %s, %lu mode switches refused\r\n",
+           (unsigned long)stats.sleeps, (0u != SRAM_RETAIN_LDO_MIN) ? "min" : "normal",
+           (unsigned long)stats.ldo_failures);
+    for (macros = SRAM_RETAIN_MACRO_COUNT; macros > 0u; macros--)
+    {
+        printf("SRAM: %3lu KB retained: %5lu nA, %5lu nA with LDO min (model)%s\r\n",
+               (unsigned long)((macros * SRAM_RETAIN_MACRO_SIZE) / 1024u),
+               (unsigned long)sram_retain_deepsleep_na(macros, false),
+               (unsigned long)sram_retain_deepsleep_na(macros, true),
+               ((SRAM_RETAIN_MACRO_COUNT - macros) == stats.off_macros) ? " <" : "");
+    }
+}
+
+/*******************************************************************************
+* Function Name: sram_retain_deepsleep_callback
+********************************************************************************
+* Summary:
+*  DeepSleep callback. Right before the transition, powers down the macros
+*  above the retained data and switches the LDO to minimum current; first after the wakeup,
+*  restores the LDO and powers the macros up.
+*
+* Parameters:
+*  cy_stc_syspm_callback_params_t *params - unused
+*  cy_en_syspm_callback_mode_t mode       - transition phase
+*
+* Return:
+*  cy_en_syspm_status_t - always CY_SYSPM_SUCCESS
+*
+*******************************************************************************/
+static cy_en_syspm_status_t sram_retain_deepsleep_callback(cy_stc_syspm_callback_params_t *params,
+                                                           cy_en_syspm_callback_mode_t mode)
+{
+    uint32_t i;
+
+    CY_UNUSED_PARAMETER(params);
+
+    switch (mode)
+    {
+        case CY_SYSPM_BEFORE_TRANSITION:
+            for (i = 0u; i < sram_stats.off_macros; i++)
+            {
+                (void)Cy_SysPm_SetSRAMMacroPwrMode(CY_SYSPM_SRAM0_MEMORY, first_off_macro + i,
+                                                   CY_SYSPM_SRAM_PWR_MODE_OFF);
+            }
+#if (0u != SRAM_RETAIN_LDO_MIN)
+            if (CY_SYSPM_SUCCESS != Cy_SysPm_LdoSetMode(CY_SYSPM_LDO_MODE_MIN))
+            {
+                sram_stats.ldo_failures++;
+            }
+#endif
+            sram_stats.sleeps++;
+            break;
+
+        case CY_SYSPM_AFTER_TRANSITION:
+#if (0u != SRAM_RETAIN_LDO_MIN)
+            (void)Cy_SysPm_LdoSetMode(CY_SYSPM_LDO_MODE_NORMAL);
+#endif
+            for (i = 0u; i < sram_stats.off_macros; i++)
+            {
+                (void)Cy_SysPm_SetSRAMMacroPwrMode(CY_SYSPM_SRAM0_MEMORY, first_off_macro + i,
+                                                   CY_SYSPM_SRAM_PWR_MODE_ON);
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return CY_SYSPM_SUCCESS;
+}
+
+/* [] END OF FILE */
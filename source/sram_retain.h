@@ -0,0 +1,100 @@
+/*******************************************************************************
+* File Name:   sram_retain.h
+*
+* Description: This file contains the interface of the DeepSleep SRAM retention
+*              and regulator control.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_SRAM_RETAIN_H_
+#define SOURCE_SRAM_RETAIN_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* 1: the linker groups SRAM_RETAIN data (sram_retain.ld). Set by the
+   Makefile for GCC_ARM; else the attribute is empty and all SRAM is kept. */
+#ifndef SRAM_RETAIN_GROUPED
+#define SRAM_RETAIN_GROUPED         (0u)
+#endif
+
+/* SRAM macros, powered separately, as the device header lays them out */
+#define SRAM_RETAIN_MACRO_COUNT     (CPUSS_RAMC0_MACRO_NR)
+#define SRAM_RETAIN_MACRO_SIZE      (CY_SRAM_SIZE / SRAM_RETAIN_MACRO_COUNT)
+
+/* 1: the LDO runs in its minimum current mode during DeepSleep */
+#ifndef SRAM_RETAIN_LDO_MIN
+#define SRAM_RETAIN_LDO_MIN         (1u)
+#endif
+
+/* Large state that must survive DeepSleep, grouped after .bss in the lowest
+   macros. The macros above it, up to the stack, are powered down. Not
+   initialized at startup: write such data before reading it. */
+#if (0u != SRAM_RETAIN_GROUPED)
+#define SRAM_RETAIN                 __attribute__((section(".sram_retain")))
+#else
+#define SRAM_RETAIN
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t    group_bytes;        /* Size of the .sram_retain section */
+    uint32_t    off_macros;         /* Macros powered down in DeepSleep */
+    uint32_t    retained_bytes;     /* SRAM kept in DeepSleep */
+    uint32_t    sleeps;             /* DeepSleep entries */
+    uint32_t    ldo_failures;       /* LDO mode switches refused */
+} stc_sram_retain_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void sram_retain_init(void);
+uint32_t sram_retain_deepsleep_na(uint32_t retained_macros, bool ldo_min);
+void sram_retain_get_stats(stc_sram_retain_stats_t *stats);
+void sram_retain_print(void);
+
+#endif /* SOURCE_SRAM_RETAIN_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,421 @@
+/*******************************************************************************
+* File Name:   timebase.c
+*
+* Description: This file contains the 64-bit monotonic microsecond timebase.
+*              It counts the free-running low-power timer, which keeps running
+*              in DeepSleep, extended to 64 bits, and corrects it against the
+*              RTC seconds at every RTC alarm. The RTC calendar can be
+*              rewritten without the timebase jumping. Before Hibernate the time
+*              is saved in the backup registers and resumed on the next boot.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "timebase.h"
+#include "lptimer.h"
+#include "calendar.h"
+#include "retained.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* A second boundary serviced later than this is not used for a correction:
+   the RTC may have counted on */
+#define TIMEBASE_SYNC_WINDOW_TICKS  (LPTIMER_CLOCK_HZ / 2u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static uint32_t tb_last_ticks = 0u;         /* Last low-power timer value */
+static uint32_t tb_wraps = 0u;              /* Upper word of the 64-bit count */
+static uint64_t tb_anchor_ticks = 0u;       /* Count at the last correction */
+static uint64_t tb_anchor_us = 0u;          /* Time at the last correction */
+static uint64_t tb_last_us = 0u;            /* Latest time returned */
+static int64_t tb_rtc_offset_us = 0;        /* Time minus RTC time */
+static bool tb_rtc_offset_valid = false;
+
+static uint64_t tb_second_ticks = 0u;       /* Count at an RTC second boundary */
+static bool tb_second_pending = false;
+
+static stc_timebase_stats_t tb_stats;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint64_t timebase_ticks(void);
+static uint64_t timebase_ticks_to_us(uint64_t ticks);
+static uint32_t timebase_rtc_seconds(void);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: timebase_init
+********************************************************************************
+* Summary:
+*  Starts the timebase. After a Hibernate wakeup, it resumes from the time
+*  saved by timebase_save() plus the RTC seconds spent in Hibernate; else it
+*  starts at 0. Call it after the low-power timer is started.
+*
+* Parameters:
+*  bool from_hibernate - true on a Hibernate wakeup
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void timebase_init(bool from_hibernate)
+{
+    uint32_t rtc_s = timebase_rtc_seconds();
+    uint32_t saved_rtc_s = retained_read(RETAINED_SLOT_TIME_RTC);
+    uint64_t start_us = 0u;
+
+    if (from_hibernate && (0u != saved_rtc_s) && (rtc_s >= saved_rtc_s))
+    {
+        start_us = ((uint64_t)retained_read(RETAINED_SLOT_TIME_US_HI) << 32) |
+                   retained_read(RETAINED_SLOT_TIME_US_LO);
+        start_us += (uint64_t)(rtc_s - saved_rtc_s) * TIMEBASE_US_PER_S;
+        tb_stats.resumes++;
+        tb_stats.hibernate_s = rtc_s - saved_rtc_s;
+    }
+    retained_write(RETAINED_SLOT_TIME_RTC, 0u);
+
+    tb_last_ticks = lptimer_now();
+    tb_wraps = 0u;
+    tb_anchor_ticks = tb_last_ticks;
+    tb_anchor_us = start_us;
+    tb_last_us = start_us;
+
+    /* The RTC offset is taken at the first second boundary */
+    tb_rtc_offset_valid = false;
+    tb_second_pending = false;
+}
+
+/*******************************************************************************
+* Function Name: timebase_now_us
+********************************************************************************
+* Summary:
+*  Returns the current time. It never goes backward: after a correction to an
+*  earlier time it holds until the counter catches up. Safe to call from
+*  interrupts. Must be called, or timebase_on_second() run, at least once per
+*  wrap of the 32-bit low-power timer (~36 hours).
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint64_t - microseconds since the first boot
+*
+*******************************************************************************/
+uint64_t timebase_now_us(void)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+    uint64_t now_us = tb_anchor_us + timebase_ticks_to_us(timebase_ticks() - tb_anchor_ticks);
+
+    if (now_us < tb_last_us)
+    {
+        now_us = tb_last_us;
+    }
+    tb_last_us = now_us;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+    return now_us;
+}
+
+/*******************************************************************************
+* Function Name: timebase_on_second
+********************************************************************************
+* Summary:
+*  Called from the RTC alarm interrupt, which fires on an RTC second boundary.
+*  Captures the counter for the next timebase_sync().
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void timebase_on_second(void)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    tb_second_ticks = timebase_ticks();
+    tb_second_pending = true;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/*******************************************************************************
+* Function Name: timebase_sync
+********************************************************************************
+* Summary:
+*  Corrects the timebase on each wake: the second boundary captured by
+*  timebase_on_second() is set to the time the RTC gives for it. The first
+*  boundary after a start or an RTC change only takes the RTC offset.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void timebase_sync(void)
+{
+    uint32_t interrupt_state;
+    uint64_t boundary_ticks;
+    uint64_t now_ticks;
+    uint64_t counter_us;
+    uint64_t rtc_us;
+    int64_t error_us;
+    uint32_t rtc_s;
+    bool pending;
+
+    interrupt_state = Cy_SysLib_EnterCriticalSection();
+    pending = tb_second_pending;
+    tb_second_pending = false;
+    boundary_ticks = tb_second_ticks;
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+    if (!pending)
+    {
+        return;
+    }
+
+    rtc_s = timebase_rtc_seconds();
+
+    interrupt_state = Cy_SysLib_EnterCriticalSection();
+    now_ticks = timebase_ticks();
+    if ((now_ticks - boundary_ticks) >= TIMEBASE_SYNC_WINDOW_TICKS)
+    {
+        tb_stats.skipped_syncs++;
+    }
+    else
+    {
+        counter_us = tb_anchor_us + timebase_ticks_to_us(boundary_ticks - tb_anchor_ticks);
+        rtc_us = (uint64_t)rtc_s * TIMEBASE_US_PER_S;
+        if (!tb_rtc_offset_valid)
+        {
+            tb_rtc_offset_us = (int64_t)(counter_us - rtc_us);
+            tb_rtc_offset_valid = true;
+        }
+        else
+        {
+            error_us = (int64_t)((rtc_us + (uint64_t)tb_rtc_offset_us) - counter_us);
+            tb_anchor_ticks = boundary_ticks;
+            tb_anchor_us = counter_us + (uint64_t)error_us;
+
+            tb_stats.syncs++;
+            tb_stats.last_error_us = (int32_t)error_us;
+            if ((uint32_t)((error_us < 0) ? -error_us : error_us) > tb_stats.max_error_us)
+            {
+                tb_stats.max_error_us = (uint32_t)((error_us < 0) ? -error_us : error_us);
+            }
+        }
+    }
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/*******************************************************************************
+* Function Name: timebase_rtc_changed
+********************************************************************************
+* Summary:
+*  Call after the RTC calendar is rewritten. The timebase runs on and takes
+*  the new RTC offset at the next second boundary.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void timebase_rtc_changed(void)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    tb_rtc_offset_valid = false;
+    tb_second_pending = false;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/*******************************************************************************
+* Function Name: timebase_rtc_us
+********************************************************************************
+* Summary:
+*  Returns the RTC time with the resolution of the timebase: the RTC seconds
+*  since 2000-01-01 carry on the counter since the last second boundary.
+*
+* Parameters:
+*  uint64_t *rtc_us - destination, microseconds since 2000-01-01
+*
+* Return:
+*  bool - false until a second boundary gave the RTC offset
+*
+*******************************************************************************/
+bool timebase_rtc_us(uint64_t *rtc_us)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+    bool valid = tb_rtc_offset_valid;
+    int64_t offset_us = tb_rtc_offset_us;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+    if (valid)
+    {
+        *rtc_us = timebase_now_us() - (uint64_t)offset_us;
+    }
+    return valid;
+}
+
+/*******************************************************************************
+* Function Name: timebase_save
+********************************************************************************
+* Summary:
+*  Saves the current time and the RTC time in the backup registers. Call it
+*  just before Hibernate.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void timebase_save(void)
+{
+    uint64_t now_us = timebase_now_us();
+    uint32_t rtc_s = timebase_rtc_seconds();
+
+    retained_write(RETAINED_SLOT_TIME_US_LO, (uint32_t)now_us);
+    retained_write(RETAINED_SLOT_TIME_US_HI, (uint32_t)(now_us >> 32));
+    retained_write(RETAINED_SLOT_TIME_RTC, rtc_s);
+}
+
+/*******************************************************************************
+* Function Name: timebase_get_stats
+********************************************************************************
+* Summary:
+*  Copies the correction statistics.
+*
+* Parameters:
+*  stc_timebase_stats_t *stats - destination
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void timebase_get_stats(stc_timebase_stats_t *stats)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    *stats = tb_stats;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/*******************************************************************************
+* Function Name: timebase_ticks
+********************************************************************************
+* Summary:
+*  Extends the 32-bit low-power timer to 64 bits. Call with interrupts
+*  disabled.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint64_t - ticks since timebase_init()
+*
+*******************************************************************************/
+static uint64_t timebase_ticks(void)
+{
+    uint32_t now = lptimer_now();
+
+    if (now < tb_last_ticks)
+    {
+        tb_wraps++;
+    }
+    tb_last_ticks = now;
+    return ((uint64_t)tb_wraps << 32) | now;
+}
+
+/*******************************************************************************
+* Function Name: timebase_ticks_to_us
+********************************************************************************
+* Summary:
+*  Converts low-power timer ticks to microseconds. The product fits 64 bits
+*  for 17 years of ticks; corrections keep the spans far shorter.
+*
+* Parameters:
+*  uint64_t ticks - LFCLK ticks
+*
+* Return:
+*  uint64_t - microseconds
+*
+*******************************************************************************/
+static uint64_t timebase_ticks_to_us(uint64_t ticks)
+{
+    return (ticks * TIMEBASE_US_PER_S) / LPTIMER_CLOCK_HZ;
+}
+
+/*******************************************************************************
+* Function Name: timebase_rtc_seconds
+********************************************************************************
+* Summary:
+*  Reads the RTC as seconds since 2000-01-01.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t - RTC seconds
+*
+*******************************************************************************/
+static uint32_t timebase_rtc_seconds(void)
+{
+    cy_stc_rtc_config_t now;
+
+    Cy_RTC_GetDateAndTime(&now);
+    return (uint32_t)(calendar_rtc_to_epoch(&now) - CALENDAR_EPOCH_RTC_BASE);
+}
+
+/* [] END OF FILE */
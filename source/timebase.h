@@ -0,0 +1,83 @@
+/*******************************************************************************
+* File Name:   timebase.h
+*
+* Description: This file contains the interface of the 64-bit monotonic
+*              microsecond timebase.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_TIMEBASE_H_
+#define SOURCE_TIMEBASE_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TIMEBASE_US_PER_S           (1000000u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t    syncs;          /* Corrections against an RTC second */
+    uint32_t    skipped_syncs;  /* Second boundaries serviced too late */
+    int32_t     last_error_us;  /* RTC minus counter at the last correction */
+    uint32_t    max_error_us;   /* Largest correction, absolute */
+    uint32_t    resumes;        /* Resumed after Hibernate */
+    uint32_t    hibernate_s;    /* RTC seconds of the last Hibernate resumed */
+} stc_timebase_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void timebase_init(bool from_hibernate);
+uint64_t timebase_now_us(void);
+void timebase_on_second(void);
+void timebase_sync(void);
+void timebase_rtc_changed(void);
+bool timebase_rtc_us(uint64_t *rtc_us);
+void timebase_save(void);
+void timebase_get_stats(stc_timebase_stats_t *stats);
+
+#endif /* SOURCE_TIMEBASE_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,356 @@
+/*******************************************************************************
+* File Name:   timesync.c
+*
+* Description: This file contains the time synchronization with a host over
+*              the debug UART. The host measures the offset of the device time
+*              and the round trip in an exchange of time stamps. Large offsets
+*              step the RTC calendar; small ones are slewed into the RTC alarm
+*              deadlines, a second at a time, so periodic schedules stay smooth.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdio.h>
+#include "timesync.h"
+#include "calendar.h"
+#include "dst.h"
+#include "timebase.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TIMESYNC_WRITE_ATTEMPTS     (500u)
+#define TIMESYNC_WRITE_DELAY_MS     (5u)
+#define TIMESYNC_US_PER_S           (1000000u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static stc_timesync_stats_t sync_stats;
+
+/* Slew earned by the time waited, in microseconds, up to one second */
+static uint32_t slew_allowance_us = 0u;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static int32_t timesync_round_s(int64_t ms);
+static cy_en_rtc_status_t timesync_step(int32_t step_s);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: timesync_now
+********************************************************************************
+* Summary:
+*  Returns the device time: the RTC time plus the correction of the last
+*  sync. It resolves milliseconds once an RTC alarm gave the timebase the
+*  phase of the RTC seconds; before that, it is within half a second.
+*
+* Parameters:
+*  uint32_t *epoch_s - destination, seconds since 1970-01-01, standard time
+*  uint32_t *ms      - destination, milliseconds of the second
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void timesync_now(uint32_t *epoch_s, uint32_t *ms)
+{
+    cy_stc_rtc_config_t now;
+    uint64_t rtc_us;
+    uint64_t time_ms;
+
+    if (!timebase_rtc_us(&rtc_us))
+    {
+        /* Within the second, the middle is the best guess */
+        Cy_RTC_GetDateAndTime(&now);
+        rtc_us = ((calendar_rtc_to_epoch(&now) - CALENDAR_EPOCH_RTC_BASE) * TIMESYNC_US_PER_S) +
+                 (TIMESYNC_US_PER_S / 2u);
+    }
+    time_ms = (CALENDAR_EPOCH_RTC_BASE * 1000u) + (rtc_us / 1000u) + (uint64_t)(int64_t)sync_stats.correction_ms;
+    *epoch_s = (uint32_t)(time_ms / 1000u);
+    *ms = (uint32_t)(time_ms % 1000u);
+}
+
+/*******************************************************************************
+* Function Name: timesync_apply
+********************************************************************************
+* Summary:
+*  Takes the offset measured by the host against timesync_now(). An offset
+*  of TIMESYNC_STEP_MS or more, as after a power cycle to the initial date,
+*  rewrites the RTC calendar; the caller must then set the alarm up again.
+*  A smaller one only moves the correction, which timesync_slew() carries
+*  into the alarm deadlines.
+*
+* Parameters:
+*  int64_t offset_ms  - host time minus device time, at the middle of the
+*                       exchange
+*  uint32_t delay_ms  - round trip of the exchange, less the device time
+*
+* Return:
+*  en_timesync_result_t - what was done
+*
+*******************************************************************************/
+en_timesync_result_t timesync_apply(int64_t offset_ms, uint32_t delay_ms)
+{
+    int64_t correction_ms;
+    int32_t step_s;
+
+    sync_stats.last_delay_ms = delay_ms;
+    if (delay_ms > TIMESYNC_MAX_DELAY_MS)
+    {
+        sync_stats.rejected++;
+        return TIMESYNC_REJECTED;
+    }
+    sync_stats.exchanges++;
+    sync_stats.last_offset_ms = (int32_t)((offset_ms > INT32_MAX) ? INT32_MAX :
+                                          ((offset_ms < INT32_MIN) ? INT32_MIN : offset_ms));
+
+    correction_ms = sync_stats.correction_ms + offset_ms;
+    if ((correction_ms > -TIMESYNC_STEP_MS) && (correction_ms < TIMESYNC_STEP_MS))
+    {
+        sync_stats.correction_ms = (int32_t)correction_ms;
+        return TIMESYNC_SLEWED;
+    }
+
+    /* Whole seconds go to the calendar, the rest stays a correction */
+    step_s = timesync_round_s(correction_ms);
+    if (CY_RTC_SUCCESS != timesync_step(step_s))
+    {
+        sync_stats.rejected++;
+        return TIMESYNC_REJECTED;
+    }
+    sync_stats.correction_ms = (int32_t)(correction_ms - ((int64_t)step_s * 1000));
+    sync_stats.applied_s = 0;
+    sync_stats.steps++;
+    slew_allowance_us = 0u;
+
+    return TIMESYNC_STEPPED;
+}
+
+/*******************************************************************************
+* Function Name: timesync_slew
+********************************************************************************
+* Summary:
+*  Call when an alarm deadline is set. Each wait earns TIMESYNC_SLEW_PPM of
+*  itself in slew; when a second is earned and the correction applied to the
+*  alarms lags the one measured, the applied correction moves by a second.
+*
+* Parameters:
+*  uint32_t wait_s - seconds from now to the alarm deadline
+*
+* Return:
+*  int32_t - seconds to take from the wait: -1, 0 or 1
+*
+*******************************************************************************/
+int32_t timesync_slew(uint32_t wait_s)
+{
+    int32_t target_s = timesync_round_s(sync_stats.correction_ms);
+    int32_t step_s;
+
+    slew_allowance_us += wait_s * TIMESYNC_SLEW_PPM;
+    if (slew_allowance_us > TIMESYNC_US_PER_S)
+    {
+        slew_allowance_us = TIMESYNC_US_PER_S;
+    }
+    if ((target_s == sync_stats.applied_s) || (slew_allowance_us < TIMESYNC_US_PER_S))
+    {
+        return 0;
+    }
+
+    step_s = (target_s > sync_stats.applied_s) ? 1 : -1;
+    sync_stats.applied_s += step_s;
+    sync_stats.slews++;
+    slew_allowance_us = 0u;
+
+    return step_s;
+}
+
+/*******************************************************************************
+* Function Name: timesync_correction_s
+********************************************************************************
+* Summary:
+*  Returns the correction applied to the alarm deadlines so far: local times
+*  of day are this much ahead of the RTC.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  int32_t - seconds
+*
+*******************************************************************************/
+int32_t timesync_correction_s(void)
+{
+    return sync_stats.applied_s;
+}
+
+/*******************************************************************************
+* Function Name: timesync_reset
+********************************************************************************
+* Summary:
+*  Drops the correction. Call after the RTC calendar is rewritten by other
+*  means, for example restored to the initial date.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void timesync_reset(void)
+{
+    sync_stats.correction_ms = 0;
+    sync_stats.applied_s = 0;
+    slew_allowance_us = 0u;
+}
+
+/*******************************************************************************
+* Function Name: timesync_get_stats
+********************************************************************************
+* Summary:
+*  Copies the synchronization statistics.
+*
+* Parameters:
+*  stc_timesync_stats_t *stats - destination
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void timesync_get_stats(stc_timesync_stats_t *stats)
+{
+    *stats = sync_stats;
+}
+
+/*******************************************************************************
+* Function Name: timesync_print
+********************************************************************************
+* Summary:
+*  Prints the correction and the exchanges.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void timesync_print(void)
+{
+    printf("Time sync: correction %ld ms, %ld s applied to the alarms\r\n",
+           (long)sync_stats.correction_ms, (long)sync_stats.applied_s);
+    printf("  %lu exchanges, %lu rejected, %lu steps, %lu slews\r\n",
+           (unsigned long)sync_stats.exchanges, (unsigned long)sync_stats.rejected,
+           (unsigned long)sync_stats.steps, (unsigned long)sync_stats.slews);
+    printf("  last offset %ld ms, round trip %lu ms\r\n",
+           (long)sync_stats.last_offset_ms, (unsigned long)sync_stats.last_delay_ms);
+}
+
+/*******************************************************************************
+* Function Name: timesync_round_s
+********************************************************************************
+* Summary:
+*  Rounds milliseconds to the nearest second, halves away from zero.
+*
+* Parameters:
+*  int64_t ms - milliseconds
+*
+* Return:
+*  int32_t - seconds
+*
+*******************************************************************************/
+static int32_t timesync_round_s(int64_t ms)
+{
+    return (int32_t)((ms + ((ms < 0) ? -500 : 500)) / 1000);
+}
+
+/*******************************************************************************
+* Function Name: timesync_step
+********************************************************************************
+* Summary:
+*  Moves the RTC calendar by whole seconds with Cy_RTC_SetDateAndTime(); the
+*  RTC is not initialized again. The DST table and the timebase follow the
+*  new calendar.
+*
+* Parameters:
+*  int32_t step_s - seconds to add
+*
+* Return:
+*  cy_en_rtc_status_t - result of the last write
+*
+*******************************************************************************/
+static cy_en_rtc_status_t timesync_step(int32_t step_s)
+{
+    cy_stc_rtc_config_t date_time;
+    uint32_t attempts = TIMESYNC_WRITE_ATTEMPTS;
+    cy_en_rtc_status_t rtc_result;
+    uint64_t epoch_s;
+
+    do
+    {
+        Cy_RTC_GetDateAndTime(&date_time);
+        epoch_s = (uint64_t)((int64_t)calendar_rtc_to_epoch(&date_time) + step_s);
+        if (epoch_s < CALENDAR_EPOCH_RTC_BASE)
+        {
+            return CY_RTC_BAD_PARAM;
+        }
+        calendar_epoch_to_rtc(epoch_s, &date_time);
+        rtc_result = Cy_RTC_SetDateAndTime(&date_time);
+        attempts--;
+        if (CY_RTC_SUCCESS != rtc_result)
+        {
+            Cy_SysLib_Delay(TIMESYNC_WRITE_DELAY_MS);
+        }
+    } while ((CY_RTC_SUCCESS != rtc_result) && (0u != attempts));
+
+    if (CY_RTC_SUCCESS == rtc_result)
+    {
+        dst_init((uint32_t)(epoch_s - CALENDAR_EPOCH_RTC_BASE));
+        timebase_rtc_changed();
+    }
+    return rtc_result;
+}
+
+/* [] END OF FILE */
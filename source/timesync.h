@@ -0,0 +1,98 @@
+/*******************************************************************************
+* File Name:   timesync.h
+*
+* Description: This file contains the interface of the time synchronization
+*              with a host over the debug UART.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_TIMESYNC_H_
+#define SOURCE_TIMESYNC_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Offsets from this on step the RTC calendar; smaller ones are slewed */
+#define TIMESYNC_STEP_MS            (60000)
+
+/* Most the alarm deadlines are moved, per time waited for them */
+#define TIMESYNC_SLEW_PPM           (1000u)
+
+/* Exchanges with a longer round trip are too uncertain to use */
+#define TIMESYNC_MAX_DELAY_MS       (250u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef enum
+{
+    TIMESYNC_REJECTED   = 0u,   /* Round trip too long, nothing changed */
+    TIMESYNC_SLEWED     = 1u,   /* Correction taken, the alarms follow it */
+    TIMESYNC_STEPPED    = 2u,   /* RTC calendar rewritten */
+} en_timesync_result_t;
+
+typedef struct
+{
+    uint32_t    exchanges;      /* Offsets taken */
+    uint32_t    rejected;       /* Offsets with a round trip too long */
+    uint32_t    steps;          /* RTC calendar rewrites */
+    uint32_t    slews;          /* Alarm deadlines moved by a second */
+    int32_t     last_offset_ms; /* Host minus device at the last exchange */
+    uint32_t    last_delay_ms;  /* Round trip of the last exchange */
+    int32_t     correction_ms;  /* Host time minus RTC time */
+    int32_t     applied_s;      /* Part of it applied to the alarm deadlines */
+} stc_timesync_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void timesync_now(uint32_t *epoch_s, uint32_t *ms);
+en_timesync_result_t timesync_apply(int64_t offset_ms, uint32_t delay_ms);
+int32_t timesync_slew(uint32_t wait_s);
+int32_t timesync_correction_s(void);
+void timesync_reset(void);
+void timesync_get_stats(stc_timesync_stats_t *stats);
+void timesync_print(void);
+
+#endif /* SOURCE_TIMESYNC_H_ */
+
+/* [] END OF FILE */
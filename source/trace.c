@@ -0,0 +1,170 @@
+/*******************************************************************************
+* File Name:   trace.c
+*
+* Description: This file implements the event trace. Events are stamped with the
+*              low-power timer and kept in a ring that overwrites the oldest entry.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdio.h>
+#include "trace.h"
+#include "timebase.h"
+#include "sram_retain.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const char *const trace_names[TRACE_EVENT_COUNT] =
+{
+    "boot",
+    "wakeup",
+    "deepsleep",
+    "hibernate",
+    "gesture",
+    "command",
+    "alarm set",
+    "batch",
+    "overrun"
+};
+
+static stc_trace_entry_t trace_ring[TRACE_SIZE] SRAM_RETAIN;
+static uint32_t trace_count = 0u;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: trace_record
+********************************************************************************
+* Summary:
+*  Records an event. Safe to call from interrupts.
+*
+* Parameters:
+*  en_trace_event_t event - event type
+*  uint32_t arg           - event argument
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void trace_record(en_trace_event_t event, uint32_t arg)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+    stc_trace_entry_t *entry = &trace_ring[trace_count & (TRACE_SIZE - 1u)];
+
+    entry->timestamp = timebase_now_us();
+    entry->event = (uint32_t)event;
+    entry->arg = arg;
+    trace_count++;
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/*******************************************************************************
+* Function Name: trace_dump
+********************************************************************************
+* Summary:
+*  Prints the recorded events, oldest first, with timestamps in milliseconds.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void trace_dump(void)
+{
+    uint32_t first = (trace_count > TRACE_SIZE) ? (trace_count - TRACE_SIZE) : 0u;
+    uint32_t i;
+    stc_trace_entry_t entry;
+
+    printf("Trace: %lu events, last %lu\r\n", (unsigned long)trace_count,
+           (unsigned long)(trace_count - first));
+    for (i = first; i < trace_count; i++)
+    {
+        entry = trace_ring[i & (TRACE_SIZE - 1u)];
+        printf("%10lu ms  %-10s %lu\r\n",
+               (unsigned long)(entry.timestamp / 1000u),
+               trace_names[entry.event], (unsigned long)entry.arg);
+    }
+    printf("\r\n");
+}
+
+/*******************************************************************************
+* Function Name: trace_span
+********************************************************************************
+* Summary:
+*  Gives the recorded events from index 'first' on, in place: as many as lie
+*  in one piece of the ring. Events overwritten since are skipped.
+*
+* Parameters:
+*  uint32_t *first                    - index of the event wanted, counted
+*                                       since boot; moved to the oldest kept
+*  const stc_trace_entry_t **entries  - destination, first entry of the piece
+*
+* Return:
+*  uint32_t - entries in the piece, 0 if none was recorded from 'first' on
+*
+*******************************************************************************/
+uint32_t trace_span(uint32_t *first, const stc_trace_entry_t **entries)
+{
+    uint32_t count = trace_count;
+    uint32_t slot;
+    uint32_t span;
+
+    if ((count - *first) > TRACE_SIZE)
+    {
+        *first = count - TRACE_SIZE;
+    }
+    slot = *first & (TRACE_SIZE - 1u);
+    span = count - *first;
+    if (span > (TRACE_SIZE - slot))
+    {
+        span = TRACE_SIZE - slot;
+    }
+    *entries = &trace_ring[slot];
+
+    return span;
+}
+
+/* [] END OF FILE */
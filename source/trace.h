@@ -0,0 +1,90 @@
+/*******************************************************************************
+* File Name:   trace.h
+*
+* Description: This file contains the interface of the event trace: a small ring
+*              of timestamped events dumped on request.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_TRACE_H_
+#define SOURCE_TRACE_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TRACE_SIZE                  (32u)   /* Power of two */
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef enum
+{
+    TRACE_EVENT_BOOT        = 0u,   /* arg: en_wake_source_t boot cause */
+    TRACE_EVENT_WAKEUP      = 1u,   /* arg: en_wake_source_t */
+    TRACE_EVENT_DEEPSLEEP   = 2u,   /* arg: alarm period (s) */
+    TRACE_EVENT_HIBERNATE   = 3u,   /* arg: alarm period (s) */
+    TRACE_EVENT_GESTURE     = 4u,   /* arg: en_gesture_t */
+    TRACE_EVENT_COMMAND     = 5u,   /* arg: command index */
+    TRACE_EVENT_ALARM_SET   = 6u,   /* arg: alarm period (s) */
+    TRACE_EVENT_BATCH       = 7u,   /* arg: samples, bit 31 if a threshold tripped */
+    TRACE_EVENT_OVERRUN     = 8u,   /* arg: job index */
+    TRACE_EVENT_COUNT       = 9u,
+} en_trace_event_t;
+
+/* Recorded event; its layout is also the uplink format of the trace */
+typedef struct
+{
+    uint64_t            timestamp;  /* Timebase microseconds */
+    uint32_t            arg;
+    uint32_t            event;      /* en_trace_event_t */
+} stc_trace_entry_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void trace_record(en_trace_event_t event, uint32_t arg);
+void trace_dump(void);
+uint32_t trace_span(uint32_t *first, const stc_trace_entry_t **entries);
+
+#endif /* SOURCE_TRACE_H_ */
+
+/* [] END OF FILE */
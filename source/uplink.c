@@ -0,0 +1,590 @@
+/*******************************************************************************
+* File Name:   uplink.c
+*
+* Description: This file contains the framed telemetry uplink over the debug
+*              UART. The flash log records and the trace events are sent as
+*              COBS frames with a CRC16 and a sequence number, encoded straight
+*              from where they are stored. The host acknowledges frames; acked
+*              data is not sent again.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "cybsp.h"
+#include "uplink.h"
+#include "crc16.h"
+#include "flash_log.h"
+#include "trace.h"
+#include "retained.h"
+#include "debug_uart.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define UPLINK_COBS_MAX_RUN         (254u)  /* Data bytes of a full COBS block */
+#define UPLINK_DELIMITER            (0x00u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef enum
+{
+    UPLINK_STREAM_LOG   = 0u,   /* Flash log records, by log position */
+    UPLINK_STREAM_TRACE = 1u,   /* Trace events, by index since boot */
+    UPLINK_STREAM_COUNT = 2u,
+} en_uplink_stream_t;
+
+/* Unencoded bytes of a frame, in place */
+typedef struct
+{
+    const uint8_t   *data;
+    uint32_t        size;
+} stc_uplink_segment_t;
+
+/* Frame of the last burst; an ack of it releases its stream up to 'next' */
+typedef struct
+{
+    stc_uplink_header_t header;
+    const uint8_t       *payload;
+    uint32_t            size;
+    en_uplink_stream_t  stream;
+    uint32_t            next;
+} stc_uplink_frame_t;
+
+typedef void (*uplink_write_t)(void *context, const uint8_t *data, uint32_t size);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static stc_uplink_frame_t uplink_flight[UPLINK_WINDOW];
+static uint32_t uplink_flight_count = 0u;
+static uint16_t uplink_seq = 0u;
+
+/* Stream positions the host acked, and the ends of what was ever sent */
+static uint32_t uplink_acked[UPLINK_STREAM_COUNT];
+static uint32_t uplink_sent[UPLINK_STREAM_COUNT];
+
+static stc_uplink_stats_t uplink_stats;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint32_t cobs_emit(const stc_uplink_segment_t *segments, uint32_t count,
+                          uplink_write_t write, void *context);
+static uint8_t segment_byte(const stc_uplink_segment_t *segments, uint32_t count, uint32_t index);
+static void segment_write(const stc_uplink_segment_t *segments, uint32_t count, uint32_t start,
+                          uint32_t size, uplink_write_t write, void *context);
+static void uplink_send_frame(const stc_uplink_frame_t *frame);
+static void uart_write(void *context, const uint8_t *data, uint32_t size);
+static void buffer_write(void *context, const uint8_t *data, uint32_t size);
+static bool uplink_queue(en_uplink_stream_t stream, uint8_t type, uint32_t position,
+                         const void *payload, uint32_t size, uint32_t next);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: uplink_init
+********************************************************************************
+* Summary:
+*  Resumes from the flash log position the host acked, kept across resets in
+*  the backup registers. The trace restarts with the boot.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uplink_init(void)
+{
+    uplink_acked[UPLINK_STREAM_LOG] = retained_read(RETAINED_SLOT_UPLINK_LOG);
+    uplink_sent[UPLINK_STREAM_LOG] = uplink_acked[UPLINK_STREAM_LOG];
+    uplink_acked[UPLINK_STREAM_TRACE] = 0u;
+    uplink_sent[UPLINK_STREAM_TRACE] = 0u;
+    uplink_flight_count = 0u;
+}
+
+/*******************************************************************************
+* Function Name: uplink_send
+********************************************************************************
+* Summary:
+*  Sends a burst of up to UPLINK_WINDOW frames: the flash log records, then
+*  the trace events, from the positions the host acked. Data of the previous
+*  burst that was not acked is sent again (go-back-N), under new sequence
+*  numbers. Frames point into the flash log and the trace ring: nothing is
+*  copied.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t - frames sent
+*
+*******************************************************************************/
+uint32_t uplink_send(void)
+{
+    stc_flash_log_cursor_t cursor = { 0u, 0u };
+    stc_flash_log_ref_t ref;
+    const stc_trace_entry_t *entries;
+    uint32_t first;
+    uint32_t count;
+    uint32_t i;
+    bool room = true;
+
+    uplink_flight_count = 0u;
+
+    while (room && flash_log_next_ref(&cursor, &ref))
+    {
+        if ((int32_t)(ref.position - uplink_acked[UPLINK_STREAM_LOG]) >= 0)
+        {
+            room = uplink_queue(UPLINK_STREAM_LOG, (uint8_t)ref.type, ref.position,
+                                ref.payload, ref.size, ref.position + 1u);
+        }
+    }
+
+    first = uplink_acked[UPLINK_STREAM_TRACE];
+    count = trace_span(&first, &entries);
+    if (first != uplink_acked[UPLINK_STREAM_TRACE])
+    {
+        uplink_stats.trace_lost += first - uplink_acked[UPLINK_STREAM_TRACE];
+        uplink_acked[UPLINK_STREAM_TRACE] = first;
+    }
+    while (room && (0u != count))
+    {
+        count = (count > UPLINK_TRACE_PER_FRAME) ? UPLINK_TRACE_PER_FRAME : count;
+        room = uplink_queue(UPLINK_STREAM_TRACE, UPLINK_TYPE_TRACE, first,
+                            entries, count * sizeof(stc_trace_entry_t), first + count);
+        first += count;
+        count = trace_span(&first, &entries);
+    }
+
+    if (0u == uplink_flight_count)
+    {
+        return 0u;
+    }
+
+    uplink_flight[0].header.flags |= UPLINK_FLAG_FIRST;
+    uplink_flight[uplink_flight_count - 1u].header.flags |= UPLINK_FLAG_LAST;
+
+    debug_uart_acquire();
+    for (i = 0u; i < uplink_flight_count; i++)
+    {
+        uplink_send_frame(&uplink_flight[i]);
+    }
+    uplink_stats.bursts++;
+
+    return uplink_flight_count;
+}
+
+/*******************************************************************************
+* Function Name: uplink_ack
+********************************************************************************
+* Summary:
+*  Takes a cumulative ack: the host received every frame of the last burst
+*  up to 'seq'. Their data is released and not sent again; the flash log
+*  position is kept in the backup registers.
+*
+* Parameters:
+*  uint16_t seq - sequence number of the last frame received in order
+*
+* Return:
+*  bool - false if no frame of the last burst has this sequence number
+*
+*******************************************************************************/
+bool uplink_ack(uint16_t seq)
+{
+    uint32_t acked = 0u;
+    uint32_t i;
+
+    while ((acked < uplink_flight_count) && (uplink_flight[acked].header.seq != seq))
+    {
+        acked++;
+    }
+    if (acked == uplink_flight_count)
+    {
+        uplink_stats.bad_acks++;
+        return false;
+    }
+    acked++;
+
+    for (i = 0u; i < acked; i++)
+    {
+        uplink_acked[uplink_flight[i].stream] = uplink_flight[i].next;
+    }
+    retained_write(RETAINED_SLOT_UPLINK_LOG, uplink_acked[UPLINK_STREAM_LOG]);
+
+    uplink_flight_count -= acked;
+    memmove(&uplink_flight[0], &uplink_flight[acked], uplink_flight_count * sizeof(uplink_flight[0]));
+    uplink_stats.acks++;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: uplink_cobs_encode
+********************************************************************************
+* Summary:
+*  COBS-encodes a buffer with the encoder of the frames, without the
+*  delimiters. The output is at most size + size / 254 + 1 bytes.
+*
+* Parameters:
+*  const uint8_t *data - bytes to encode
+*  uint32_t size       - number of bytes
+*  uint8_t *out        - destination
+*
+* Return:
+*  uint32_t - encoded bytes
+*
+*******************************************************************************/
+uint32_t uplink_cobs_encode(const uint8_t *data, uint32_t size, uint8_t *out)
+{
+    stc_uplink_segment_t segment = { data, size };
+    uint8_t *cursor = out;
+
+    return cobs_emit(&segment, 1u, buffer_write, &cursor);
+}
+
+/*******************************************************************************
+* Function Name: uplink_get_stats
+********************************************************************************
+* Summary:
+*  Copies the uplink statistics.
+*
+* Parameters:
+*  stc_uplink_stats_t *stats - destination
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uplink_get_stats(stc_uplink_stats_t *stats)
+{
+    *stats = uplink_stats;
+}
+
+/*******************************************************************************
+* Function Name: uplink_print
+********************************************************************************
+* Summary:
+*  Prints the uplink counters and the acked positions.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uplink_print(void)
+{
+    printf("Uplink: %lu bursts, %lu frames, %lu bytes, %lu sent again\r\n",
+           (unsigned long)uplink_stats.bursts, (unsigned long)uplink_stats.frames,
+           (unsigned long)uplink_stats.bytes, (unsigned long)uplink_stats.resent);
+    printf("  %lu acks, %lu unknown; acked log position %lu, trace event %lu, %lu events lost\r\n",
+           (unsigned long)uplink_stats.acks, (unsigned long)uplink_stats.bad_acks,
+           (unsigned long)uplink_acked[UPLINK_STREAM_LOG],
+           (unsigned long)uplink_acked[UPLINK_STREAM_TRACE],
+           (unsigned long)uplink_stats.trace_lost);
+}
+
+/*******************************************************************************
+* Function Name: uplink_queue
+********************************************************************************
+* Summary:
+*  Adds a frame to the burst being built.
+*
+* Parameters:
+*  en_uplink_stream_t stream - stream of the data
+*  uint8_t type              - frame type
+*  uint32_t position         - stream position of the data
+*  const void *payload       - data, in place
+*  uint32_t size             - bytes
+*  uint32_t next             - stream position after the data
+*
+* Return:
+*  bool - false once the burst is full
+*
+*******************************************************************************/
+static bool uplink_queue(en_uplink_stream_t stream, uint8_t type, uint32_t position,
+                         const void *payload, uint32_t size, uint32_t next)
+{
+    stc_uplink_frame_t *frame = &uplink_flight[uplink_flight_count];
+
+    frame->header.type = type;
+    frame->header.flags = 0u;
+    frame->header.seq = uplink_seq++;
+    frame->header.position = position;
+    frame->payload = (const uint8_t *)payload;
+    frame->size = size;
+    frame->stream = stream;
+    frame->next = next;
+
+    if ((int32_t)(position - uplink_sent[stream]) < 0)
+    {
+        uplink_stats.resent++;
+    }
+    else
+    {
+        uplink_sent[stream] = next;
+    }
+    uplink_flight_count++;
+
+    return (uplink_flight_count < UPLINK_WINDOW);
+}
+
+/*******************************************************************************
+* Function Name: uplink_send_frame
+********************************************************************************
+* Summary:
+*  Sends one frame: the header, the payload and their CRC16, COBS-encoded
+*  between two delimiters. The leading delimiter separates the frame from
+*  any text sent before it.
+*
+* Parameters:
+*  const stc_uplink_frame_t *frame - frame
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void uplink_send_frame(const stc_uplink_frame_t *frame)
+{
+    static const uint8_t delimiter = UPLINK_DELIMITER;
+    uint16_t crc;
+    uint8_t crc_bytes[2];
+    stc_uplink_segment_t segments[3];
+
+    crc = crc16_update(CRC16_INIT, &frame->header, sizeof(frame->header));
+    crc = crc16_update(crc, frame->payload, frame->size);
+    crc_bytes[0] = (uint8_t)crc;
+    crc_bytes[1] = (uint8_t)(crc >> 8);
+
+    segments[0].data = (const uint8_t *)&frame->header;
+    segments[0].size = sizeof(frame->header);
+    segments[1].data = frame->payload;
+    segments[1].size = frame->size;
+    segments[2].data = crc_bytes;
+    segments[2].size = sizeof(crc_bytes);
+
+    uart_write(NULL, &delimiter, 1u);
+    uplink_stats.bytes += cobs_emit(segments, 3u, uart_write, NULL) + 2u;
+    uart_write(NULL, &delimiter, 1u);
+    uplink_stats.frames++;
+}
+
+/*******************************************************************************
+* Function Name: cobs_emit
+********************************************************************************
+* Summary:
+*  COBS-encodes the bytes of the segments as one sequence. Each block is a
+*  code byte, the number of data bytes plus one, and up to 254 data bytes
+*  up to the next zero, which the code stands for. The data bytes are
+*  written from the segments themselves.
+*
+* Parameters:
+*  const stc_uplink_segment_t *segments - bytes to encode, in order
+*  uint32_t count                       - number of segments
+*  uplink_write_t write                 - output
+*  void *context                        - passed to 'write'
+*
+* Return:
+*  uint32_t - encoded bytes
+*
+*******************************************************************************/
+static uint32_t cobs_emit(const stc_uplink_segment_t *segments, uint32_t count,
+                          uplink_write_t write, void *context)
+{
+    uint32_t total = 0u;
+    uint32_t position = 0u;
+    uint32_t written = 0u;
+    uint32_t run;
+    uint32_t i;
+    uint8_t code;
+
+    for (i = 0u; i < count; i++)
+    {
+        total += segments[i].size;
+    }
+
+    for (;;)
+    {
+        run = 0u;
+        while (((position + run) < total) && (run < UPLINK_COBS_MAX_RUN) &&
+               (0u != segment_byte(segments, count, position + run)))
+        {
+            run++;
+        }
+        code = (uint8_t)(run + 1u);
+        write(context, &code, 1u);
+        segment_write(segments, count, position, run, write, context);
+        written += 1u + run;
+        position += run;
+
+        if (position >= total)
+        {
+            break;
+        }
+        if (run < UPLINK_COBS_MAX_RUN)
+        {
+            /* The zero that ended the run */
+            position++;
+        }
+    }
+
+    return written;
+}
+
+/*******************************************************************************
+* Function Name: segment_byte
+********************************************************************************
+* Summary:
+*  Returns a byte of the segments, counted across them.
+*
+* Parameters:
+*  const stc_uplink_segment_t *segments - segments
+*  uint32_t count                       - number of segments
+*  uint32_t index                       - byte index, below their total size
+*
+* Return:
+*  uint8_t - byte
+*
+*******************************************************************************/
+static uint8_t segment_byte(const stc_uplink_segment_t *segments, uint32_t count, uint32_t index)
+{
+    uint32_t i = 0u;
+
+    while ((i < (count - 1u)) && (index >= segments[i].size))
+    {
+        index -= segments[i].size;
+        i++;
+    }
+
+    return segments[i].data[index];
+}
+
+/*******************************************************************************
+* Function Name: segment_write
+********************************************************************************
+* Summary:
+*  Writes a range of the bytes of the segments, a piece per segment.
+*
+* Parameters:
+*  const stc_uplink_segment_t *segments - segments
+*  uint32_t count                       - number of segments
+*  uint32_t start                       - first byte, counted across them
+*  uint32_t size                        - bytes to write
+*  uplink_write_t write                 - output
+*  void *context                        - passed to 'write'
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void segment_write(const stc_uplink_segment_t *segments, uint32_t count, uint32_t start,
+                          uint32_t size, uplink_write_t write, void *context)
+{
+    uint32_t i;
+    uint32_t piece;
+
+    for (i = 0u; (i < count) && (0u != size); i++)
+    {
+        if (start >= segments[i].size)
+        {
+            start -= segments[i].size;
+            continue;
+        }
+        piece = segments[i].size - start;
+        piece = (piece > size) ? size : piece;
+        write(context, &segments[i].data[start], piece);
+        size -= piece;
+        start = 0u;
+    }
+}
+
+/*******************************************************************************
+* Function Name: uart_write
+********************************************************************************
+* Summary:
+*  Output of the frames: the debug UART, blocking while its FIFO is full.
+*
+* Parameters:
+*  void *context        - unused
+*  const uint8_t *data  - bytes
+*  uint32_t size        - number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void uart_write(void *context, const uint8_t *data, uint32_t size)
+{
+    (void)context;
+    Cy_SCB_UART_PutArrayBlocking(DEBUG_UART_HW, (void *)data, size);
+}
+
+/*******************************************************************************
+* Function Name: buffer_write
+********************************************************************************
+* Summary:
+*  Output of uplink_cobs_encode(): appends to a buffer.
+*
+* Parameters:
+*  void *context        - uint8_t ** write position, advanced
+*  const uint8_t *data  - bytes
+*  uint32_t size        - number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void buffer_write(void *context, const uint8_t *data, uint32_t size)
+{
+    uint8_t **cursor = (uint8_t **)context;
+
+    memcpy(*cursor, data, size);
+    *cursor += size;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,100 @@
+/*******************************************************************************
+* File Name:   uplink.h
+*
+* Description: This file contains the interface of the framed telemetry uplink
+*              over the debug UART.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_UPLINK_H_
+#define SOURCE_UPLINK_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define UPLINK_WINDOW               (4u)    /* Frames sent per burst, unacked */
+#define UPLINK_TRACE_PER_FRAME      (4u)    /* Trace events per frame */
+
+/* Frame types above the flash log record types */
+#define UPLINK_TYPE_TRACE           (0x10u)
+
+/* Frame flags */
+#define UPLINK_FLAG_FIRST           (0x01u) /* First frame of a burst */
+#define UPLINK_FLAG_LAST            (0x02u) /* Last frame of a burst */
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Frame header, little-endian. The payload and a CRC16 of both follow; the
+   frame is COBS-encoded between two zero bytes. */
+typedef struct
+{
+    uint8_t     type;       /* en_flash_log_type_t or UPLINK_TYPE_TRACE */
+    uint8_t     flags;
+    uint16_t    seq;        /* Frame sequence number, acked by the host */
+    uint32_t    position;   /* Flash log position, or trace event index */
+} stc_uplink_header_t;
+
+typedef struct
+{
+    uint32_t    bursts;
+    uint32_t    frames;
+    uint32_t    bytes;          /* On the wire, delimiters included */
+    uint32_t    resent;         /* Frames of data sent before, not acked */
+    uint32_t    acks;
+    uint32_t    bad_acks;       /* Acks of no frame in flight */
+    uint32_t    trace_lost;     /* Events overwritten before they were acked */
+} stc_uplink_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void uplink_init(void);
+uint32_t uplink_send(void);
+bool uplink_ack(uint16_t seq);
+uint32_t uplink_cobs_encode(const uint8_t *data, uint32_t size, uint8_t *out);
+void uplink_get_stats(stc_uplink_stats_t *stats);
+void uplink_print(void);
+
+#endif /* SOURCE_UPLINK_H_ */
+
+/* [] END OF FILE */
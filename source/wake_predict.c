@@ -0,0 +1,470 @@
+/*******************************************************************************
+* File Name:   wake_predict.c
+*
+* Description: This file implements the pre-armed DeepSleep wakeup. The RTC
+*              alarm fires on second boundaries; the low-power timer wakes the
+*              CPU ahead of the boundary by the learned clock start latency so
+*              the job starts on the deadline rather than after it.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "wake_predict.h"
+#include "lptimer.h"
+#include "wake_source.h"
+#include "residency.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define WAKE_PREDICT_GUARD_TICKS    (2u)    /* Margin on top of the latency */
+#define WAKE_PREDICT_EWMA_SHIFT     (3u)    /* Latency filter weight: 1/8 */
+#define WAKE_PREDICT_FRAC_BITS      (4u)    /* Fixed-point bits of the filter */
+#define WAKE_PREDICT_RTC_ATTEMPTS   (3u)    /* Writes of the ALARM_1 guard back */
+#define WAKE_PREDICT_SECONDS_PER_DAY (86400u)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Timebase value of an RTC second boundary. Both the RTC and the low-power
+   timer run from LFCLK, so every later boundary is a multiple of
+   LPTIMER_CLOCK_HZ away from it. */
+static volatile uint32_t boundary_phase;
+static volatile bool phase_synced = false;
+static volatile bool in_deepsleep = false;
+
+/* Deadline of the armed RTC alarm, if known */
+static uint32_t alarm_deadline;
+static bool alarm_deadline_valid = false;
+
+/* Learned wake latency in ticks, fixed point */
+static uint32_t latency_fp;
+static uint32_t lead_ticks;
+
+static stc_wake_predict_stats_t wake_stats;
+
+/* ALARM_1 holds the pre-alarm of a long wait; the guard is saved meanwhile */
+static volatile bool pre_alarm_pending = false;
+static cy_stc_rtc_alarm_t guard_saved;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static bool wake_predict_arm_pre_alarm(uint32_t deadline);
+static void wake_predict_restore_guard(void);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: wake_predict_init
+********************************************************************************
+* Summary:
+*  Starts the low-power timer and seeds the latency estimate.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wake_predict_init(void)
+{
+    lptimer_init();
+
+    latency_fp = LPTIMER_US_TO_TICKS(WAKE_PREDICT_INITIAL_LATENCY_US) << WAKE_PREDICT_FRAC_BITS;
+    lead_ticks = (latency_fp >> WAKE_PREDICT_FRAC_BITS) + WAKE_PREDICT_GUARD_TICKS;
+
+    memset(&wake_stats, 0, sizeof(wake_stats));
+    wake_stats.min_jitter_us = INT32_MAX;
+    wake_stats.max_jitter_us = INT32_MIN;
+}
+
+/*******************************************************************************
+* Function Name: wake_predict_on_second_tick
+********************************************************************************
+* Summary:
+*  Called from the RTC alarm interrupt. While the CPU is active the interrupt
+*  latency is negligible, so the current timebase value marks an RTC second
+*  boundary. Samples taken on a DeepSleep exit are skipped because they include
+*  the wake latency.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wake_predict_on_second_tick(void)
+{
+    if (!in_deepsleep)
+    {
+        boundary_phase = lptimer_now();
+        phase_synced = true;
+    }
+}
+
+/*******************************************************************************
+* Function Name: wake_predict_on_pre_alarm
+********************************************************************************
+* Summary:
+*  Called first from the RTC ALARM_1 interrupt. Takes the pre-alarm that ends
+*  the long part of a wait, so that it is not mistaken for the guard of the
+*  schedule alarm.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - true if the interrupt was the pre-alarm and needs no other handling
+*
+*******************************************************************************/
+bool wake_predict_on_pre_alarm(void)
+{
+    bool taken = pre_alarm_pending;
+
+    pre_alarm_pending = false;
+    return taken;
+}
+
+/*******************************************************************************
+* Function Name: wake_predict_set_deadline
+********************************************************************************
+* Summary:
+*  Records the timebase value of the RTC alarm just armed: the end of the
+*  current RTC second plus 'seconds' - 1. Call right after reading the RTC
+*  time the alarm was computed from.
+*
+* Parameters:
+*  uint32_t seconds - alarm distance in RTC second boundaries (>= 1)
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wake_predict_set_deadline(uint32_t seconds)
+{
+    uint32_t now;
+
+    alarm_deadline_valid = false;
+    if ((!phase_synced) || (0u == seconds))
+    {
+        return;
+    }
+
+    now = lptimer_now();
+    alarm_deadline = now + (LPTIMER_CLOCK_HZ - ((now - boundary_phase) % LPTIMER_CLOCK_HZ)) +
+                     ((seconds - 1u) * LPTIMER_CLOCK_HZ);
+    alarm_deadline_valid = true;
+}
+
+/*******************************************************************************
+* Function Name: wake_predict_enter_deepsleep
+********************************************************************************
+* Summary:
+*  Enters DeepSleep and returns on the deadline of the armed RTC alarm, or on
+*  the next RTC second boundary that is at least one lead time away if no
+*  deadline was set. The low-power timer wakes the CPU 'lead' ticks
+*  early, the remaining time is spent spinning on the timebase, and the measured
+*  exit latency refines the lead for the next wakeup. A wait longer than one
+*  match of the low-power timer is first slept on an RTC ALARM_1 pre-alarm on
+*  the second before the deadline, so counter 0 times only the final second
+*  instead of waking the CPU about every two seconds. Falls back to a plain
+*  DeepSleep (RTC alarm wakeup) until the boundary phase is known. A user
+*  button or UART wakeup ends the DeepSleep early; check wake_source_take()
+*  on return.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_en_syspm_status_t - status of the DeepSleep transition
+*
+*******************************************************************************/
+cy_en_syspm_status_t wake_predict_enter_deepsleep(void)
+{
+    cy_en_syspm_status_t status = CY_SYSPM_SUCCESS;
+    uint32_t now, elapsed, deadline, wake_at, t_wake, t_start, sample;
+    int32_t jitter_us;
+    bool pre_alarm_seen;
+
+    if (!phase_synced)
+    {
+        in_deepsleep = true;
+        do
+        {
+            residency_enter(POWER_MODE_DEEPSLEEP);
+            status = Cy_SysPm_CpuEnterDeepSleep(CY_SYSPM_WAIT_FOR_INTERRUPT);
+            residency_enter(POWER_MODE_ACTIVE);
+        } while ((CY_SYSPM_SUCCESS == status) &&
+                 !wake_source_is_pending(WAKE_SOURCE_RTC_ALARM) &&
+                 !wake_source_is_operator_pending());
+        in_deepsleep = false;
+        return status;
+    }
+
+    now = lptimer_now();
+    if (alarm_deadline_valid && (((int32_t)(alarm_deadline - now)) > 0))
+    {
+        deadline = alarm_deadline;
+    }
+    else
+    {
+        /* Next boundary at least one lead time ahead */
+        elapsed = (now + lead_ticks) - boundary_phase;
+        deadline = now + lead_ticks + ((LPTIMER_CLOCK_HZ - (elapsed % LPTIMER_CLOCK_HZ)) % LPTIMER_CLOCK_HZ);
+    }
+    alarm_deadline_valid = false;
+
+    /* A wakeup target already past expires at once and the CPU spins */
+    wake_at = deadline - lead_ticks;
+
+    in_deepsleep = true;
+    if ((((int32_t)(wake_at - now)) > (int32_t)LPTIMER_MAX_ARM_TICKS) &&
+        wake_predict_arm_pre_alarm(deadline))
+    {
+        /* The schedule alarm also ends the wait, should the pre-alarm be lost */
+        while (pre_alarm_pending && (CY_SYSPM_SUCCESS == status) &&
+               !wake_source_is_pending(WAKE_SOURCE_RTC_ALARM) &&
+               !wake_source_is_operator_pending())
+        {
+            residency_enter(POWER_MODE_DEEPSLEEP);
+            status = Cy_SysPm_CpuEnterDeepSleep(CY_SYSPM_WAIT_FOR_INTERRUPT);
+            residency_enter(POWER_MODE_ACTIVE);
+        }
+        pre_alarm_seen = !pre_alarm_pending;
+        wake_predict_restore_guard();
+        if ((CY_SYSPM_SUCCESS != status) || wake_source_is_operator_pending())
+        {
+            in_deepsleep = false;
+            return status;
+        }
+        if (pre_alarm_seen)
+        {
+            wake_stats.pre_alarms++;
+        }
+    }
+
+    lptimer_arm(LPTIMER_CH_WAKE, wake_at);
+    while (!lptimer_is_expired(LPTIMER_CH_WAKE))
+    {
+        /* Earlier RTC alarms and other interrupts are ignored; the deadline
+           is the boundary after them */
+        residency_enter(POWER_MODE_DEEPSLEEP);
+        status = Cy_SysPm_CpuEnterDeepSleep(CY_SYSPM_WAIT_FOR_INTERRUPT);
+        residency_enter(POWER_MODE_ACTIVE);
+        if ((CY_SYSPM_SUCCESS != status) || wake_source_is_operator_pending())
+        {
+            /* Woken by the operator or failed: no deadline to meet */
+            lptimer_disarm(LPTIMER_CH_WAKE);
+            in_deepsleep = false;
+            return status;
+        }
+    }
+    t_wake = lptimer_now();
+    in_deepsleep = false;
+
+    /* Hold the CPU until the deadline; the job starts on return */
+    while (((int32_t)(lptimer_now() - deadline)) < 0)
+    {
+    }
+    t_start = lptimer_now();
+
+    /* Learn the exit latency: fast attack on late wakes, slow decay otherwise.
+       A wakeup that never slept says nothing about the latency. */
+    sample = (t_wake - wake_at) << WAKE_PREDICT_FRAC_BITS;
+    if (((int32_t)(wake_at - now)) > 0)
+    {
+        if ((((int32_t)(t_wake - deadline)) > 0) || (sample > latency_fp))
+        {
+            latency_fp = sample;
+        }
+        else
+        {
+            latency_fp -= (latency_fp - sample) >> WAKE_PREDICT_EWMA_SHIFT;
+        }
+    }
+    lead_ticks = ((latency_fp + (1u << WAKE_PREDICT_FRAC_BITS) - 1u) >> WAKE_PREDICT_FRAC_BITS)
+                 + WAKE_PREDICT_GUARD_TICKS;
+
+    /* Report the achieved jitter */
+    jitter_us = (int32_t)(t_start - deadline);
+    jitter_us = (jitter_us >= 0) ? (int32_t)LPTIMER_TICKS_TO_US(jitter_us)
+                                 : -(int32_t)LPTIMER_TICKS_TO_US(-jitter_us);
+    wake_stats.wakes++;
+    if (((int32_t)(t_wake - deadline)) > 0)
+    {
+        wake_stats.late_wakes++;
+    }
+    wake_stats.last_jitter_us = jitter_us;
+    if (jitter_us < wake_stats.min_jitter_us)
+    {
+        wake_stats.min_jitter_us = jitter_us;
+    }
+    if (jitter_us > wake_stats.max_jitter_us)
+    {
+        wake_stats.max_jitter_us = jitter_us;
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: wake_predict_arm_pre_alarm
+********************************************************************************
+* Summary:
+*  Saves the ALARM_1 guard of the schedule alarm and arms ALARM_1 on the RTC
+*  second boundary before the deadline. The alarm matches hours, minutes and
+*  seconds, so it fires once for any wait under a day. The RTC runs in 24-hour
+*  format.
+*
+* Parameters:
+*  uint32_t deadline - timebase value of the deadline, more than two seconds
+*                      ahead
+*
+* Return:
+*  bool - true if the pre-alarm is armed, false to time the wait on counter 0
+*
+*******************************************************************************/
+static bool wake_predict_arm_pre_alarm(uint32_t deadline)
+{
+    cy_stc_rtc_config_t time;
+    cy_stc_rtc_config_t check;
+    cy_stc_rtc_alarm_t alarm;
+    uint32_t now, seconds, time_of_day;
+
+    /* Pair the RTC time with the timebase within one RTC second */
+    do
+    {
+        Cy_RTC_GetDateAndTime(&time);
+        now = lptimer_now();
+        Cy_RTC_GetDateAndTime(&check);
+    } while (check.sec != time.sec);
+
+    if (CY_RTC_24_HOURS != time.hrFormat)
+    {
+        return false;
+    }
+
+    /* The boundary before the deadline is 'seconds' boundaries from now */
+    seconds = (deadline - now - 1u) / LPTIMER_CLOCK_HZ;
+    time_of_day = ((time.hour * 3600u) + (time.min * 60u) + time.sec + seconds) %
+                  WAKE_PREDICT_SECONDS_PER_DAY;
+
+    memset(&alarm, 0, sizeof(alarm));
+    alarm.sec = time_of_day % 60u;
+    alarm.secEn = CY_RTC_ALARM_ENABLE;
+    alarm.min = (time_of_day / 60u) % 60u;
+    alarm.minEn = CY_RTC_ALARM_ENABLE;
+    alarm.hour = time_of_day / 3600u;
+    alarm.hourEn = CY_RTC_ALARM_ENABLE;
+    alarm.dayOfWeek = 1u;
+    alarm.dayOfWeekEn = CY_RTC_ALARM_DISABLE;
+    alarm.date = 1u;
+    alarm.dateEn = CY_RTC_ALARM_DISABLE;
+    alarm.month = 1u;
+    alarm.monthEn = CY_RTC_ALARM_DISABLE;
+    alarm.almEn = CY_RTC_ALARM_ENABLE;
+
+    Cy_RTC_GetAlarmDateAndTime(&guard_saved, CY_RTC_ALARM_1);
+    pre_alarm_pending = true;
+
+    /* The RTC may be busy with a write: the counter takes over */
+    if (CY_RTC_SUCCESS != Cy_RTC_SetAlarmDateAndTime(&alarm, CY_RTC_ALARM_1))
+    {
+        pre_alarm_pending = false;
+        return false;
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: wake_predict_restore_guard
+********************************************************************************
+* Summary:
+*  Writes the saved ALARM_1 guard back in place of the pre-alarm. The guard
+*  fires after the deadline, so it is back before it could be needed.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void wake_predict_restore_guard(void)
+{
+    uint32_t attempts = WAKE_PREDICT_RTC_ATTEMPTS;
+    cy_en_rtc_status_t rtc_result;
+
+    pre_alarm_pending = false;
+    do
+    {
+        rtc_result = Cy_RTC_SetAlarmDateAndTime(&guard_saved, CY_RTC_ALARM_1);
+        attempts--;
+    } while ((CY_RTC_SUCCESS != rtc_result) && (0u != attempts));
+}
+
+/*******************************************************************************
+* Function Name: wake_predict_get_stats
+********************************************************************************
+* Summary:
+*  Copies the pre-armed wakeup statistics.
+*
+* Parameters:
+*  stc_wake_predict_stats_t *stats - destination
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wake_predict_get_stats(stc_wake_predict_stats_t *stats)
+{
+    *stats = wake_stats;
+    stats->synced = phase_synced;
+    stats->latency_us = LPTIMER_TICKS_TO_US(latency_fp >> WAKE_PREDICT_FRAC_BITS);
+    stats->lead_us = LPTIMER_TICKS_TO_US(lead_ticks);
+}
+
+/* [] END OF FILE */
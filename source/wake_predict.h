@@ -0,0 +1,87 @@
+/*******************************************************************************
+* File Name:   wake_predict.h
+*
+* Description: This file contains the interface of the pre-armed (predictive)
+*              DeepSleep wakeup that starts the clocks ahead of the RTC deadline.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_WAKE_PREDICT_H_
+#define SOURCE_WAKE_PREDICT_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Seed for the learned wake latency. Matches deepsleepLatency in design.modus */
+#define WAKE_PREDICT_INITIAL_LATENCY_US (5000u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Pre-armed wakeup statistics. Jitter is the job start time minus the
+   deadline: positive values mean the job started late. */
+typedef struct
+{
+    bool     synced;            /* RTC second boundary phase is known */
+    uint32_t wakes;             /* Number of pre-armed wakeups */
+    uint32_t late_wakes;        /* Wakeups that completed after the deadline */
+    uint32_t pre_alarms;        /* Long waits ended by the RTC pre-alarm */
+    uint32_t latency_us;        /* Learned DeepSleep exit latency */
+    uint32_t lead_us;           /* Lead applied ahead of the deadline */
+    int32_t  last_jitter_us;
+    int32_t  min_jitter_us;
+    int32_t  max_jitter_us;
+} stc_wake_predict_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void wake_predict_init(void);
+void wake_predict_on_second_tick(void);
+bool wake_predict_on_pre_alarm(void);
+void wake_predict_set_deadline(uint32_t seconds);
+cy_en_syspm_status_t wake_predict_enter_deepsleep(void);
+void wake_predict_get_stats(stc_wake_predict_stats_t *stats);
+
+#endif /* SOURCE_WAKE_PREDICT_H_ */
+
+/* [] END OF FILE */
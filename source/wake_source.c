@@ -0,0 +1,261 @@
+/*******************************************************************************
+* File Name:   wake_source.c
+*
+* Description: This file identifies the wakeup source. On boot it tells a
+*              Hibernate wakeup by the RTC alarm from one by the user button
+*              wakeup pin; at run time the interrupts record which source ended
+*              a DeepSleep. Each source is routed to its own handler.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "wake_source.h"
+#include "trace.h"
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const wake_handler_t *wake_handlers;
+static en_wake_source_t boot_cause = WAKE_SOURCE_NONE;
+
+/* Bit per en_wake_source_t, set from interrupts */
+static volatile uint32_t pending_sources = 0u;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: wake_source_init
+********************************************************************************
+* Summary:
+*  Registers the wakeup handlers and classifies the boot cause. A Hibernate
+*  wakeup with an RTC alarm interrupt still pending, ALARM_2 or its ALARM_1
+*  guard, was caused by the alarm; any other Hibernate wakeup came from the
+*  wakeup pin, if the button has one. Must be called before the RTC interrupt is enabled in the NVIC,
+*  since its handler clears the pending alarm.
+*
+* Parameters:
+*  const wake_handler_t handlers[] - handler per wakeup source, may be NULL
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wake_source_init(const wake_handler_t handlers[WAKE_SOURCE_COUNT])
+{
+    wake_handlers = handlers;
+
+    if (CY_SYSLIB_RESET_HIB_WAKEUP == (Cy_SysLib_GetResetReason() & CY_SYSLIB_RESET_HIB_WAKEUP))
+    {
+        if (0u != (Cy_RTC_GetInterruptStatus() & (CY_RTC_INTR_ALARM1 | CY_RTC_INTR_ALARM2)))
+        {
+            boot_cause = WAKE_SOURCE_RTC_ALARM;
+        }
+        else
+        {
+            boot_cause = (0u != BUTTON_HIBERNATE_WAKEUP_SRC) ? WAKE_SOURCE_BUTTON : WAKE_SOURCE_RTC_ALARM;
+        }
+    }
+    else
+    {
+        boot_cause = WAKE_SOURCE_NONE;
+    }
+}
+
+/*******************************************************************************
+* Function Name: wake_source_get_boot_cause
+********************************************************************************
+* Summary:
+*  Returns what woke the device from Hibernate, or WAKE_SOURCE_NONE if the
+*  last reset was not a Hibernate wakeup.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  en_wake_source_t - boot cause
+*
+*******************************************************************************/
+en_wake_source_t wake_source_get_boot_cause(void)
+{
+    return boot_cause;
+}
+
+/*******************************************************************************
+* Function Name: wake_source_signal
+********************************************************************************
+* Summary:
+*  Records a wakeup event. Called from the interrupt of the source.
+*
+* Parameters:
+*  en_wake_source_t source - source of the event
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wake_source_signal(en_wake_source_t source)
+{
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+
+    pending_sources |= (1uL << (uint32_t)source);
+
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+}
+
+/*******************************************************************************
+* Function Name: wake_source_is_pending
+********************************************************************************
+* Summary:
+*  Returns true if 'source' was signaled since the last wake_source_take().
+*
+* Parameters:
+*  en_wake_source_t source - source to check
+*
+* Return:
+*  bool - true if pending
+*
+*******************************************************************************/
+bool wake_source_is_pending(en_wake_source_t source)
+{
+    return (0u != (pending_sources & (1uL << (uint32_t)source)));
+}
+
+/*******************************************************************************
+* Function Name: wake_source_is_operator_pending
+********************************************************************************
+* Summary:
+*  Returns true if an operator (user button or debug UART) asked for attention
+*  since the last wake_source_take(). Such wakeups end DeepSleep early.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - true if a button or UART wakeup is pending
+*
+*******************************************************************************/
+bool wake_source_is_operator_pending(void)
+{
+    return (wake_source_is_pending(WAKE_SOURCE_BUTTON) || wake_source_is_pending(WAKE_SOURCE_UART));
+}
+
+/*******************************************************************************
+* Function Name: wake_source_take
+********************************************************************************
+* Summary:
+*  Returns the highest-priority source signaled since the last call and clears
+*  all pending sources. Call it before entering DeepSleep to discard stale
+*  events, and after wakeup to find the source to route.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  en_wake_source_t - highest-priority pending source or WAKE_SOURCE_NONE
+*
+*******************************************************************************/
+en_wake_source_t wake_source_take(void)
+{
+    en_wake_source_t source = WAKE_SOURCE_NONE;
+    uint32_t interrupt_state = Cy_SysLib_EnterCriticalSection();
+    uint32_t pending = pending_sources;
+    uint32_t i;
+
+    pending_sources = 0u;
+    Cy_SysLib_ExitCriticalSection(interrupt_state);
+
+    for (i = (uint32_t)WAKE_SOURCE_COUNT - 1u; i > 0u; i--)
+    {
+        if (0u != (pending & (1uL << i)))
+        {
+            source = (en_wake_source_t)i;
+            break;
+        }
+    }
+
+    return source;
+}
+
+/*******************************************************************************
+* Function Name: wake_source_dispatch
+********************************************************************************
+* Summary:
+*  Calls the handler registered for 'source'.
+*
+* Parameters:
+*  en_wake_source_t source - source to route
+*  bool from_hibernate     - true on the boot path after Hibernate
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wake_source_dispatch(en_wake_source_t source, bool from_hibernate)
+{
+    if ((NULL != wake_handlers) && (source < WAKE_SOURCE_COUNT) &&
+        (NULL != wake_handlers[source]))
+    {
+        trace_record(TRACE_EVENT_WAKEUP, (uint32_t)source);
+        wake_handlers[source](from_hibernate);
+    }
+}
+
+/*******************************************************************************
+* Function Name: wake_source_get_hibernate_sources
+********************************************************************************
+* Summary:
+*  Returns the Hibernate wakeup sources: the RTC alarm and, where SW2 is on a
+*  wakeup pin, that pin with the polarity selected by BUTTON_WAKE_EDGE.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t - value for Cy_SysPm_SetHibernateWakeupSource()
+*
+*******************************************************************************/
+uint32_t wake_source_get_hibernate_sources(void)
+{
+    return ((uint32_t)CY_SYSPM_HIBERNATE_RTC_ALARM | (uint32_t)BUTTON_HIBERNATE_WAKEUP_SRC);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,110 @@
+/*******************************************************************************
+* File Name:   wake_source.h
+*
+* Description: This file contains the interface that identifies what woke the
+*              device (RTC alarm or user button) and routes each wakeup to its
+*              handler.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_WAKE_SOURCE_H_
+#define SOURCE_WAKE_SOURCE_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+#include "cybsp.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Edge of the user button that wakes the device. The button is active low:
+   CY_GPIO_INTR_FALLING wakes on press, CY_GPIO_INTR_RISING on release. */
+#define BUTTON_WAKE_EDGE                (CY_GPIO_INTR_FALLING)
+
+/* Port and pin of Hibernate wakeup pin 0, from the device datasheet. The
+   kit design does not show that SW2 (CYBSP_USER_BTN2, P2.0) is on a wakeup
+   pin, so the Hibernate button wakeup is off: only the RTC alarm ends
+   Hibernate. Define both on a board where SW2 is on wakeup pin 0. */
+#if defined(BUTTON_HIBERNATE_PIN0_PORT_NUM) && defined(BUTTON_HIBERNATE_PIN0_PIN)
+#if (BUTTON_HIBERNATE_PIN0_PORT_NUM != CYBSP_USER_BTN2_PORT_NUM) || \
+    (BUTTON_HIBERNATE_PIN0_PIN != CYBSP_USER_BTN2_PIN)
+#error "Hibernate wakeup pin 0 is not SW2 (CYBSP_USER_BTN2)"
+#endif
+
+/* Hibernate wakeup pin of the user button, with matching polarity */
+#if (BUTTON_WAKE_EDGE == CY_GPIO_INTR_FALLING)
+#define BUTTON_HIBERNATE_WAKEUP_SRC     (CY_SYSPM_HIBERNATE_PIN0_LOW)
+#else
+#define BUTTON_HIBERNATE_WAKEUP_SRC     (CY_SYSPM_HIBERNATE_PIN0_HIGH)
+#endif
+#else
+#define BUTTON_HIBERNATE_WAKEUP_SRC     (0u)
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Source of a wakeup, in increasing routing priority */
+typedef enum
+{
+    WAKE_SOURCE_NONE        = 0u,   /* Not a wakeup: power-on or other reset */
+    WAKE_SOURCE_RTC_ALARM   = 1u,
+    WAKE_SOURCE_UART        = 2u,   /* Debug UART RX edge, DeepSleep only */
+    WAKE_SOURCE_BUTTON      = 3u,
+    WAKE_SOURCE_COUNT       = 4u,
+} en_wake_source_t;
+
+/* Wakeup handler. 'from_hibernate' is true when called on the boot path. */
+typedef void (*wake_handler_t)(bool from_hibernate);
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void wake_source_init(const wake_handler_t handlers[WAKE_SOURCE_COUNT]);
+en_wake_source_t wake_source_get_boot_cause(void);
+void wake_source_signal(en_wake_source_t source);
+bool wake_source_is_pending(en_wake_source_t source);
+bool wake_source_is_operator_pending(void);
+en_wake_source_t wake_source_take(void);
+void wake_source_dispatch(en_wake_source_t source, bool from_hibernate);
+uint32_t wake_source_get_hibernate_sources(void);
+
+#endif /* SOURCE_WAKE_SOURCE_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,332 @@
+/*******************************************************************************
+* File Name:   watchdog.c
+*
+* Description: This file implements the hardware watchdog (WDT) integration.
+*              The timeout is derived from the RTC alarm period so that the
+*              watchdog is serviced on the alarm wakeups that already happen,
+*              without waking the device for it. Missed alarms are detected on
+*              service, and watchdog resets are logged in retained storage.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+#include "watchdog.h"
+#include "lptimer.h"
+#include "retained.h"
+#include "cycles.h"
+#include "energy_model.h"
+#include "schedule_config.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* The WDT of this device is a free-running 32-bit counter clocked from ILO.
+   Cy_WDT_SetMatchBits(n) ignores the counter bits above bit n, so the WDT
+   matches every 2^(n + 1) ticks. It resets the device on the third
+   unserviced match, so the time to reset is between two and three match
+   periods. A match period is 0.25 s to 36 h. */
+#define WATCHDOG_COUNTER_BITS       (32u)
+#define WATCHDOG_MIN_MATCH_BITS     (12u)
+#define WATCHDOG_MIN_MATCHES        (2u)
+#define WATCHDOG_MAX_MATCHES        (3u)
+
+/* Guaranteed time to reset an alarm period needs, in ticks */
+#define WATCHDOG_REQUIRED_TICKS(period_s) \
+    ((((uint64_t)WATCHDOG_MISSED_WAKES + 1u) * (uint64_t)(period_s) * LPTIMER_CLOCK_HZ) + \
+     LPTIMER_US_TO_TICKS(WATCHDOG_JOB_BUDGET_MS * 1000u))
+
+/* Every wake schedule, stretched or not, runs with the watchdog */
+#define WATCHDOG_CHECK(name, period_s, offset_s, mode, awake_us) \
+    _Static_assert(WATCHDOG_REQUIRED_TICKS(period_s) <= \
+                   (WATCHDOG_MIN_MATCHES * (1uLL << WATCHDOG_COUNTER_BITS)), \
+                   #name ": period too long for the watchdog");
+
+SCHEDULE_TABLE(WATCHDOG_CHECK)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static stc_watchdog_stats_t watchdog_stats;
+static uint32_t period_ticks;
+static uint32_t last_service;
+static volatile uint32_t alarm_count = 0u;
+static uint32_t serviced_alarms;
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: watchdog_init
+********************************************************************************
+* Summary:
+*  Logs the reset cause of this boot into retained storage and counts watchdog
+*  resets. Clears the reset reason so the next boot sees only its own cause.
+*  Call after wake_source_init(), which also reads the reset reason.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void watchdog_init(void)
+{
+    uint32_t reason = Cy_SysLib_GetResetReason();
+
+    retained_init();
+    retained_write(RETAINED_SLOT_RESET_CAUSE, reason);
+    if (0u != (reason & CY_SYSLIB_RESET_HWWDT))
+    {
+        retained_increment(RETAINED_SLOT_WDT_RESETS);
+    }
+    Cy_SysLib_ClearResetReason();
+
+    memset(&watchdog_stats, 0, sizeof(watchdog_stats));
+    watchdog_stats.last_reset_reason = reason;
+
+    cycles_init();
+}
+
+/*******************************************************************************
+* Function Name: watchdog_start
+********************************************************************************
+* Summary:
+*  Starts the WDT with the shortest window that still tolerates
+*  WATCHDOG_MISSED_WAKES missed alarms plus a job of WATCHDOG_JOB_BUDGET_MS,
+*  so a missed alarm or a hung job resets the device quickly. Every
+*  SCHEDULE_TABLE period fits (checked at build time); for a longer period,
+*  stops the WDT and returns false.
+*
+* Parameters:
+*  uint32_t alarm_period_s - period of the RTC alarm wakeups
+*
+* Return:
+*  bool - true if the watchdog runs
+*
+*******************************************************************************/
+bool watchdog_start(uint32_t alarm_period_s)
+{
+    uint64_t required_ticks;
+    uint32_t match_bits;
+    uint64_t window_ticks = 0u;
+
+    if (watchdog_stats.running && (watchdog_stats.period_s == alarm_period_s))
+    {
+        return true;
+    }
+
+    required_ticks = WATCHDOG_REQUIRED_TICKS(alarm_period_s);
+
+    /* Fewest match bits whose guaranteed timeout still covers it */
+    for (match_bits = WATCHDOG_MIN_MATCH_BITS; match_bits < WATCHDOG_COUNTER_BITS; match_bits++)
+    {
+        window_ticks = 1uLL << (match_bits + 1u);
+        if ((WATCHDOG_MIN_MATCHES * window_ticks) >= required_ticks)
+        {
+            break;
+        }
+    }
+    if (match_bits == WATCHDOG_COUNTER_BITS)
+    {
+        watchdog_stop();
+        return false;
+    }
+
+    Cy_WDT_Unlock();
+    Cy_WDT_Disable();
+    Cy_WDT_Init();
+    Cy_WDT_SetMatch(0u);
+    Cy_WDT_SetMatchBits(match_bits);
+    Cy_WDT_MaskInterrupt();
+    Cy_WDT_ClearInterrupt();
+    Cy_WDT_Enable();
+    Cy_WDT_Lock();
+
+    watchdog_stats.running = true;
+    watchdog_stats.period_s = alarm_period_s;
+    watchdog_stats.min_timeout_ms = (uint32_t)(((WATCHDOG_MIN_MATCHES * window_ticks) * 1000u) / LPTIMER_CLOCK_HZ);
+    watchdog_stats.max_timeout_ms = (uint32_t)(((WATCHDOG_MAX_MATCHES * window_ticks) * 1000u) / LPTIMER_CLOCK_HZ);
+    period_ticks = alarm_period_s * LPTIMER_CLOCK_HZ;
+    last_service = lptimer_now();
+    serviced_alarms = alarm_count;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: watchdog_on_alarm
+********************************************************************************
+* Summary:
+*  Counts RTC alarm interrupts. Called from the alarm interrupt handler.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void watchdog_on_alarm(void)
+{
+    alarm_count++;
+}
+
+/*******************************************************************************
+* Function Name: watchdog_service
+********************************************************************************
+* Summary:
+*  Services the WDT. Call once per RTC alarm wakeup, after the jobs of that
+*  wakeup completed. Alarms expected from the elapsed time but not seen by
+*  watchdog_on_alarm() are counted as missed.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void watchdog_service(void)
+{
+    uint32_t start = cycles_now();
+    uint32_t now, expected, seen, cost;
+
+    if (!watchdog_stats.running)
+    {
+        return;
+    }
+
+    Cy_WDT_ClearWatchdog();
+
+    now = lptimer_now();
+    expected = ((now - last_service) + (period_ticks / 2u)) / period_ticks;
+    seen = alarm_count - serviced_alarms;
+    last_service = now;
+    serviced_alarms += seen;
+    while (expected > seen)
+    {
+        retained_increment(RETAINED_SLOT_MISSED_WAKES);
+        expected--;
+    }
+    watchdog_stats.services++;
+
+    cost = cycles_now() - start;
+    if (cost > watchdog_stats.service_cycles)
+    {
+        watchdog_stats.service_cycles = cost;
+    }
+}
+
+/*******************************************************************************
+* Function Name: watchdog_stop
+********************************************************************************
+* Summary:
+*  Stops the WDT. Called before Hibernate: the wakeup is a reset, and the boot
+*  path starts the watchdog again once the alarm is armed.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void watchdog_stop(void)
+{
+    Cy_WDT_Unlock();
+    Cy_WDT_Disable();
+    watchdog_stats.running = false;
+}
+
+/*******************************************************************************
+* Function Name: watchdog_get_stats
+********************************************************************************
+* Summary:
+*  Copies the watchdog statistics, including the retained counters.
+*
+* Parameters:
+*  stc_watchdog_stats_t *stats - destination
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void watchdog_get_stats(stc_watchdog_stats_t *stats)
+{
+    *stats = watchdog_stats;
+    stats->missed_wakes = retained_read(RETAINED_SLOT_MISSED_WAKES);
+    stats->wdt_resets = retained_read(RETAINED_SLOT_WDT_RESETS);
+}
+
+/*******************************************************************************
+* Function Name: watchdog_get_energy_nc_per_day
+********************************************************************************
+* Summary:
+*  Returns the modeled extra charge of the watchdog per day. The WDT counts ILO
+*  cycles that the RTC already needs, and no wakeups are added, so the only
+*  cost is the service time at active current on each alarm wakeup.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t - extra charge in nC per day
+*
+*******************************************************************************/
+uint32_t watchdog_get_energy_nc_per_day(void)
+{
+    uint32_t services_per_day;
+    uint32_t service_us;
+
+    if ((!watchdog_stats.running) || (0u == watchdog_stats.period_s))
+    {
+        return 0u;
+    }
+
+    services_per_day = ENERGY_SECONDS_PER_DAY / watchdog_stats.period_s;
+    service_us = CYCLES_TO_US(watchdog_stats.service_cycles) + 1u;
+
+    return ENERGY_CHARGE_NC(ENERGY_ACTIVE_UA, (uint64_t)service_us * services_per_day);
+}
+
+/* [] END OF FILE */
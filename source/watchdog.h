@@ -0,0 +1,86 @@
+/*******************************************************************************
+* File Name:   watchdog.h
+*
+* Description: This file contains the interface of the hardware watchdog that is
+*              serviced on RTC alarm wakeups only.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOURCE_WATCHDOG_H_
+#define SOURCE_WATCHDOG_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define WATCHDOG_MISSED_WAKES       (1u)    /* Missed alarm wakeups tolerated */
+#define WATCHDOG_JOB_BUDGET_MS      (500u)  /* Longest job run on a wakeup */
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    bool     running;
+    uint32_t period_s;          /* Alarm period the timeout is derived from */
+    uint32_t min_timeout_ms;    /* Guaranteed time to reset without service */
+    uint32_t max_timeout_ms;    /* Latest time to reset without service */
+    uint32_t services;          /* Services since start */
+    uint32_t missed_wakes;      /* Alarm wakeups missing, all boots */
+    uint32_t wdt_resets;        /* Watchdog resets, all boots */
+    uint32_t last_reset_reason; /* Cy_SysLib_GetResetReason() of this boot */
+    uint32_t service_cycles;    /* Worst-case cost of one service */
+} stc_watchdog_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void watchdog_init(void);
+bool watchdog_start(uint32_t alarm_period_s);
+void watchdog_on_alarm(void);
+void watchdog_service(void);
+void watchdog_stop(void);
+void watchdog_get_stats(stc_watchdog_stats_t *stats);
+uint32_t watchdog_get_energy_nc_per_day(void);
+
+#endif /* SOURCE_WATCHDOG_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,94 @@
+/*******************************************************************************
+* File Name:   bench_clock.h
+*
+* Description: Time stamps of the host benchmarks in tests/: the time stamp
+*              counter on x86, nanoseconds of the monotonic clock elsewhere.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef TESTS_BENCH_CLOCK_H_
+#define TESTS_BENCH_CLOCK_H_
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdint.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Unit of bench_clock_now(), for the table headers */
+#if defined(__x86_64__) || defined(__i386__)
+#define BENCH_CLOCK_UNIT            "c"     /* TSC cycles */
+#else
+#define BENCH_CLOCK_UNIT            "ns"
+#endif
+
+/*******************************************************************************
+* Function Name: bench_clock_now
+********************************************************************************
+* Summary:
+*  Returns a time stamp in BENCH_CLOCK_UNIT. The host counterpart of
+*  cycles_now(); the TSC counts at a fixed rate, not core cycles, on most
+*  current x86 processors.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint64_t - time stamp
+*
+*******************************************************************************/
+static inline uint64_t bench_clock_now(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000uLL) + (uint64_t)now.tv_nsec;
+#endif
+}
+
+#endif /* TESTS_BENCH_CLOCK_H_ */
+
+/* [] END OF FILE */
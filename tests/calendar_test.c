@@ -0,0 +1,203 @@
+/*******************************************************************************
+* File Name:   calendar_test.c
+*
+* Description: Host test of the civil date conversions (source/calendar_civil.c).
+*              Checks every day of the RTC range, 2000 to 2099, against a day
+*              by day count and against gmtime(). Exits with 1 on a mismatch.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "calendar_civil.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define FIRST_YEAR              (2000)
+#define LAST_YEAR               (2099)
+#define FIRST_DAY_OF_WEEK       (7u)    /* 2000-01-01 was a Saturday */
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint32_t days_in_month(int32_t year, uint32_t month);
+static uint32_t check_day(int32_t days, int32_t year, uint32_t month, uint32_t day, uint32_t dow);
+static uint32_t check_leap_years(void);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Walks the RTC range one day at a time and checks each day.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  int - 0 if every check passes
+*
+*******************************************************************************/
+int main(void)
+{
+    int32_t days = calendar_days_from_civil(FIRST_YEAR, 1u, 1u);
+    uint32_t dow = FIRST_DAY_OF_WEEK;
+    uint32_t checked = 0u;
+    uint32_t errors = check_leap_years();
+
+    for (int32_t year = FIRST_YEAR; year <= LAST_YEAR; year++)
+    {
+        for (uint32_t month = 1u; month <= 12u; month++)
+        {
+            for (uint32_t day = 1u; day <= days_in_month(year, month); day++)
+            {
+                errors += check_day(days, year, month, day, dow);
+                checked++;
+                days++;
+                dow = (dow % 7u) + 1u;
+            }
+        }
+    }
+
+    printf("calendar: %u days checked, %u errors\n", (unsigned)checked, (unsigned)errors);
+    return (0u == errors) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*******************************************************************************
+* Function Name: days_in_month
+********************************************************************************
+* Summary:
+*  Reference month length from a table and the Gregorian leap rule.
+*
+* Parameters:
+*  int32_t year   - full year
+*  uint32_t month - 1 to 12
+*
+* Return:
+*  uint32_t - 28 to 31
+*
+*******************************************************************************/
+static uint32_t days_in_month(int32_t year, uint32_t month)
+{
+    static const uint8_t length[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    bool leap = ((0 == (year % 4)) && (0 != (year % 100))) || (0 == (year % 400));
+
+    return length[month - 1u] + (((2u == month) && leap) ? 1u : 0u);
+}
+
+/*******************************************************************************
+* Function Name: check_day
+********************************************************************************
+* Summary:
+*  Checks both conversions and the day of the week of one day, against the
+*  walk and against gmtime() of its epoch seconds.
+*
+* Parameters:
+*  int32_t days   - expected days since 1970-01-01
+*  int32_t year   - expected full year
+*  uint32_t month - expected month
+*  uint32_t day   - expected day of the month
+*  uint32_t dow   - expected day of the week, CALENDAR_SUNDAY based
+*
+* Return:
+*  uint32_t - 1 on a mismatch, else 0
+*
+*******************************************************************************/
+static uint32_t check_day(int32_t days, int32_t year, uint32_t month, uint32_t day, uint32_t dow)
+{
+    time_t epoch_s = (time_t)days * CALENDAR_SECONDS_PER_DAY;
+    struct tm tm;
+    int32_t out_year;
+    uint32_t out_month;
+    uint32_t out_day;
+
+    calendar_civil_from_days(days, &out_year, &out_month, &out_day);
+    (void)gmtime_r(&epoch_s, &tm);
+
+    if ((calendar_days_from_civil(year, month, day) != days) ||
+        (out_year != year) || (out_month != month) || (out_day != day) ||
+        (calendar_day_of_week(days) != dow) ||
+        ((tm.tm_year + 1900) != year) || ((uint32_t)tm.tm_mon + 1u != month) ||
+        ((uint32_t)tm.tm_mday != day) || ((uint32_t)tm.tm_wday + CALENDAR_SUNDAY != dow))
+    {
+        printf("mismatch on %04d-%02u-%02u (day %d)\n", (int)year, (unsigned)month, (unsigned)day, (int)days);
+        return 1u;
+    }
+
+    return 0u;
+}
+
+/*******************************************************************************
+* Function Name: check_leap_years
+********************************************************************************
+* Summary:
+*  Checks the leap year rule on the years around the RTC range, with the
+*  century exceptions.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t - number of mismatches
+*
+*******************************************************************************/
+static uint32_t check_leap_years(void)
+{
+    uint32_t errors = 0u;
+
+    for (int32_t year = 1600; year <= 2400; year++)
+    {
+        if (calendar_is_leap_year(year) != (29u == days_in_month(year, 2u)))
+        {
+            printf("leap year mismatch on %d\n", (int)year);
+            errors++;
+        }
+    }
+
+    return errors;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,206 @@
+/*******************************************************************************
+* File Name:   compress_bench.c
+*
+* Description: Host benchmark of the block codec (source/compress.c). Codes
+*              the random walks of the on-target 'bench' command and prints the
+*              time per sample and the coded bits per sample. Exits with 1 if a
+*              block does not decode to its input.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_clock.h"
+#include "compress.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_SAMPLES               (1024u) /* As source/benchmark.c */
+#define BENCH_BLOCK_SIZE            (16u)
+#define BENCH_BLOCKS                (BENCH_SAMPLES / BENCH_BLOCK_SIZE)
+#define BENCH_SEED                  (0x2545F491u)
+#define BENCH_ADC_MID               (2048)
+#define BENCH_ROUNDS                (1000u) /* The fastest round counts */
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static int16_t bench_samples[BENCH_SAMPLES];
+static int16_t bench_decoded[BENCH_SAMPLES];
+static uint8_t bench_coded[BENCH_BLOCKS * COMPRESS_MAX_BLOCK_SIZE(BENCH_BLOCK_SIZE)];
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void bench_fill(uint32_t step);
+static bool bench_compress_run(uint32_t step, bool bitpack);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Runs both modes on walks of three step sizes and prints one row each.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  int - 0 if every block decodes to its input
+*
+*******************************************************************************/
+int main(void)
+{
+    static const uint32_t steps[] = { 2u, 16u, 256u };
+    bool ok = true;
+
+    printf("Codec benchmark: %u samples in blocks of %u, time in %s\n",
+           (unsigned)BENCH_SAMPLES, (unsigned)BENCH_BLOCK_SIZE, BENCH_CLOCK_UNIT);
+    printf("  %-16s %-8s %10s %10s %10s\n", "data", "mode", "enc /smp", "dec /smp", "bits/smp");
+
+    for (uint32_t i = 0u; i < (sizeof(steps) / sizeof(steps[0])); i++)
+    {
+        bench_fill(steps[i]);
+        ok = bench_compress_run(steps[i], false) && ok;
+        ok = bench_compress_run(steps[i], true) && ok;
+    }
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*******************************************************************************
+* Function Name: bench_fill
+********************************************************************************
+* Summary:
+*  Fills the input with a clamped 12-bit random walk, as bench_fill() on the
+*  target.
+*
+* Parameters:
+*  uint32_t step - the walk moves by -step/2 to step/2 - 1 per sample
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_fill(uint32_t step)
+{
+    uint32_t seed = BENCH_SEED;
+    int32_t value = BENCH_ADC_MID;
+
+    for (uint32_t i = 0u; i < BENCH_SAMPLES; i++)
+    {
+        seed = (seed * 1664525u) + 1013904223u;
+        value += (int32_t)((seed >> 16) % step) - (int32_t)(step / 2u);
+        value = (value < 0) ? 0 : ((value > 4095) ? 4095 : value);
+        bench_samples[i] = (int16_t)value;
+    }
+}
+
+/*******************************************************************************
+* Function Name: bench_compress_run
+********************************************************************************
+* Summary:
+*  Encodes the input block by block and decodes it again, BENCH_ROUNDS
+*  times. Prints the fastest round of each and the coded size.
+*
+* Parameters:
+*  uint32_t step - step of the walk, for the row name
+*  bool bitpack  - also try bit-packing
+*
+* Return:
+*  bool - true if every block decodes to its input
+*
+*******************************************************************************/
+static bool bench_compress_run(uint32_t step, bool bitpack)
+{
+    uint32_t length[BENCH_BLOCKS];
+    uint64_t enc = UINT64_MAX;
+    uint64_t dec = UINT64_MAX;
+    uint32_t size = 0u;
+    bool ok = true;
+    char name[24];
+
+    for (uint32_t round = 0u; round < BENCH_ROUNDS; round++)
+    {
+        uint64_t start = bench_clock_now();
+        uint64_t time;
+
+        size = 0u;
+        for (uint32_t block = 0u; block < BENCH_BLOCKS; block++)
+        {
+            length[block] = compress_block_encode(&bench_samples[block * BENCH_BLOCK_SIZE], BENCH_BLOCK_SIZE,
+                                                  bitpack, &bench_coded[size],
+                                                  (uint32_t)sizeof(bench_coded) - size);
+            size += length[block];
+        }
+        time = bench_clock_now() - start;
+        enc = (time < enc) ? time : enc;
+
+        start = bench_clock_now();
+        size = 0u;
+        for (uint32_t block = 0u; block < BENCH_BLOCKS; block++)
+        {
+            (void)compress_block_decode(&bench_coded[size], length[block],
+                                        &bench_decoded[block * BENCH_BLOCK_SIZE], BENCH_BLOCK_SIZE);
+            size += length[block];
+        }
+        time = bench_clock_now() - start;
+        dec = (time < dec) ? time : dec;
+
+        for (uint32_t i = 0u; i < BENCH_SAMPLES; i++)
+        {
+            ok = ok && (bench_decoded[i] == bench_samples[i]);
+        }
+    }
+
+    (void)snprintf(name, sizeof(name), "walk +-%u", (unsigned)(step / 2u));
+    printf("  %-16s %-8s %10.1f %10.1f %10.2f%s\n", name, bitpack ? "bitpack" : "varint",
+           (double)enc / BENCH_SAMPLES, (double)dec / BENCH_SAMPLES,
+           (double)(size * 8u) / BENCH_SAMPLES, ok ? "" : "  MISMATCH");
+
+    return ok;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,278 @@
+/*******************************************************************************
+* File Name:   energy_bucket_test.c
+*
+* Description: Host test of the energy budget bucket (source/energy_bucket.c):
+*              refill and drain limits, the level thresholds with their
+*              hysteresis, and the packed state kept across Hibernate. Exits with
+*              1 on a failed check.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "energy_bucket.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TEST_UAH_PER_DAY            (720u)  /* As ENERGY_BUDGET_UAH_PER_DAY */
+#define TEST_BURST_S                (3600u) /* As ENERGY_BUDGET_BURST_S */
+#define TEST_US_PER_S               (1000000uLL)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static uint32_t checks;
+static uint32_t errors;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void expect(bool condition, const char *what);
+static en_energy_level_t fill_to(stc_energy_bucket_t *bucket, uint32_t pct);
+static void test_limits(void);
+static void test_levels(void);
+static void test_pack(void);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Runs the checks and prints their count.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  int - 0 if every check passes
+*
+*******************************************************************************/
+int main(void)
+{
+    test_limits();
+    test_levels();
+    test_pack();
+
+    printf("energy bucket: %u checks, %u failed\n", (unsigned)checks, (unsigned)errors);
+    return (0u == errors) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*******************************************************************************
+* Function Name: expect
+********************************************************************************
+* Summary:
+*  Counts a check and reports it if it fails.
+*
+* Parameters:
+*  bool condition   - result of the check
+*  const char *what - description
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void expect(bool condition, const char *what)
+{
+    checks++;
+    if (!condition)
+    {
+        printf("failed: %s\n", what);
+        errors++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: fill_to
+********************************************************************************
+* Summary:
+*  Sets the fill of a bucket and steps it without time or charge, so that
+*  the level follows the fill from the current level.
+*
+* Parameters:
+*  stc_energy_bucket_t *bucket - bucket
+*  uint32_t pct                - new fill, 0 to 100 %
+*
+* Return:
+*  en_energy_level_t - level after the step
+*
+*******************************************************************************/
+static en_energy_level_t fill_to(stc_energy_bucket_t *bucket, uint32_t pct)
+{
+    bucket->tokens_nc = (bucket->capacity_nc * pct) / 100u;
+    (void)energy_bucket_step(bucket, 0u, 0u);
+    return bucket->level;
+}
+
+/*******************************************************************************
+* Function Name: test_limits
+********************************************************************************
+* Summary:
+*  A new bucket is full; refill stops at the capacity, drain at empty, and a
+*  draw at the budgeted current keeps the fill.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_limits(void)
+{
+    stc_energy_bucket_t bucket;
+
+    energy_bucket_init(&bucket, TEST_UAH_PER_DAY, TEST_BURST_S);
+    expect(30000u == bucket.refill_na, "720 uAh/day is 30000 nA");
+    expect(((uint64_t)30000u * TEST_BURST_S) == bucket.capacity_nc, "capacity is an hour of budget");
+    expect((100u == energy_bucket_fill_pct(&bucket)) && (ENERGY_LEVEL_NORMAL == bucket.level),
+           "a new bucket is full at the normal level");
+
+    (void)energy_bucket_step(&bucket, 86400u * TEST_US_PER_S, 0u);
+    expect(bucket.tokens_nc == bucket.capacity_nc, "refill stops at the capacity");
+
+    (void)energy_bucket_step(&bucket, 0u, bucket.capacity_nc * 2u);
+    expect(0u == bucket.tokens_nc, "drain stops at empty");
+    expect(ENERGY_LEVEL_CRITICAL == bucket.level, "an empty bucket is critical");
+
+    (void)fill_to(&bucket, 70u);
+    (void)energy_bucket_step(&bucket, 600u * TEST_US_PER_S, (uint64_t)bucket.refill_na * 600u);
+    expect(70u == energy_bucket_fill_pct(&bucket), "a draw at the budget keeps the fill");
+}
+
+/*******************************************************************************
+* Function Name: test_levels
+********************************************************************************
+* Summary:
+*  Walks the fill down and up across both thresholds and checks that a level
+*  rises only ENERGY_BUDGET_HYSTERESIS_PCT above the fill it dropped at.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_levels(void)
+{
+    stc_energy_bucket_t bucket;
+
+    energy_bucket_init(&bucket, TEST_UAH_PER_DAY, TEST_BURST_S);
+    expect(ENERGY_LEVEL_NORMAL == fill_to(&bucket, ENERGY_BUDGET_SAVE_PCT), "normal at the save threshold");
+    expect(ENERGY_LEVEL_SAVE == fill_to(&bucket, ENERGY_BUDGET_SAVE_PCT - 1u), "save below it");
+    expect(ENERGY_LEVEL_SAVE == fill_to(&bucket, ENERGY_BUDGET_SAVE_PCT + ENERGY_BUDGET_HYSTERESIS_PCT - 1u),
+           "save within the hysteresis band");
+    expect(ENERGY_LEVEL_NORMAL == fill_to(&bucket, ENERGY_BUDGET_SAVE_PCT + ENERGY_BUDGET_HYSTERESIS_PCT),
+           "normal above the band");
+
+    expect(ENERGY_LEVEL_SAVE == fill_to(&bucket, ENERGY_BUDGET_CRITICAL_PCT), "save at the critical threshold");
+    expect(ENERGY_LEVEL_CRITICAL == fill_to(&bucket, ENERGY_BUDGET_CRITICAL_PCT - 1u), "critical below it");
+    expect(ENERGY_LEVEL_CRITICAL ==
+           fill_to(&bucket, ENERGY_BUDGET_CRITICAL_PCT + ENERGY_BUDGET_HYSTERESIS_PCT - 1u),
+           "critical within the hysteresis band");
+    expect(ENERGY_LEVEL_SAVE == fill_to(&bucket, ENERGY_BUDGET_CRITICAL_PCT + ENERGY_BUDGET_HYSTERESIS_PCT),
+           "save above the band");
+
+    (void)fill_to(&bucket, 0u);
+    expect(ENERGY_LEVEL_SAVE == fill_to(&bucket, ENERGY_BUDGET_SAVE_PCT + ENERGY_BUDGET_HYSTERESIS_PCT - 1u),
+           "critical rises to save within the save band");
+    (void)fill_to(&bucket, 0u);
+    expect(ENERGY_LEVEL_NORMAL == fill_to(&bucket, 100u), "critical rises to normal on a full bucket");
+}
+
+/*******************************************************************************
+* Function Name: test_pack
+********************************************************************************
+* Summary:
+*  The packed state restores the level and the fill to within one part in
+*  2^24, also into a bucket of another capacity; invalid words are refused.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_pack(void)
+{
+    static const uint32_t fills[] = { 0u, 1u, 19u, 33u, 50u, 99u, 100u };
+    stc_energy_bucket_t bucket;
+    stc_energy_bucket_t restored;
+    uint64_t error;
+    bool all_ok = true;
+
+    for (uint32_t i = 0u; i < (sizeof(fills) / sizeof(fills[0])); i++)
+    {
+        energy_bucket_init(&bucket, TEST_UAH_PER_DAY, TEST_BURST_S);
+        (void)fill_to(&bucket, fills[i]);
+        bucket.tokens_nc += (0u != bucket.tokens_nc) ? 0u : 12345u;
+        energy_bucket_init(&restored, TEST_UAH_PER_DAY, TEST_BURST_S);
+
+        all_ok = all_ok && (0u != energy_bucket_pack(&bucket)) &&
+                 energy_bucket_unpack(&restored, energy_bucket_pack(&bucket));
+        error = (restored.tokens_nc > bucket.tokens_nc) ? (restored.tokens_nc - bucket.tokens_nc) :
+                                                          (bucket.tokens_nc - restored.tokens_nc);
+        all_ok = all_ok && (restored.level == bucket.level) && (error <= ((bucket.capacity_nc >> 24) + 1u));
+    }
+    expect(all_ok, "pack and unpack keep the level and the fill");
+
+    energy_bucket_init(&bucket, TEST_UAH_PER_DAY, TEST_BURST_S);
+    (void)fill_to(&bucket, 40u);
+    energy_bucket_init(&restored, TEST_UAH_PER_DAY * 2u, TEST_BURST_S);
+    expect(energy_bucket_unpack(&restored, energy_bucket_pack(&bucket)) &&
+           ((energy_bucket_fill_pct(&restored) + 1u) >= 40u) && (energy_bucket_fill_pct(&restored) <= 40u) &&
+           (ENERGY_LEVEL_SAVE == restored.level),
+           "a changed budget resumes at the same share");
+
+    energy_bucket_init(&restored, TEST_UAH_PER_DAY, TEST_BURST_S);
+    expect(!energy_bucket_unpack(&restored, 0u), "a cleared slot is refused");
+    expect(!energy_bucket_unpack(&restored, 0xB0000000u), "an unknown level is refused");
+    expect(!energy_bucket_unpack(&restored, 0x81FFFFFFu), "a fill above full is refused");
+    expect((100u == energy_bucket_fill_pct(&restored)) && (ENERGY_LEVEL_NORMAL == restored.level),
+           "a refused word leaves the bucket unchanged");
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,282 @@
+/*******************************************************************************
+* File Name:   fmt_bench.c
+*
+* Description: Host test and benchmark of the integer-only formatter
+*              (source/fmt.c) against the snprintf of the host C library. Checks
+*              both give the same output, and prints the time per line of each on
+*              the lines of the on-target 'bench' command. Exits with 1 on a mismatch.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench_clock.h"
+#include "fmt.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_FMT_LINES             (4u)    /* As source/benchmark.c */
+#define BENCH_FMT_SIZE              (96u)
+#define BENCH_FMT_PASSES            (1000u) /* Passes over the lines per round */
+#define BENCH_FMT_ROUNDS            (100u)  /* The fastest round counts */
+#define CHECK_SIZE                  (256u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* fmt_snprintf or the host's snprintf */
+typedef int (*bench_snprintf_t)(char *buffer, size_t size, const char *format, ...);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static uint32_t checks;
+static uint32_t errors;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void check(const char *format, ...) __attribute__((format(printf, 1, 2)));
+static void check_all(void);
+static int bench_fmt_line(bench_snprintf_t format, char *out, uint32_t line);
+static void bench_fmt_run(const char *name, bench_snprintf_t format);
+
+/*******************************************************************************
+* Function Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Compares the two formatters on every case, then times both.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  int - 0 if the outputs match
+*
+*******************************************************************************/
+int main(void)
+{
+    check_all();
+    printf("fmt: %u cases checked against snprintf, %u mismatches\n", (unsigned)checks, (unsigned)errors);
+
+    printf("Formatter benchmark: %u lines, time in %s\n", (unsigned)BENCH_FMT_LINES, BENCH_CLOCK_UNIT);
+    printf("  %-8s %10s %10s\n", "printf", "/line", "/char");
+    bench_fmt_run("fmt", fmt_snprintf);
+    bench_fmt_run("libc", snprintf);
+
+    return (0u == errors) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*******************************************************************************
+* Function Name: check
+********************************************************************************
+* Summary:
+*  Formats with both formatters and counts a mismatch of the text or of the
+*  returned length.
+*
+* Parameters:
+*  const char *format - printf format, within what fmt.c supports
+*  ...                - arguments
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void check(const char *format, ...)
+{
+    char expected[CHECK_SIZE];
+    char out[CHECK_SIZE];
+    va_list args;
+    va_list copy;
+    int expected_length;
+    int length;
+
+    va_start(args, format);
+    va_copy(copy, args);
+    expected_length = vsnprintf(expected, sizeof(expected), format, args);
+    length = fmt_vsnprintf(out, sizeof(out), format, copy);
+    va_end(copy);
+    va_end(args);
+
+    checks++;
+    if ((length != expected_length) || (0 != strcmp(out, expected)))
+    {
+        printf("mismatch on \"%s\": \"%s\" (%d), expected \"%s\" (%d)\n",
+               format, out, length, expected, expected_length);
+        errors++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: check_all
+********************************************************************************
+* Summary:
+*  The conversions, flags, widths and precisions the firmware uses, their
+*  limits, and truncation.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void check_all(void)
+{
+    char small[8];
+
+    check("%s [%lu.%06lu]: %s\r\n", "12 : 34 : 56  25 - 10 - 17", 1234ul, 5678ul, "Wakeup");
+    check("  %-10s %7lu %7lu %5lu %8lu\r\n", "batch", 1234567ul, 42ul, 7ul, 98765ul);
+    check("%d %i %u %x %X %c %%", -7, INT_MIN, UINT_MAX, 0xbeefu, 0xBEEFu, 'q');
+    check("%ld %lu %lx", LONG_MIN, ULONG_MAX, ULONG_MAX);
+    check("[%5d] [%-5d] [%05d] [%-5d] [%.3d] [%8.3d] [%.0d] [%5.0d] [%05d]", 42, 42, -42, 42, 7, -7, 0, 0, 0);
+    check("[%10s] [%-10s] [%.2s] [%*s] [%-*d] [%.*s]", "abc", "abc", "abcdef", 6, "x", 4, 9, 3, "abcdef");
+    check("[%3c] [%-3c] [%02lu:%02lu] [%03lu] [%06lu]", 'a', 'b', 5ul, 59ul, 7ul, 999999ul);
+    check("[%*d]", -6, 12);
+    check("%s", "");
+    check("plain");
+    check("%-30s|", "x");
+    check("%18s|%14lu|%13lu", "a", 1ul, 0ul);
+
+    /* Truncated output keeps the terminator; the length is the full one */
+    checks++;
+    if ((10 != fmt_snprintf(small, sizeof(small), "%s", "0123456789")) || (0 != strcmp(small, "0123456")))
+    {
+        printf("mismatch on truncation\n");
+        errors++;
+    }
+    checks++;
+    if (5 != fmt_snprintf(NULL, 0u, "%d", 12345))
+    {
+        printf("mismatch on the length without a buffer\n");
+        errors++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: bench_fmt_line
+********************************************************************************
+* Summary:
+*  Formats one of the benchmark lines of source/benchmark.c.
+*
+* Parameters:
+*  bench_snprintf_t format - formatter
+*  char *out               - BENCH_FMT_SIZE bytes
+*  uint32_t line           - 0 to BENCH_FMT_LINES - 1
+*
+* Return:
+*  int - length of the line
+*
+*******************************************************************************/
+static int bench_fmt_line(bench_snprintf_t format, char *out, uint32_t line)
+{
+    switch (line)
+    {
+        case 0u:
+            return format(out, BENCH_FMT_SIZE, "%s [%lu.%06lu]: %s\r\n", "12 : 34 : 56  25 - 10 - 17",
+                          1234ul, 5678ul, "Wakeup from DeepSleep mode");
+        case 1u:
+            return format(out, BENCH_FMT_SIZE, "  %-10s %7lu %7lu %5lu %8lu\r\n", "batch",
+                          1234567ul, 42ul, 7ul, 98765ul);
+        case 2u:
+            return format(out, BENCH_FMT_SIZE, "Energy budget level %u, period %lu s\r\n", 2u, 3600ul);
+        default:
+            return format(out, BENCH_FMT_SIZE, "[%5d] [%-4ld] [%03u] [%x] [%c] [%.2s] %%\r\n",
+                          -42, -7l, 5u, 0xBEEFu, 'x', "abc");
+    }
+}
+
+/*******************************************************************************
+* Function Name: bench_fmt_run
+********************************************************************************
+* Summary:
+*  Times BENCH_FMT_PASSES passes over the lines, BENCH_FMT_ROUNDS times, and
+*  prints the fastest round per line and per character.
+*
+* Parameters:
+*  const char *name        - formatter name
+*  bench_snprintf_t format - formatter
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_fmt_run(const char *name, bench_snprintf_t format)
+{
+    char out[BENCH_FMT_SIZE];
+    uint64_t best = UINT64_MAX;
+    uint32_t chars = 0u;
+    volatile int sink = 0;
+
+    for (uint32_t line = 0u; line < BENCH_FMT_LINES; line++)
+    {
+        chars += (uint32_t)bench_fmt_line(format, out, line);
+    }
+
+    for (uint32_t round = 0u; round < BENCH_FMT_ROUNDS; round++)
+    {
+        uint64_t start = bench_clock_now();
+        uint64_t time;
+
+        for (uint32_t pass = 0u; pass < BENCH_FMT_PASSES; pass++)
+        {
+            for (uint32_t line = 0u; line < BENCH_FMT_LINES; line++)
+            {
+                sink += bench_fmt_line(format, out, line);
+            }
+        }
+        time = bench_clock_now() - start;
+        best = (time < best) ? time : best;
+    }
+
+    printf("  %-8s %10.1f %10.2f\n", name,
+           (double)best / (BENCH_FMT_PASSES * BENCH_FMT_LINES),
+           (double)best / (BENCH_FMT_PASSES * chars));
+}
+
+/* [] END OF FILE */
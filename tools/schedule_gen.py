@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+"""Generate the RTC alarm sequences of source/schedule_tables.{c,h}.
+
+Reads SCHEDULE_TABLE from source/schedule_config.h, checks every row against
+the limits of the same file and writes, for each schedule, the alarm times of
+a day in order. The firmware then steps through a table on every alarm
+instead of computing the next time of day.
+
+Usage: schedule_gen.py [source_dir]
+"""
+
+import os
+import re
+import sys
+
+SECONDS_PER_DAY = 86400
+
+ROW_RE = re.compile(r'X\(\s*(\w+)\s*,\s*(\d+)u?\s*,\s*(\d+)u?\s*,\s*(\w+)\s*,\s*(\d+)u?\s*\)')
+LIMIT_RE = re.compile(r'#define\s+(SCHEDULE_\w+)\s+\((\d+)u?\)')
+
+
+def parse(path):
+    with open(path) as f:
+        text = f.read()
+    limits = {m.group(1): int(m.group(2)) for m in LIMIT_RE.finditer(text)}
+    table = text[text.index('#define SCHEDULE_TABLE(X)'):]
+    table = table[:table.index('\n\n')]
+    rows = [(m.group(1), int(m.group(2)), int(m.group(3)), m.group(4), int(m.group(5)))
+            for m in ROW_RE.finditer(table)]
+    return limits, rows
+
+
+def check(limits, row):
+    name, period, offset, mode, awake_us = row
+    res = limits['SCHEDULE_ALARM_RESOLUTION_S']
+    errors = []
+    if period == 0 or SECONDS_PER_DAY % period:
+        errors.append('period does not divide a day')
+    if period % res:
+        errors.append('period is not a multiple of the alarm resolution')
+    if offset >= period or offset % res:
+        errors.append('offset is not an alarm time within the period')
+    if period != 1 and SECONDS_PER_DAY // period > limits['SCHEDULE_MAX_SLOTS']:
+        errors.append('too many alarms per day for a sequence table')
+    if awake_us > period * limits['SCHEDULE_MAX_DUTY_PPM']:
+        errors.append('worst-case awake duty cycle above SCHEDULE_MAX_DUTY_PPM')
+    if mode == 'SCHEDULE_MODE_HIBERNATE' and period < limits['SCHEDULE_MIN_HIBERNATE_PERIOD_S']:
+        errors.append('period too short for Hibernate')
+    return ['%s: %s' % (name, e) for e in errors]
+
+
+HEADER = """/******************************************************************************
+* File Name:   {name}
+*
+* Description: RTC alarm sequences of the wake schedules.
+*
+*              Generated by tools/schedule_gen.py from schedule_config.h.
+*              Do not edit.
+*
+*******************************************************************************/
+"""
+
+
+def write_if_changed(path, text):
+    if os.path.exists(path):
+        with open(path) as f:
+            if f.read() == text:
+                return
+    with open(path, 'w', newline='\n') as f:
+        f.write(text)
+
+
+def generate(src, rows):
+    h = [HEADER.format(name='schedule_tables.h'),
+         '#ifndef SOURCE_SCHEDULE_TABLES_H_',
+         '#define SOURCE_SCHEDULE_TABLES_H_',
+         '',
+         '#include "schedule.h"',
+         '']
+    c = [HEADER.format(name='schedule_tables.c'),
+         '#include "schedule_tables.h"',
+         '']
+    for name, period, offset, _, _ in rows:
+        h.append('#define SCHEDULE_GEN_PERIOD_%s %du' % (name, period))
+        h.append('#define SCHEDULE_GEN_OFFSET_%s %du' % (name, offset))
+        if period == 1:
+            h.append('#define SCHEDULE_GEN_SLOTS_%s NULL' % name)
+            h.append('#define SCHEDULE_GEN_COUNT_%s 0u' % name)
+        else:
+            count = SECONDS_PER_DAY // period
+            array = 'schedule_slots_%s' % name.lower()
+            h.append('#define SCHEDULE_GEN_SLOTS_%s %s' % (name, array))
+            h.append('#define SCHEDULE_GEN_COUNT_%s %du' % (name, count))
+            h.append('extern const stc_schedule_slot_t %s[%d];' % (array, count))
+            c.append('const stc_schedule_slot_t %s[%d] =' % (array, count))
+            c.append('{')
+            for i in range(count):
+                t = offset + i * period
+                c.append('    { %2d, %2d, %2d },' % (t // 3600, (t // 60) % 60, t % 60))
+            c.append('};')
+            c.append('')
+        h.append('')
+    h += ['#endif /* SOURCE_SCHEDULE_TABLES_H_ */', '',
+          '/* [] END OF FILE */', '']
+    c += ['/* [] END OF FILE */', '']
+    write_if_changed(os.path.join(src, 'schedule_tables.h'), '\n'.join(h))
+    write_if_changed(os.path.join(src, 'schedule_tables.c'), '\n'.join(c))
+
+
+def main():
+    src = sys.argv[1] if len(sys.argv) > 1 else os.path.join(
+        os.path.dirname(os.path.abspath(__file__)), '..', 'source')
+    limits, rows = parse(os.path.join(src, 'schedule_config.h'))
+    if not rows:
+        sys.exit('schedule_gen: no SCHEDULE_TABLE rows found')
+    errors = [e for row in rows for e in check(limits, row)]
+    if errors:
+        sys.exit('schedule_gen: ' + '\nschedule_gen: '.join(errors))
+    generate(src, rows)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+"""Synchronize the device time with this host over the debug UART.
+
+Runs the host side of the 'sync' shell command. Each exchange carries four
+time stamps: t1 and t4 are host times at the request and at the reply, t2
+and t3 device times at the receipt and at the reply. As in NTP,
+
+    offset = ((t2 - t1) + (t3 - t4)) / 2    device minus host
+    delay  = (t4 - t1) - (t3 - t2)          round trip on the wire
+
+The exchange with the shortest round trip has the least uncertain offset; it
+is sent back with 'sync adj'. The device steps its RTC calendar for large
+offsets and slews its alarm deadlines for small ones.
+
+The RTC keeps standard time: --std-offset is the offset of the device's
+standard time from UTC, by default that of Central European Time.
+
+Usage: timesync.py [--exchanges N] [--std-offset S] [--baud B] port
+Requires pyserial.
+"""
+
+import argparse
+import re
+import sys
+import time
+
+import serial
+
+REPLY_RE = re.compile(r'sync (\d+\.\d{3}) (\d+)\.(\d{3}) (\d+)\.(\d{3})')
+RESULT_RE = re.compile(r'sync (stepped|slewing|rejected)')
+
+
+def host_ms(std_offset_s):
+    return int(round(time.time() * 1000)) + std_offset_s * 1000
+
+
+def offset_delay(t1, t2, t3, t4):
+    """Offset (device minus host) and round trip of one exchange, in ms."""
+    return ((t2 - t1) + (t3 - t4)) // 2, (t4 - t1) - (t3 - t2)
+
+
+def read_match(port, pattern, timeout_s):
+    deadline = time.monotonic() + timeout_s
+    while time.monotonic() < deadline:
+        line = port.readline().decode('ascii', 'replace')
+        m = pattern.search(line)
+        if m:
+            return m
+    return None
+
+
+def exchange(port, std_offset_s):
+    t1 = host_ms(std_offset_s)
+    request = '%d.%03d' % (t1 // 1000, t1 % 1000)
+    port.write(('sync %s\r' % request).encode('ascii'))
+    m = read_match(port, REPLY_RE, 1.0)
+    t4 = host_ms(std_offset_s)
+    if m is None or m.group(1) != request:
+        return None
+    t2 = int(m.group(2)) * 1000 + int(m.group(3))
+    t3 = int(m.group(4)) * 1000 + int(m.group(5))
+    return offset_delay(t1, t2, t3, t4)
+
+
+def sync_round(port, exchanges, std_offset_s):
+    samples = [s for s in (exchange(port, std_offset_s) for _ in range(exchanges)) if s]
+    if not samples:
+        sys.exit('timesync: no replies from the device')
+    offset, delay = min(samples, key=lambda s: s[1])
+    port.write(('sync adj %d %d\r' % (-offset, max(delay, 0))).encode('ascii'))
+    m = read_match(port, RESULT_RE, 2.0)
+    result = m.group(1) if m else 'no answer'
+    print('timesync: offset %+d ms, round trip %d ms over %d exchanges: %s'
+          % (-offset, delay, len(samples), result))
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Synchronize the device time.')
+    parser.add_argument('port')
+    parser.add_argument('--baud', type=int, default=115200)
+    parser.add_argument('--exchanges', type=int, default=8)
+    parser.add_argument('--std-offset', type=int, default=3600,
+                        help='device standard time minus UTC, in seconds')
+    args = parser.parse_args()
+
+    with serial.Serial(args.port, args.baud, timeout=0.2) as port:
+        # A character wakes the device and powers its UART up; it is lost
+        port.write(b'\r')
+        time.sleep(0.2)
+        port.reset_input_buffer()
+        # A step leaves the sub-second part: measure it again
+        if sync_round(port, args.exchanges, args.std_offset) == 'stepped':
+            time.sleep(1.5)
+            sync_round(port, args.exchanges, args.std_offset)
+
+
+if __name__ == '__main__':
+    main()
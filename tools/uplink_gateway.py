@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+"""Host gateway of the telemetry uplink (source/uplink.c).
+
+Reads the debug UART, picks the COBS frames out of the text between zero
+bytes, checks their CRC16, stores each record once and acknowledges the
+frames received in order with the 'ack' shell command. The device then
+drops the acked data and sends only what is new.
+
+Frame, before COBS: header (type u8, flags u8, seq u16, position u32,
+little-endian), payload, CRC-16/CCITT-FALSE of both (u16).
+
+Records are appended to the output file as JSON lines. Flash log records
+are kept once per log position, trace events once per timestamp, event and
+argument; the keys of the records already in the file are loaded at start.
+
+Usage: uplink_gateway.py [--out FILE] [--poll S] [--baud B] port
+Requires pyserial.
+"""
+
+import argparse
+import json
+import os
+import struct
+import sys
+import time
+
+import serial
+
+HEADER = struct.Struct('<BBHI')
+TYPE_TRACE = 0x10
+FLAG_FIRST = 0x01
+FLAG_LAST = 0x02
+
+# Flash log record payloads (source/flash_log.h)
+LOG_TYPES = {
+    1: ('wake', struct.Struct('<IBBH'), ('rtc_seconds', 'source', 'from_hibernate', None)),
+    2: ('stats', struct.Struct('<IIII'), ('rtc_seconds', 'samples', 'wakes', 'missed_wakes')),
+    3: ('samples', None, None),
+    4: ('features', struct.Struct('<IHhHhhH'),
+        ('rtc_seconds', 'count', 'mean', 'rms', 'min', 'max', 'crossings')),
+}
+TRACE_ENTRY = struct.Struct('<QII')
+TRACE_NAMES = ('boot', 'wakeup', 'deepsleep', 'hibernate', 'gesture', 'command',
+               'alarm set', 'batch', 'overrun')
+
+
+def crc16(data, crc=0xFFFF):
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        i += 1
+        if code == 0 or i + code - 1 > len(data):
+            return None
+        out += data[i:i + code - 1]
+        i += code - 1
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def parse_frame(chunk):
+    """Header fields and payload of a valid frame, or None for text and noise."""
+    body = cobs_decode(chunk)
+    if body is None or len(body) < HEADER.size + 2:
+        return None
+    if crc16(body[:-2]) != struct.unpack_from('<H', body, len(body) - 2)[0]:
+        return None
+    return HEADER.unpack_from(body) + (body[HEADER.size:-2],)
+
+
+def records(ftype, position, payload):
+    """Records of a frame, each with its deduplication key."""
+    if ftype == TYPE_TRACE:
+        for i in range(len(payload) // TRACE_ENTRY.size):
+            ts, arg, event = TRACE_ENTRY.unpack_from(payload, i * TRACE_ENTRY.size)
+            name = TRACE_NAMES[event] if event < len(TRACE_NAMES) else str(event)
+            yield 'trace:%d:%d:%d' % (ts, event, arg), {
+                'type': 'trace', 'timestamp_us': ts, 'event': name, 'arg': arg,
+                'index': position + i}
+    elif ftype in LOG_TYPES:
+        name, layout, fields = LOG_TYPES[ftype]
+        record = {'type': name, 'position': position}
+        if layout is None or len(payload) != layout.size:
+            record['data'] = payload.hex()
+        else:
+            record.update({k: v for k, v in zip(fields, layout.unpack(payload)) if k})
+        yield 'log:%d' % position, record
+
+
+def load_keys(path):
+    keys = set()
+    if os.path.exists(path):
+        with open(path) as f:
+            for line in f:
+                keys.add(json.loads(line)['key'])
+    return keys
+
+
+class Gateway:
+    def __init__(self, port, out):
+        self.port = port
+        self.out = out
+        self.keys = load_keys(out.name)
+        self.expected = None    # Next sequence number of the current burst
+        self.last_good = None   # Last frame of the burst received in order
+
+    def frame(self, chunk):
+        parsed = parse_frame(chunk)
+        if parsed is None:
+            return
+        ftype, flags, seq, position, payload = parsed
+        if flags & FLAG_FIRST:
+            self.expected, self.last_good = seq, None
+        if seq != self.expected:
+            # A frame of the burst was lost: later ones come again after the ack
+            self.expected = None
+            return
+        self.expected = (seq + 1) & 0xFFFF
+        self.last_good = seq
+        new = 0
+        for key, record in records(ftype, position, payload):
+            if key not in self.keys:
+                self.keys.add(key)
+                record['key'] = key
+                self.out.write(json.dumps(record) + '\n')
+                new += 1
+        self.out.flush()
+        print('frame %5d type 0x%02x position %d: %d new' % (seq, ftype, position, new))
+        if flags & FLAG_LAST:
+            self.ack()
+
+    def ack(self):
+        if self.last_good is None:
+            return
+        # A character wakes the device and powers its UART up; it is lost
+        self.port.write(b'\r')
+        time.sleep(0.05)
+        self.port.write(b'ack %d\r' % self.last_good)
+        print('ack %d' % self.last_good)
+        self.expected, self.last_good = None, None
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Receive the telemetry uplink.')
+    parser.add_argument('port')
+    parser.add_argument('--baud', type=int, default=115200)
+    parser.add_argument('--out', default='uplink.jsonl')
+    parser.add_argument('--poll', type=float, default=0,
+                        help='ask for a burst every POLL seconds, 0 to wait for the job')
+    args = parser.parse_args()
+
+    with serial.Serial(args.port, args.baud, timeout=0.2) as port, open(args.out, 'a') as out:
+        gateway = Gateway(port, out)
+        pending = b''
+        next_poll = time.monotonic()
+        while True:
+            if args.poll and time.monotonic() >= next_poll:
+                port.write(b'\r')
+                time.sleep(0.05)
+                port.write(b'uplink\r')
+                next_poll = time.monotonic() + args.poll
+            data = port.read(256)
+            if not data:
+                # Quiet line: ack a burst whose last frame was lost
+                gateway.ack()
+                continue
+            chunks = (pending + data).split(b'\x00')
+            pending = chunks.pop()
+            for chunk in chunks:
+                if chunk:
+                    gateway.frame(chunk)
+
+
+if __name__ == '__main__':
+    try:
+        main()
+    except KeyboardInterrupt:
+        sys.exit(0)